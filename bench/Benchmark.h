@@ -0,0 +1,58 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include "Level/Map.h"
+
+// Helpers shared by the benchmark programs of this directory
+// Each program is built by the Makefile's bench target (best used with release=1) and run from the assets directory, with a scratch
+// directory for the files it writes as its only argument
+
+namespace Benchmark
+{
+    // Run a function once and return its duration in milliseconds
+    template<typename Function>
+    double measureMilliseconds(const Function& function)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    // Return the scratch directory given on the command line, or the working directory if there is none
+    inline std::string getOutputDirectory(int argc, char* argv[])
+    {
+        return argc > 1 ? std::string(argv[1]) + '/' : std::string();
+    }
+
+    // Return the number of cells whose TileType differs between two Maps, or the largest std::size_t if their dimensions differ
+    inline std::size_t countDifferentTiles(const Map& map, const Map& otherMap)
+    {
+        if (map.getIndexDimensions() != otherMap.getIndexDimensions())
+        {
+            return static_cast<std::size_t>(-1);
+        }
+
+        std::size_t differentTileCount = 0;
+        for (unsigned int z = 0; z < map.getLayerCount(); z++)
+        {
+            for (unsigned int y = 0; y < map.getIndexDimensions().y; y++)
+            {
+                for (unsigned int x = 0; x < map.getIndexDimensions().x; x++)
+                {
+                    sf::Vector2u index(x, y);
+                    MapLayer layer = static_cast<MapLayer>(z);
+                    if (map.getTile(index, layer).getTileType() != otherMap.getTile(index, layer).getTileType())
+                    {
+                        differentTileCount++;
+                    }
+                }
+            }
+        }
+        return differentTileCount;
+    }
+} // namespace Benchmark
+
+#endif // BENCHMARK_H
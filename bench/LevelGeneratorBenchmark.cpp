@@ -0,0 +1,90 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "Benchmark.h"
+#include "Core/ResourceManager.h"
+#include "Level/LevelGenerator.h"
+#include "Level/Map.h"
+#include "Misc/Utility.h"
+
+// Measure the generation of 1024x1024 and 4096x4096 Levels saved to Level directories, and check that generation is deterministic:
+// saving a Level twice with the same seed must write identical files, another seed must give another Map, and Map::generate must
+// give the same Tiles as the saved tiles.bin
+
+namespace
+{
+    const std::uint32_t seed = 42;
+    const char* const levelFilenames[] = {"tiles.bin", "background.txt", "entities.txt", "resources.txt"};
+
+    std::string readFile(const std::string& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    bool runBenchmark(const ResourceManager& resourceManager, const std::string& outputDirectory, unsigned int size)
+    {
+        LevelGenerator::Settings settings = LevelGenerator::getDefaultSettings(sf::Vector2u(size, size), seed);
+        std::string levelDirectory = outputDirectory + "generated_level_" + std::to_string(size);
+        std::string repeatedLevelDirectory = levelDirectory + "_repeated";
+        std::string otherSeedLevelDirectory = levelDirectory + "_other_seed";
+
+        bool isSaved = true;
+        double saveTime = Benchmark::measureMilliseconds([&]() { isSaved = LevelGenerator::saveLevel(levelDirectory, settings); });
+        isSaved = LevelGenerator::saveLevel(repeatedLevelDirectory, settings) && isSaved;
+        LevelGenerator::Settings otherSeedSettings = settings;
+        otherSeedSettings.seed++;
+        isSaved = LevelGenerator::saveLevel(otherSeedLevelDirectory, otherSeedSettings) && isSaved;
+        if (isSaved == false)
+        {
+            return false;
+        }
+
+        bool areFilesIdentical = true;
+        for (const char* filename : levelFilenames)
+        {
+            if (readFile(levelDirectory + '/' + filename) != readFile(repeatedLevelDirectory + '/' + filename))
+            {
+                areFilesIdentical = false;
+            }
+        }
+        std::string tilesFilename = levelDirectory + "/tiles.bin";
+        bool doesOtherSeedDiffer = readFile(tilesFilename) != readFile(otherSeedLevelDirectory + "/tiles.bin");
+
+        Map generatedMap(resourceManager);
+        Map loadedMap(resourceManager);
+        double generateTime = Benchmark::measureMilliseconds([&]() { isSaved = generatedMap.generate(settings); });
+        if (isSaved == false || loadedMap.loadBinary(tilesFilename) == false)
+        {
+            return false;
+        }
+
+        std::cout << size << 'x' << size << " Level on " << std::thread::hardware_concurrency() << " threads\n"
+                  << "  saveLevel: " << saveTime << " ms, tiles.bin " << Utility::formatByteCount(readFile(tilesFilename).size()) << '\n'
+                  << "  Map::generate: " << generateTime << " ms\n"
+                  << "  Same seed wrote identical files: " << (areFilesIdentical == true ? "yes" : "no") << '\n'
+                  << "  Another seed wrote another Map: " << (doesOtherSeedDiffer == true ? "yes" : "no") << '\n'
+                  << "  Tiles of Map::generate differing from tiles.bin: " << Benchmark::countDifferentTiles(generatedMap, loadedMap)
+                  << "\n\n";
+        return true;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string outputDirectory = Benchmark::getOutputDirectory(argc, argv);
+    ResourceManager resourceManager;
+    for (unsigned int size : {1024, 4096})
+    {
+        if (runBenchmark(resourceManager, outputDirectory, size) == false)
+        {
+            std::cerr << "LevelGeneratorBenchmark error: Unable to generate the " << size << 'x' << size << " Level.\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
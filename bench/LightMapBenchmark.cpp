@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "Benchmark.h"
+#include "Core/ResourceManager.h"
+#include "Level/LightMap.h"
+#include "Level/Map.h"
+
+// Measure incremental light map updates on a generated 4096x4096 Level: a full pass, adding 500 lamp posts, 500 moving lights each
+// moving one Tile per tick, and single Tile edits. The light map is then checked against a light map recomputed from scratch
+
+namespace
+{
+    const unsigned int mapSize = 4096;
+    const std::uint32_t seed = 7;
+    const unsigned int lightCount = 500;
+    const std::uint8_t movingLightLevel = 12;
+    const unsigned int tickCount = 60;
+    const unsigned int editCount = 200;
+
+    // Return the number of cells whose light level differs from a light map recomputed from scratch with the same lights
+    std::size_t countDifferentLevels(const Map& map, const std::vector<LightMap::PointLight>& movingLights)
+    {
+        const sf::Vector2u& dimensions = map.getIndexDimensions();
+        LightMap lightMap;
+        lightMap.resize(dimensions);
+        for (unsigned int chunkY = 0; chunkY * TileLayer::chunkSize < dimensions.y; chunkY++)
+        {
+            for (unsigned int chunkX = 0; chunkX * TileLayer::chunkSize < dimensions.x; chunkX++)
+            {
+                std::vector<LightMap::PointLight> tileLights;
+                unsigned int chunkRight = std::min(dimensions.x, (chunkX + 1) * TileLayer::chunkSize);
+                unsigned int chunkBottom = std::min(dimensions.y, (chunkY + 1) * TileLayer::chunkSize);
+                for (unsigned int y = chunkY * TileLayer::chunkSize; y < chunkBottom; y++)
+                {
+                    for (unsigned int x = chunkX * TileLayer::chunkSize; x < chunkRight; x++)
+                    {
+                        std::uint8_t level = 0;
+                        for (unsigned int z = 0; z < map.getLayerCount(); z++)
+                        {
+                            level = std::max(level, map.getTile(sf::Vector2u(x, y), static_cast<MapLayer>(z)).getDef().lightLevel);
+                        }
+                        if (level > 0)
+                        {
+                            tileLights.push_back({sf::Vector2u(x, y), level});
+                        }
+                    }
+                }
+                lightMap.setChunkTileLights(chunkX, chunkY, tileLights);
+            }
+        }
+        for (std::size_t i = 0; i < movingLights.size(); i++)
+        {
+            lightMap.setMovingLight(i, movingLights[i]);
+        }
+        lightMap.update(map.getSolidityMask());
+
+        std::size_t differentLevelCount = 0;
+        for (unsigned int y = 0; y < dimensions.y; y++)
+        {
+            for (unsigned int x = 0; x < dimensions.x; x++)
+            {
+                if (lightMap.getLevel(x, y) != map.getLightMap().getLevel(x, y))
+                {
+                    differentLevelCount++;
+                }
+            }
+        }
+        return differentLevelCount;
+    }
+} // namespace
+
+int main()
+{
+    ResourceManager resourceManager;
+    Map map(resourceManager);
+    if (map.generate(LevelGenerator::getDefaultSettings(sf::Vector2u(mapSize, mapSize), seed)) == false)
+    {
+        return 1;
+    }
+
+    double fullPassTime = Benchmark::measureMilliseconds([&]() { map.updateLighting(); });
+    std::cout << mapSize << 'x' << mapSize << " generated Level\n"
+              << "  Full pass: " << fullPassTime << " ms, " << map.getLightMap().getUpdatedCellCount() << " cells\n";
+
+    // Lamp posts in empty cells
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<unsigned int> indexDistribution(0, mapSize - 1);
+    for (unsigned int placedCount = 0; placedCount < lightCount;)
+    {
+        sf::Vector2u tileIndex(indexDistribution(generator), indexDistribution(generator));
+        if (map.getTile(tileIndex, MapLayer::Solid).isNull() == true)
+        {
+            map.addTile(TileType::Post, tileIndex, MapLayer::Solid);
+            placedCount++;
+        }
+    }
+    double postTime = Benchmark::measureMilliseconds([&]() { map.updateLighting(); });
+    std::cout << "  " << lightCount << " lamp posts added: " << postTime << " ms, " << map.getLightMap().getUpdatedCellCount()
+              << " cells\n";
+
+    // Moving lights walking randomly, one Tile per tick each
+    float tileSize = static_cast<float>(map.getTileSize());
+    std::vector<sf::Vector2f> lightPositions(lightCount);
+    for (std::size_t i = 0; i < lightCount; i++)
+    {
+        sf::Vector2u tileIndex(indexDistribution(generator), indexDistribution(generator));
+        lightPositions[i] = sf::Vector2f((tileIndex.x + 0.5f) * tileSize, (tileIndex.y + 0.5f) * tileSize);
+        map.setMovingLight(i, lightPositions[i], movingLightLevel);
+    }
+    map.updateLighting();
+
+    std::uniform_int_distribution<int> directionDistribution(0, 3);
+    float maxPosition = (mapSize - 1) * tileSize;
+    double totalTickTime = 0;
+    double worstTickTime = 0;
+    std::size_t totalTickCellCount = 0;
+    for (unsigned int tick = 0; tick < tickCount; tick++)
+    {
+        for (std::size_t i = 0; i < lightCount; i++)
+        {
+            sf::Vector2f& position = lightPositions[i];
+            int direction = directionDistribution(generator);
+            position.x = std::min(std::max(position.x + (direction == 0 ? -tileSize : direction == 1 ? tileSize : 0), 0.f), maxPosition);
+            position.y = std::min(std::max(position.y + (direction == 2 ? -tileSize : direction == 3 ? tileSize : 0), 0.f), maxPosition);
+            map.setMovingLight(i, position, movingLightLevel);
+        }
+
+        double tickTime = Benchmark::measureMilliseconds([&]() { map.updateLighting(); });
+        totalTickTime += tickTime;
+        worstTickTime = std::max(worstTickTime, tickTime);
+        totalTickCellCount += map.getLightMap().getUpdatedCellCount();
+    }
+    std::cout << "  " << lightCount << " moving lights, 1 Tile per tick each: " << totalTickTime / tickCount << " ms per tick (worst "
+              << worstTickTime << " ms), " << totalTickCellCount / tickCount << " cells\n";
+
+    // Single edits digging or filling a cell, which may block light
+    double totalEditTime = 0;
+    std::size_t totalEditCellCount = 0;
+    for (unsigned int i = 0; i < editCount; i++)
+    {
+        sf::Vector2u tileIndex(indexDistribution(generator), indexDistribution(generator));
+        if (map.isTileSolid(tileIndex) == true)
+        {
+            map.removeTile(tileIndex, MapLayer::Solid);
+        }
+        else
+        {
+            map.addTile(TileType::Wood, tileIndex, MapLayer::Solid);
+        }
+
+        totalEditTime += Benchmark::measureMilliseconds([&]() { map.updateLighting(); });
+        totalEditCellCount += map.getLightMap().getUpdatedCellCount();
+    }
+    std::cout << "  Single Tile edit: " << totalEditTime * 1000 / editCount << " us, " << totalEditCellCount / editCount << " cells\n";
+
+    std::vector<LightMap::PointLight> movingLights(lightCount);
+    for (std::size_t i = 0; i < lightCount; i++)
+    {
+        movingLights[i] = {map.coordsToTileIndex(lightPositions[i]), movingLightLevel};
+    }
+    std::cout << "  Cells differing from a full recompute: " << countDifferentLevels(map, movingLights) << '\n';
+
+    return 0;
+}
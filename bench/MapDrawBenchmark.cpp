@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <SFML/Graphics.hpp>
+#include "Benchmark.h"
+#include "Core/ResourceManager.h"
+#include "Level/Map.h"
+
+// Count the draw calls of a synthetic 512x512 Map (3 layers filled 60/45/10%) for views of growing sizes drawn to a 1920x1080 target,
+// next to the number of visible Tiles (the draw calls of the former per-Tile drawing) and the Tiles drawn and left out as occluded,
+// and measure the CPU time of drawing a frame with cached chunk meshes, after every layer is marked dirty, and after a single Tile edit
+// Large views are drawn from downsampled chunks, as the engine does when zoomed out
+
+namespace
+{
+    const unsigned int mapSize = 512;
+    const std::array<double, 3> layerFillRatios = {0.6, 0.45, 0.1}; // Background, Solid, and Overlay
+    const unsigned int targetWidth = 1920;
+    const unsigned int targetHeight = 1080;
+    const unsigned int frameCount = 20;
+    const unsigned int warmupFrameCount = 100;
+
+    // Count the Tiles of all layers inside a view, as the former per-Tile drawing issued one draw call for each
+    unsigned int countVisibleTiles(const Map& map, const sf::View& view)
+    {
+        float tileSize = static_cast<float>(map.getTileSize());
+        sf::Vector2f viewTopLeft = view.getCenter() - view.getSize() / 2.f;
+        sf::Vector2f viewBottomRight = view.getCenter() + view.getSize() / 2.f;
+        unsigned int left = static_cast<unsigned int>(std::max(0.f, viewTopLeft.x / tileSize));
+        unsigned int top = static_cast<unsigned int>(std::max(0.f, viewTopLeft.y / tileSize));
+        unsigned int right = std::min(mapSize, static_cast<unsigned int>(std::ceil(viewBottomRight.x / tileSize)));
+        unsigned int bottom = std::min(mapSize, static_cast<unsigned int>(std::ceil(viewBottomRight.y / tileSize)));
+
+        unsigned int tileCount = 0;
+        for (unsigned int z = 0; z < map.getLayerCount(); z++)
+        {
+            for (unsigned int y = top; y < bottom; y++)
+            {
+                for (unsigned int x = left; x < right; x++)
+                {
+                    if (map.getTile(sf::Vector2u(x, y), static_cast<MapLayer>(z)).isNull() == false)
+                    {
+                        tileCount++;
+                    }
+                }
+            }
+        }
+        return tileCount;
+    }
+
+    // Mark the meshes of every layer dirty so that the next frame rebuilds all visible ones
+    void setMapDirty(Map& map)
+    {
+        for (unsigned int z = 0; z < map.getLayerCount(); z++)
+        {
+            map.setLayerColor(sf::Color::White, static_cast<MapLayer>(z));
+        }
+    }
+} // namespace
+
+int main()
+{
+    ResourceManager resourceManager;
+    Map map(resourceManager);
+    map.resize(sf::Vector2u(mapSize, mapSize));
+
+    std::mt19937 generator(3);
+    for (unsigned int z = 0; z < map.getLayerCount(); z++)
+    {
+        std::bernoulli_distribution fillDistribution(layerFillRatios[z]);
+        for (unsigned int y = 0; y < mapSize; y++)
+        {
+            for (unsigned int x = 0; x < mapSize; x++)
+            {
+                if (fillDistribution(generator) == true)
+                {
+                    map.addTile(TileType::GrassTopSide, sf::Vector2u(x, y), static_cast<MapLayer>(z));
+                }
+            }
+        }
+    }
+
+    sf::RenderTexture renderTexture;
+    if (renderTexture.create(targetWidth, targetHeight) == false)
+    {
+        std::cerr << "MapDrawBenchmark error: Unable to create the render target.\n";
+        return 1;
+    }
+
+    sf::Vector2f mapCenter(static_cast<float>(map.getBounds().x) / 2, static_cast<float>(map.getBounds().y) / 2);
+    for (unsigned int zoom : {1, 2, 4, 8})
+    {
+        sf::View view(mapCenter, sf::Vector2f(static_cast<float>(targetWidth * zoom), static_cast<float>(targetHeight * zoom)));
+        renderTexture.setView(view);
+        for (unsigned int i = 0; i < warmupFrameCount; i++)
+        {
+            renderTexture.draw(map); // Downsampled chunks are only built a few per frame
+        }
+
+        double cachedTime = Benchmark::measureMilliseconds([&]() {
+            for (unsigned int i = 0; i < frameCount; i++)
+            {
+                renderTexture.draw(map);
+            }
+        });
+
+        double rebuildTime = 0;
+        for (unsigned int i = 0; i < frameCount; i++)
+        {
+            setMapDirty(map);
+            rebuildTime += Benchmark::measureMilliseconds([&]() { renderTexture.draw(map); });
+        }
+
+        std::cout << targetWidth * zoom << 'x' << targetHeight * zoom << " view: " << countVisibleTiles(map, view) << " visible Tiles, "
+                  << map.getDrawCallCount() << " draw calls, " << map.getDrawnTileCount() << " Tiles drawn from meshes, "
+                  << map.getOccludedTileCount() << " occluded Background Tiles left out\n"
+                  << "  Frame " << cachedTime / frameCount << " ms cached, " << rebuildTime / frameCount
+                  << " ms after marking every layer dirty\n";
+    }
+
+    // A single edit only rebuilds the mesh of the chunk it is in
+    renderTexture.setView(sf::View(mapCenter, sf::Vector2f(static_cast<float>(targetWidth), static_cast<float>(targetHeight))));
+    renderTexture.draw(map);
+    double editTime = 0;
+    for (unsigned int i = 0; i < frameCount; i++)
+    {
+        sf::Vector2u tileIndex = map.coordsToTileIndex(mapCenter) + sf::Vector2u(i % 2, 0);
+        map.addTile(i % 4 < 2 ? TileType::Wood : TileType::GrassTopSide, tileIndex, MapLayer::Solid);
+        editTime += Benchmark::measureMilliseconds([&]() { renderTexture.draw(map); });
+    }
+    std::cout << "Frame after a single Tile edit: " << editTime / frameCount << " ms\n";
+
+    return 0;
+}
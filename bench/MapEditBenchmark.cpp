@@ -0,0 +1,81 @@
+#include <iostream>
+#include "Benchmark.h"
+#include "Core/ResourceManager.h"
+#include "Level/Map.h"
+
+// Measure a 64x64 brush fill of the Solid layer with one addTile(..., true) per cell, whose neighbourhood is autotiled immediately,
+// against the same fill inside a beginEdit()/commitEdit() transaction, which autotiles each touched Tile once, and against a single
+// addTileRange(..., true) for reference
+
+namespace
+{
+    const unsigned int mapSize = 256;
+    const unsigned int fillSize = 64;
+    const unsigned int fillOffset = 96;
+    const unsigned int runCount = 20;
+
+    enum class FillMode
+    {
+        Immediate,
+        Transaction,
+        Range
+    };
+
+    // Return the average time of a fill in microseconds
+    double runFill(Map& map, FillMode mode)
+    {
+        double totalTime = 0;
+        for (unsigned int i = 0; i < runCount; i++)
+        {
+            map.clearLayer(MapLayer::Solid);
+            totalTime += Benchmark::measureMilliseconds([&]() {
+                if (mode == FillMode::Range)
+                {
+                    map.addTileRange(TileType::GrassNoSides,
+                                     sf::Vector2u(fillOffset, fillOffset),
+                                     sf::Vector2u(fillSize, fillSize),
+                                     MapLayer::Solid,
+                                     true);
+                    return;
+                }
+
+                if (mode == FillMode::Transaction)
+                {
+                    map.beginEdit();
+                }
+                for (unsigned int y = fillOffset; y < fillOffset + fillSize; y++)
+                {
+                    for (unsigned int x = fillOffset; x < fillOffset + fillSize; x++)
+                    {
+                        map.addTile(TileType::GrassNoSides, sf::Vector2u(x, y), MapLayer::Solid, true);
+                    }
+                }
+                if (mode == FillMode::Transaction)
+                {
+                    map.commitEdit();
+                }
+            });
+        }
+        return totalTime * 1000 / runCount;
+    }
+} // namespace
+
+int main()
+{
+    ResourceManager resourceManager;
+    Map map(resourceManager);
+    map.resize(sf::Vector2u(mapSize, mapSize));
+
+    // The first fill resolves the TileTypes and builds the atlas, which is left out of the measurements
+    runFill(map, FillMode::Range);
+
+    double immediateTime = runFill(map, FillMode::Immediate);
+    double transactionTime = runFill(map, FillMode::Transaction);
+    double rangeTime = runFill(map, FillMode::Range);
+    std::cout << fillSize << 'x' << fillSize << " fill, addTile(..., true) per cell:\n"
+              << "  Immediate:           " << immediateTime << " us\n"
+              << "  Inside an edit:      " << transactionTime << " us (" << immediateTime / transactionTime << "x)\n"
+              << "  addTileRange(..., true) for reference: " << rangeTime << " us\n";
+
+    return 0;
+}
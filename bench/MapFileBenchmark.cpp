@@ -0,0 +1,60 @@
+#include <fstream>
+#include <iostream>
+#include "Benchmark.h"
+#include "Core/ResourceManager.h"
+#include "Level/Map.h"
+#include "Misc/Utility.h"
+
+// Compare saving and loading a generated 4096x4096 Map in the text format and in the binary, chunk-indexed format, and check that
+// both loads give back the same Tiles
+
+namespace
+{
+    const unsigned int mapSize = 4096;
+    const std::uint32_t seed = 7;
+
+    std::size_t getFileSize(const std::string& filename)
+    {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        return file ? static_cast<std::size_t>(file.tellg()) : 0;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string outputDirectory = Benchmark::getOutputDirectory(argc, argv);
+    std::string textFilename = outputDirectory + "map_benchmark.txt";
+    std::string binaryFilename = outputDirectory + "map_benchmark.bin";
+
+    ResourceManager resourceManager;
+    Map map(resourceManager);
+    if (map.generate(LevelGenerator::getDefaultSettings(sf::Vector2u(mapSize, mapSize), seed)) == false)
+    {
+        return 1;
+    }
+
+    bool isSaved = true;
+    double textSaveTime = Benchmark::measureMilliseconds([&]() { isSaved = map.save(textFilename) && isSaved; });
+    double binarySaveTime = Benchmark::measureMilliseconds([&]() { isSaved = map.saveBinary(binaryFilename) && isSaved; });
+
+    Map textMap(resourceManager);
+    Map binaryMap(resourceManager);
+    bool isLoaded = true;
+    double textLoadTime = Benchmark::measureMilliseconds([&]() { isLoaded = textMap.load(textFilename) && isLoaded; });
+    double binaryLoadTime = Benchmark::measureMilliseconds([&]() { isLoaded = binaryMap.loadBinary(binaryFilename) && isLoaded; });
+    if (isSaved == false || isLoaded == false)
+    {
+        std::cerr << "MapFileBenchmark error: Unable to save or load the Map.\n";
+        return 1;
+    }
+
+    std::cout << mapSize << 'x' << mapSize << " generated Map\n"
+              << "  Text:   " << Utility::formatByteCount(getFileSize(textFilename)) << ", save " << textSaveTime << " ms, load "
+              << textLoadTime << " ms\n"
+              << "  Binary: " << Utility::formatByteCount(getFileSize(binaryFilename)) << ", save " << binarySaveTime << " ms, load "
+              << binaryLoadTime << " ms\n"
+              << "  Tiles differing from the generated Map: text " << Benchmark::countDifferentTiles(map, textMap) << ", binary "
+              << Benchmark::countDifferentTiles(map, binaryMap) << '\n';
+
+    return 0;
+}
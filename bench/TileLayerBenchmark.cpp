@@ -0,0 +1,106 @@
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+#include "Benchmark.h"
+#include "Level/TileLayer.h"
+#include "Misc/Utility.h"
+
+// Compare chunked TileLayer storage with the flat array of cells it replaced, on a 4096x4096 layer about 1% filled with strips of
+// Tiles (as floors of a Level) and on a full one: memory, random and sequential cell lookups, and a shrink and grow resize
+
+namespace
+{
+    const unsigned int layerSize = 4096;
+    const std::size_t randomLookupCount = 1 << 22;
+    const TileCell filledCell = {static_cast<std::uint16_t>(TileType::GrassNoSides), 0};
+
+    void runBenchmark(bool isFull)
+    {
+        std::vector<TileCell> flatCells(static_cast<std::size_t>(layerSize) * layerSize);
+        TileLayer layer;
+        layer.resize(sf::Vector2u(layerSize, layerSize));
+
+        // Sparse layers have strips of Tiles in one row of chunks out of 10, each cell of them filled with a 10% probability
+        std::mt19937 generator(1);
+        std::bernoulli_distribution fillDistribution(0.1);
+        for (unsigned int y = 0; y < layerSize; y++)
+        {
+            for (unsigned int x = 0; x < layerSize; x++)
+            {
+                if (isFull == true || ((y / TileLayer::chunkSize) % 10 == 0 && fillDistribution(generator) == true))
+                {
+                    flatCells[y * layerSize + x] = filledCell;
+                    layer.setCell(x, y, filledCell);
+                }
+            }
+        }
+
+        std::size_t chunkedMemoryUsage = layer.getMemoryUsage();
+        std::size_t allocatedChunkCount = layer.getAllocatedChunkCount();
+
+        std::uniform_int_distribution<unsigned int> indexDistribution(0, layerSize - 1);
+        std::vector<std::pair<unsigned int, unsigned int>> lookups(randomLookupCount);
+        for (auto& lookup : lookups)
+        {
+            lookup.first = indexDistribution(generator);
+            lookup.second = indexDistribution(generator);
+        }
+
+        // Sums of the ids read are printed so that the lookups are not optimized away
+        std::uint64_t idSum = 0;
+        double flatRandomTime = Benchmark::measureMilliseconds([&]() {
+            for (const auto& lookup : lookups)
+            {
+                idSum += flatCells[lookup.second * layerSize + lookup.first].id;
+            }
+        });
+        double chunkedRandomTime = Benchmark::measureMilliseconds([&]() {
+            for (const auto& lookup : lookups)
+            {
+                idSum += layer.getCell(lookup.first, lookup.second).id;
+            }
+        });
+        double flatSequentialTime = Benchmark::measureMilliseconds([&]() {
+            for (unsigned int y = 0; y < layerSize; y++)
+            {
+                for (unsigned int x = 0; x < layerSize; x++)
+                {
+                    idSum += flatCells[y * layerSize + x].id;
+                }
+            }
+        });
+        double chunkedSequentialTime = Benchmark::measureMilliseconds([&]() {
+            for (unsigned int y = 0; y < layerSize; y++)
+            {
+                for (unsigned int x = 0; x < layerSize; x++)
+                {
+                    idSum += layer.getCell(x, y).id;
+                }
+            }
+        });
+        double resizeTime = Benchmark::measureMilliseconds([&]() {
+            layer.resize(sf::Vector2u(layerSize / 2, layerSize / 2));
+            layer.resize(sf::Vector2u(layerSize, layerSize));
+        });
+
+        double cellCount = static_cast<double>(layerSize) * layerSize;
+        std::cout << (isFull == true ? "Full layer" : "Sparse layer") << " (" << layerSize << 'x' << layerSize << ")\n"
+                  << "  Memory:             flat " << Utility::formatByteCount(flatCells.size() * sizeof(TileCell)) << ", chunked "
+                  << Utility::formatByteCount(chunkedMemoryUsage) << " (" << allocatedChunkCount << " chunks)\n"
+                  << "  Random lookup:      flat " << flatRandomTime * 1e6 / randomLookupCount << " ns, chunked "
+                  << chunkedRandomTime * 1e6 / randomLookupCount << " ns\n"
+                  << "  Sequential lookup:  flat " << flatSequentialTime * 1e6 / cellCount << " ns, chunked "
+                  << chunkedSequentialTime * 1e6 / cellCount << " ns\n"
+                  << "  Shrink+grow resize: " << resizeTime << " ms\n"
+                  << "  (id sum " << idSum << ")\n";
+    }
+} // namespace
+
+int main()
+{
+    runBenchmark(false);
+    runBenchmark(true);
+    return 0;
+}
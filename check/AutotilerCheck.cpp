@@ -0,0 +1,313 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "Level/Autotiler.h"
+#include "Level/Map.h"
+#include "Level/Tile.h"
+
+// Check that the Autotiler's grass rules choose the same variants as the if/else chain they replaced in Map::updateTileTexture
+// Every grass TileType is compared for all 256 masks of empty neighbours, then for every cell of random grids (which also covers
+// neighbours outside of the grid). Run from the assets directory: the exit status is a failure if any variant differs
+
+namespace
+{
+    const std::uint16_t firstGrassId = static_cast<std::uint16_t>(TileType::GrassTopLeftSides);
+    const std::uint16_t lastGrassId = static_cast<std::uint16_t>(TileType::GrassNoSidesCorners23);
+    const unsigned int randomGridCount = 2000;
+    const unsigned int maxRandomGridSize = 8;
+
+    // Variant chosen by the former grass if/else chain of Map::updateTileTexture, kept verbatim as the reference
+    TileType getReferenceGrassVariant(bool isTopLeftEmpty, bool isTopEmpty, bool isTopRightEmpty, bool isLeftEmpty, bool isRightEmpty,
+                                      bool isBottomLeftEmpty, bool isBottomEmpty, bool isBottomRightEmpty)
+    {
+        if (isTopEmpty == true && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == false && isBottomRightEmpty == false)
+        {
+            return TileType::GrassTopLeftSides;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == false && isBottomEmpty == false &&
+                 ((isBottomRightEmpty == false && isBottomLeftEmpty == false) || (isBottomLeftEmpty == true && isBottomRightEmpty == true)))
+        {
+            return TileType::GrassTopSide;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == true && isBottomLeftEmpty == false && isBottomEmpty == false)
+        {
+            return TileType::GrassTopRightSides;
+        }
+        else if (isTopEmpty == false &&
+                 ((isTopRightEmpty == false && isBottomRightEmpty == false) || (isTopRightEmpty == true && isBottomRightEmpty == true)) &&
+                 isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == false)
+        {
+            return TileType::GrassLeftSide;
+        }
+        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == true &&
+                 isRightEmpty == false && isBottomLeftEmpty == false && isBottomEmpty == false && isBottomRightEmpty == false)
+        {
+            return TileType::GrassNoSides;
+        }
+        else if (((isTopLeftEmpty == false && isBottomLeftEmpty == false) || (isTopLeftEmpty == true && isBottomLeftEmpty == true)) &&
+                 isTopEmpty == false && isLeftEmpty == false && isRightEmpty == true && isBottomEmpty == false)
+        {
+            return TileType::GrassRightSide;
+        }
+        else if (isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == true)
+        {
+            return TileType::GrassBotLeftSide;
+        }
+        else if (isTopEmpty == false &&
+                 ((isTopRightEmpty == false && isTopLeftEmpty == false) || (isTopRightEmpty == true && isTopLeftEmpty == true)) &&
+                 isLeftEmpty == false && isRightEmpty == false && isBottomEmpty == true)
+        {
+            return TileType::GrassBotSide;
+        }
+        else if (isTopLeftEmpty == false && isTopEmpty == false && isLeftEmpty == false && isRightEmpty == true && isBottomEmpty == true)
+        {
+            return TileType::GrassBotRightSides;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == true && isRightEmpty == true && isBottomEmpty == false)
+        {
+            return TileType::GrassTopLeftRightSides;
+        }
+        else if (isTopEmpty == false && isLeftEmpty == true && isRightEmpty == true && isBottomEmpty == false)
+        {
+            return TileType::GrassLeftRightSides;
+        }
+        else if (isTopEmpty == false && isLeftEmpty == true && isRightEmpty == true && isBottomEmpty == true)
+        {
+            return TileType::GrassBotLeftRightSides;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == true)
+        {
+            return TileType::GrassTopBotLeftSides;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == false && isBottomEmpty == true)
+        {
+            return TileType::GrassTopBotSides;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == true && isBottomEmpty == true)
+        {
+            return TileType::GrassTopBotRightSides;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == true && isRightEmpty == true && isBottomEmpty == true)
+        {
+            return TileType::Grass4Sides;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == false && isBottomRightEmpty == true)
+        {
+            return TileType::GrassTopLeftSidesCorner3;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == false && isBottomLeftEmpty == false &&
+                 isBottomEmpty == false && isBottomRightEmpty == true)
+        {
+            return TileType::GrassTopSideCorner3;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == false && isBottomLeftEmpty == true &&
+                 isBottomEmpty == false && isBottomRightEmpty == false)
+        {
+            return TileType::GrassTopSideCorner4;
+        }
+        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == true && isBottomLeftEmpty == true && isBottomEmpty == false)
+        {
+            return TileType::GrassTopRightSidesCorner4;
+        }
+        else if (isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == true && isRightEmpty == false &&
+                 isBottomEmpty == false && isBottomRightEmpty == true)
+        {
+            return TileType::GrassLeftSideCorner3;
+        }
+        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomLeftEmpty == false && isBottomEmpty == false && isBottomRightEmpty == true)
+        {
+            return TileType::GrassNoSidesCorner3;
+        }
+        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomLeftEmpty == true && isBottomEmpty == false && isBottomRightEmpty == false)
+        {
+            return TileType::GrassNoSidesCorner4;
+        }
+        else if (isTopLeftEmpty == false && isTopEmpty == false && isLeftEmpty == false && isRightEmpty == true &&
+                 isBottomLeftEmpty == true && isBottomEmpty == false)
+        {
+            return TileType::GrassRightSideCorner4;
+        }
+        else if (isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == false &&
+                 isBottomRightEmpty == false)
+        {
+            return TileType::GrassLeftSideCorner2;
+        }
+        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomRightEmpty == false && isBottomEmpty == false && isBottomRightEmpty == false)
+        {
+            return TileType::GrassNoSidesCorner2;
+        }
+        else if (isTopLeftEmpty == true && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomLeftEmpty == false && isBottomEmpty == false && isBottomRightEmpty == false)
+        {
+            return TileType::GrassNoSidesCorner1;
+        }
+        else if (isTopLeftEmpty == true && isTopEmpty == false && isLeftEmpty == false && isRightEmpty == true &&
+                 isBottomLeftEmpty == false && isBottomEmpty == false)
+        {
+            return TileType::GrassRightSideCorner1;
+        }
+        else if (isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == true)
+        {
+            return TileType::GrassBotLeftSidesCorner2;
+        }
+        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomEmpty == true)
+        {
+            return TileType::GrassBotSideCorner2;
+        }
+        else if (isTopLeftEmpty == true && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomEmpty == true)
+        {
+            return TileType::GrassBotSideCorner1;
+        }
+        else if (isTopLeftEmpty == true && isTopEmpty == false && isLeftEmpty == false && isRightEmpty == true && isBottomEmpty == true)
+        {
+            return TileType::GrassBotRightSidesCorner1;
+        }
+        else if (isTopLeftEmpty == true && isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomLeftEmpty == true && isBottomEmpty == false && isBottomRightEmpty == true)
+        {
+            return TileType::GrassNoSides4Corners;
+        }
+        else if (isTopLeftEmpty == true && isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomLeftEmpty == false && isBottomEmpty == false && isBottomRightEmpty == false)
+        {
+            return TileType::GrassNoSidesCorners12;
+        }
+        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomLeftEmpty == true && isBottomEmpty == false && isBottomRightEmpty == true)
+        {
+            return TileType::GrassNoSidesCorners34;
+        }
+        else if (isTopLeftEmpty == true && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomLeftEmpty == true && isBottomEmpty == false && isBottomRightEmpty == false)
+        {
+            return TileType::GrassNoSidesCorners14;
+        }
+        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == false &&
+                 isRightEmpty == false && isBottomLeftEmpty == false && isBottomEmpty == false && isBottomRightEmpty == true)
+        {
+            return TileType::GrassNoSidesCorners23;
+        }
+        else
+        {
+            return TileType::GrassNoSides;
+        }
+    }
+
+    // Return the reference variant of a grid cell, computing its neighbours the way Map::updateTileTexture did
+    TileType getReferenceGrassVariant(const std::vector<bool>& solidCells, const sf::Vector2u& dimensions, unsigned int x, unsigned int y)
+    {
+        auto isEmpty = [&](unsigned int cellX, unsigned int cellY) { return solidCells[cellY * dimensions.x + cellX] == false; };
+
+        // Neighbours outside of the grid count as solid
+        bool hasLeft = x > 0;
+        bool hasRight = x < dimensions.x - 1;
+        bool hasTop = y > 0;
+        bool hasBottom = y < dimensions.y - 1;
+        return getReferenceGrassVariant(hasLeft == true && hasTop == true && isEmpty(x - 1, y - 1) == true,
+                                        hasTop == true && isEmpty(x, y - 1) == true,
+                                        hasRight == true && hasTop == true && isEmpty(x + 1, y - 1) == true,
+                                        hasLeft == true && isEmpty(x - 1, y) == true,
+                                        hasRight == true && isEmpty(x + 1, y) == true,
+                                        hasLeft == true && hasBottom == true && isEmpty(x - 1, y + 1) == true,
+                                        hasBottom == true && isEmpty(x, y + 1) == true,
+                                        hasRight == true && hasBottom == true && isEmpty(x + 1, y + 1) == true);
+    }
+
+    // Compare the Autotiler's table with the reference chain for every mask of empty neighbours of each grass TileType
+    unsigned int checkMasks(const Autotiler& autotiler)
+    {
+        unsigned int mismatchCount = 0;
+        for (std::uint16_t id = firstGrassId; id <= lastGrassId; id++)
+        {
+            for (unsigned int mask = 0; mask < 256; mask++)
+            {
+                TileType expected = getReferenceGrassVariant((mask & Autotiler::TopLeft) != 0,
+                                                             (mask & Autotiler::Top) != 0,
+                                                             (mask & Autotiler::TopRight) != 0,
+                                                             (mask & Autotiler::Left) != 0,
+                                                             (mask & Autotiler::Right) != 0,
+                                                             (mask & Autotiler::BottomLeft) != 0,
+                                                             (mask & Autotiler::Bottom) != 0,
+                                                             (mask & Autotiler::BottomRight) != 0);
+                std::uint16_t variant = autotiler.getVariant(id, static_cast<std::uint8_t>(mask));
+                if (variant != static_cast<std::uint16_t>(expected))
+                {
+                    if (mismatchCount < 10)
+                    {
+                        std::cerr << "Mismatch for TileType " << id << ", mask " << mask << ": expected " << static_cast<int>(expected)
+                                  << ", got " << variant << '\n';
+                    }
+                    mismatchCount++;
+                }
+            }
+        }
+        return mismatchCount;
+    }
+
+    // Compare Autotiler::getAutotiledId with the reference chain for every cell of random grids, including their edges
+    unsigned int checkRandomGrids(const Autotiler& autotiler)
+    {
+        std::mt19937 generator(1);
+        std::uniform_int_distribution<unsigned int> sizeDistribution(1, maxRandomGridSize);
+        std::uniform_int_distribution<std::uint16_t> idDistribution(firstGrassId, lastGrassId);
+        std::bernoulli_distribution solidDistribution(0.6);
+
+        unsigned int mismatchCount = 0;
+        for (unsigned int i = 0; i < randomGridCount; i++)
+        {
+            sf::Vector2u dimensions(sizeDistribution(generator), sizeDistribution(generator));
+            std::vector<bool> solidCells(dimensions.x * dimensions.y);
+            for (std::size_t j = 0; j < solidCells.size(); j++)
+            {
+                solidCells[j] = solidDistribution(generator);
+            }
+            auto isSolid = [&](unsigned int x, unsigned int y) { return solidCells[y * dimensions.x + x]; };
+
+            for (unsigned int y = 0; y < dimensions.y; y++)
+            {
+                for (unsigned int x = 0; x < dimensions.x; x++)
+                {
+                    std::uint16_t id = idDistribution(generator);
+                    std::uint16_t variant = autotiler.getAutotiledId(id, x, y, dimensions, isSolid);
+                    if (variant != static_cast<std::uint16_t>(getReferenceGrassVariant(solidCells, dimensions, x, y)))
+                    {
+                        mismatchCount++;
+                    }
+                }
+            }
+        }
+        return mismatchCount;
+    }
+} // namespace
+
+int main()
+{
+    Autotiler autotiler(Map::maxTileTypeId + 1);
+    if (autotiler.load("data/levels/autotile_rules.txt") == false)
+    {
+        return EXIT_FAILURE;
+    }
+
+    for (std::uint16_t id = firstGrassId; id <= lastGrassId; id++)
+    {
+        if (autotiler.isAutotiled(id) == false)
+        {
+            std::cerr << "TileType " << id << " is not autotiled\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    unsigned int maskMismatchCount = checkMasks(autotiler);
+    unsigned int gridMismatchCount = checkRandomGrids(autotiler);
+    std::cout << "Autotiler check: " << maskMismatchCount << " mask mismatches (" << (lastGrassId - firstGrassId + 1) * 256
+              << " compared), " << gridMismatchCount << " grid cell mismatches\n";
+
+    return (maskMismatchCount == 0 && gridMismatchCount == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,57 @@
+#ifndef AUDIOMANAGER_H
+#define AUDIOMANAGER_H
+
+#include <iostream>
+#include <vector>
+#include <SFML/Audio.hpp>
+
+enum class SoundPriority
+{
+    Low,
+    Normal,
+    High
+};
+
+// Pool of a fixed number of sf::Sound voices shared by all fire-and-forget sounds, bounding the number of OpenAL sources in use
+// When every voice is busy, the oldest voice with the lowest priority not above that of the new sound is stolen
+
+class AudioManager final
+{
+private:
+    struct Voice
+    {
+        sf::Sound sound;
+        SoundPriority priority;
+        unsigned int playOrder;
+    };
+
+    std::vector<Voice> m_voices;
+
+    // Voice usage statistics
+    unsigned int m_playCount;
+    unsigned int m_stolenCount;
+    unsigned int m_droppedCount;
+    std::size_t m_peakActiveVoiceCount;
+
+    // Functions
+    Voice* findVoice(SoundPriority priority);
+
+public:
+    // Constructor
+    explicit AudioManager(std::size_t voiceCount = 32);
+
+    // Functions
+    bool play(const sf::SoundBuffer& soundBuffer, float volume = 100, float pitch = 1, SoundPriority priority = SoundPriority::Normal);
+    void stopAll();
+    void printStats(std::ostream& os = std::cout) const;
+
+    // Getters
+    std::size_t getVoiceCount() const { return m_voices.size(); }
+    std::size_t getActiveVoiceCount() const;
+    std::size_t getPeakActiveVoiceCount() const { return m_peakActiveVoiceCount; }
+    unsigned int getPlayCount() const { return m_playCount; }
+    unsigned int getStolenCount() const { return m_stolenCount; }
+    unsigned int getDroppedCount() const { return m_droppedCount; }
+};
+
+#endif // AUDIOMANAGER_H
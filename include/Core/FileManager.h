@@ -1,6 +1,7 @@
 #ifndef FILEMANAGER_H
 #define FILEMANAGER_H
 
+#include <functional>
 #include <string>
 #include <vector>
 #include <SFML/Config.hpp>
@@ -16,8 +17,13 @@ namespace FileManager
     }
 #endif
 
+    bool fileExists(const std::string& filename);
     int getFileCount(const std::string& directory);
     std::vector<std::string> getFilenamesInDirectory(const std::string& directory);
+    bool createDirectory(const std::string& directory);
+    bool removeDirectory(const std::string& directory);
+    bool replaceFile(const std::string& source, const std::string& destination);
+    bool copyFile(const std::string& source, const std::string& destination, const std::function<void(float)>& onProgress);
 
 #if defined(SFML_SYSTEM_ANDROID)
     std::string readTxtFromAssets(const std::string& filename);
@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <vector>
 #include <SFML/Graphics.hpp>
+#include "Core/AudioManager.h"
 #include "Core/Input/InputManager.h"
 #include "Core/LoopDebugOverlay.h"
 #include "Core/ResourceManager.h"
@@ -14,6 +15,7 @@ class GameEngine final
 {
 public:
     ResourceManager resourceManager; // Placed here for constructor initializer list order
+    AudioManager audioManager;
 
 private:
     // Window
@@ -81,6 +83,7 @@ public:
 
     // Loop debug overlay functions
     void toggleDebugOverlay() { m_loopDebugOverlay.toggleVisible(); }
+    void recordMapDraw(unsigned int drawnTileCount, unsigned int occludedTileCount);
 
     // Quit game
     void quit();
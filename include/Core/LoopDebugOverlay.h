@@ -4,8 +4,11 @@
 #include <SFML/Graphics.hpp>
 
 // Class used for displaying debug information relating to the game loop (UPS, FPS, UPS strain, and FPS strain)
+// the estimated memory used by loaded resources, audio voice usage, and the Map Tiles drawn and left out as occluded
 
+class AudioManager;
 class GameEngine;
+class ResourceManager;
 
 class LoopDebugOverlay final : public sf::Drawable
 {
@@ -14,6 +17,12 @@ private:
     sf::Text m_fpsText;
     sf::Text m_updateStrainText;
     sf::Text m_drawStrainText;
+    sf::Text m_resourceMemoryText;
+    sf::Text m_audioVoicesText;
+    sf::Text m_mapTilesText;
+
+    const ResourceManager& m_resourceManager;
+    const AudioManager& m_audioManager;
 
     sf::Clock m_upsClock;
     sf::Clock m_fpsClock;
@@ -26,6 +35,11 @@ private:
     unsigned int m_updateCounter;
     unsigned int m_drawCounter;
 
+    // Tile counts of the last Map drawn, reset after each sampling to tell when no Map is drawn
+    unsigned int m_mapDrawnTileCount;
+    unsigned int m_mapOccludedTileCount;
+    bool m_isMapRecorded;
+
     bool m_isVisible;
 
     // Functions
@@ -33,11 +47,12 @@ private:
 
 public:
     // Constructor
-    explicit LoopDebugOverlay(const sf::Font& font);
+    LoopDebugOverlay(const sf::Font& font, const ResourceManager& resourceManager, const AudioManager& audioManager);
 
     // Functions
     void recordUpdate(sf::Time lastUpdateTime);
     void recordDraw(sf::Time lastDrawTime);
+    void recordMapDraw(unsigned int drawnTileCount, unsigned int occludedTileCount);
     void onWindowResize();
 
     // Setters
@@ -0,0 +1,45 @@
+#ifndef MEMORYMAPPEDFILE_H
+#define MEMORYMAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <SFML/Config.hpp>
+
+#if defined(SFML_SYSTEM_ANDROID)
+struct AAsset;
+#endif
+
+// Read-only view of a whole file mapped into memory, so that binary files can be read in place without copies
+// On Android, files are read from the assets through the asset manager instead
+
+class MemoryMappedFile final
+{
+private:
+    const char* m_data;
+    std::size_t m_size;
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#elif defined(SFML_SYSTEM_ANDROID)
+    AAsset* m_asset;
+#endif
+
+public:
+    // Constructor and destructor
+    MemoryMappedFile();
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    ~MemoryMappedFile();
+
+    // Functions
+    bool open(const std::string& filename);
+    void close();
+
+    // Getters
+    bool isOpen() const { return m_data != nullptr; }
+    const char* getData() const { return m_data; }
+    std::size_t getSize() const { return m_size; }
+};
+
+#endif // MEMORYMAPPEDFILE_H
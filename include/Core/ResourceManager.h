@@ -1,10 +1,27 @@
 #ifndef RESOURCEMANAGER_H
 #define RESOURCEMANAGER_H
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
+#include "Core/ResourceManifest.h"
+
+struct ResourceMemoryRecord
+{
+    std::string name;
+    ResourceType type;
+    std::size_t bytes;
+};
 
 class ResourceManager final
 {
@@ -14,8 +31,48 @@ private:
     std::unordered_map<std::string, sf::SoundBuffer> m_soundBuffers;
     std::unordered_map<std::string, sf::Shader> m_shaders;
 
+    ResourceManifest m_manifest;
+
+    // Estimated memory used by each loaded resource, indexed by ResourceType, and running totals per type
+    // Resources may be loaded on a loading thread while the totals are read every frame, so the totals are atomic and the
+    // per-resource sizes are guarded by a mutex
+    std::array<std::unordered_map<std::string, std::size_t>, 4> m_resourceBytes;
+    std::array<std::atomic<std::size_t>, 4> m_memoryUsage;
+    mutable std::mutex m_memoryUsageMutex;
+    std::size_t m_textureSizeWarningThreshold;
+
+    // Glyphs known to be rasterized in each font's page textures, and the number of glyphs rasterized outside of prewarming
+    mutable std::unordered_map<const sf::Font*, std::unordered_set<std::uint64_t>> m_cachedGlyphs;
+    mutable std::size_t m_glyphCacheMissCount;
+
+    // Resources decoded ahead of time by the prefetch thread, held until loaded
+    struct PrefetchedResource
+    {
+        sf::Image image;
+        std::vector<sf::Int16> samples;
+        unsigned int channelCount;
+        unsigned int sampleRate;
+        std::string source;
+        std::size_t bytes;
+    };
+    std::unordered_map<std::string, PrefetchedResource> m_prefetchedResources;
+    std::size_t m_prefetchedBytes;
+    std::vector<std::string> m_prefetchSkippedNames; // Skipped to respect the memory budget, reported by updatePrefetching()
+    mutable std::mutex m_prefetchMutex;
+    std::thread m_prefetchThread;
+    std::atomic<bool> m_isPrefetchCancelled;
+    std::atomic<bool> m_isPrefetchThrottled;
+    std::atomic<bool> m_isPrefetchComplete; // Set by the prefetch thread, and cleared once reported by updatePrefetching()
+    std::size_t m_memoryBudget;
+
     // Functions
     bool loadInitialResources();
+    bool loadFontPrewarmList(const std::string& filename);
+    void recordMemoryUsage(ResourceType type, const std::string& name, std::size_t bytes);
+    void eraseMemoryUsage(ResourceType type, const std::string& name);
+    void recordTextureMemoryUsage(const std::string& name, const sf::Texture& texture);
+    void prefetchWorker(std::vector<std::pair<std::string, ResourceManifestEntry>> entries, std::size_t budget);
+    bool loadPrefetchedResource(const std::string& name, const ResourceManifestEntry& entry);
 
 public:
     // Constructor and destructor
@@ -24,6 +81,29 @@ public:
 
     // Functions
 
+    // Manifest functions
+    bool loadManifest(const std::string& filename, std::vector<std::string>* names = nullptr);
+    bool loadResource(const std::string& name);
+    const ResourceManifest& getManifest() const { return m_manifest; }
+
+    // Memory accounting functions
+    std::size_t getMemoryUsage(ResourceType type) const { return m_memoryUsage[static_cast<std::size_t>(type)]; }
+    std::size_t getRamUsage() const;
+    std::size_t getVramUsage() const { return getMemoryUsage(ResourceType::Texture); }
+    std::vector<ResourceMemoryRecord> getLargestResources(std::size_t count) const;
+    void printMemoryReport(std::ostream& os = std::cout, std::size_t count = 10) const;
+    void setTextureSizeWarningThreshold(std::size_t bytes) { m_textureSizeWarningThreshold = bytes; }
+    void setMemoryBudget(std::size_t bytes) { m_memoryBudget = bytes; }
+    std::size_t getMemoryBudget() const { return m_memoryBudget; }
+
+    // Prefetch functions
+    void prefetchResources(const std::vector<std::string>& names);
+    void finishPrefetching();
+    void stopPrefetching();
+    void updatePrefetching();
+    void releasePrefetchedResources();
+    std::size_t getPrefetchedBytes() const;
+
     // Texture functions
     const sf::Texture& loadTexture(const std::string& name, const std::string& filename, const sf::IntRect& textureRect = {});
     void unloadTexture(const std::string& name);
@@ -35,6 +115,10 @@ public:
     const sf::Font& loadFont(const std::string& name, const std::string& filename);
     void unloadFont(const std::string& name);
     const sf::Font& getFont(const std::string& name) const;
+    void prewarmFont(const std::string& name, const sf::String& characters, const std::vector<unsigned int>& characterSizes,
+                     float outlineThickness = 0);
+    std::size_t checkGlyphCache(const sf::Text& text) const;
+    std::size_t getGlyphCacheMissCount() const { return m_glyphCacheMissCount; }
 
     // SoundBuffer functions
     const sf::SoundBuffer& loadSoundBuffer(const std::string& name, const std::string& filename);
@@ -0,0 +1,47 @@
+#ifndef RESOURCEMANIFEST_H
+#define RESOURCEMANIFEST_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+enum class ResourceType
+{
+    Texture,
+    Font,
+    SoundBuffer,
+    Shader
+};
+
+struct ResourceManifestEntry
+{
+    ResourceType type;
+    std::string filename;
+    sf::IntRect textureRect;
+    sf::Shader::Type shaderType;
+    bool isRepeated;
+    bool isSmooth;
+};
+
+// Table of resource declarations (name -> file, sub-rect, and flags) parsed from manifest files, used to load resources by name
+
+class ResourceManifest final
+{
+private:
+    std::unordered_map<std::string, ResourceManifestEntry> m_entries;
+
+    // Functions
+    bool parseDeclaration(const std::string& line, const std::string& name, ResourceManifestEntry& entry) const;
+
+public:
+    // Functions
+    bool load(const std::string& filename, std::vector<std::string>* names = nullptr);
+    void clear() { m_entries.clear(); }
+
+    // Getters
+    const ResourceManifestEntry* getEntry(const std::string& name) const;
+    std::size_t getEntryCount() const { return m_entries.size(); }
+};
+
+#endif // RESOURCEMANIFEST_H
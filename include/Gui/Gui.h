@@ -4,6 +4,7 @@
 #include <string>
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
+#include "Core/AudioManager.h"
 
 // DEPRECATED
 
@@ -118,22 +119,25 @@ public:
     // Getters
     const sf::Vector2f& getDimensions() const { return m_dimensions; }
     std::string getText() const { return m_text.getString(); }
+    const sf::Text& getTextDrawable() const { return m_text; }
 };
 
 // GuiRectSoundButton
 class GuiRectSoundButton : public GuiRectButton
 {
 private:
-    sf::Sound m_sound;
+    AudioManager& m_audioManager;
+    const sf::SoundBuffer& m_soundBuffer;
+    float m_volume;
 
 public:
     // Constructor
-    GuiRectSoundButton(const sf::Font& font, const sf::SoundBuffer& soundBuffer, const sf::Vector2f& position,
+    GuiRectSoundButton(AudioManager& audioManager, const sf::Font& font, const sf::SoundBuffer& soundBuffer, const sf::Vector2f& position,
                        const sf::Vector2f& dimensions, float borderThickness, int textPadding, const std::string& text, GuiStyle style);
 
     // Setters
     void setState(GuiState state) override;
-    void setVolume(float volume) { m_sound.setVolume(volume); }
+    void setVolume(float volume) { m_volume = volume; }
 };
 
 // GuiSpriteButton
@@ -286,6 +290,9 @@ public:
     void setText(const std::string& text);
     void setTextPadding(float textPadding) { m_textPadding = textPadding; }
     void setTextColor(sf::Color color) { m_textColor = color; }
+
+    // Getters
+    const sf::Text& getTextDrawable() const { return m_text; }
 };
 
 // ProgressBar
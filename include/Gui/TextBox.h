@@ -120,6 +120,8 @@ public:
     const sf::Vector2f& getDimensions() const { return m_box.getSize(); }
     bool hasFocus() const { return m_hasFocus; }
     sf::String getText() const { return m_text; }
+    const sf::Text& getDisplayTextDrawable() const { return m_displayText; }
+    const sf::Text& getPlaceholderTextDrawable() const { return m_backgroundText; }
 };
 
 #endif // TEXTBOX_H
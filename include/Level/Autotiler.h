@@ -0,0 +1,99 @@
+#ifndef AUTOTILER_H
+#define AUTOTILER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+// Table-driven choice of Tile variants from the solidity of their 8 neighbours, for one or more terrain sets
+// Each terrain set's rules are folded at load time into a 256-entry table indexed by the neighbour bitmask
+
+class Autotiler final
+{
+public:
+    enum Neighbour : std::uint8_t
+    {
+        TopLeft = 1 << 0,
+        Top = 1 << 1,
+        TopRight = 1 << 2,
+        Left = 1 << 3,
+        Right = 1 << 4,
+        BottomLeft = 1 << 5,
+        Bottom = 1 << 6,
+        BottomRight = 1 << 7
+    };
+
+private:
+    struct TerrainSet
+    {
+        std::string name;
+        std::array<std::uint16_t, 256> variants; // TileType id for each mask of empty neighbours
+    };
+
+    struct Rule
+    {
+        std::uint16_t id;
+        std::uint8_t emptyMask; // Neighbours which must be empty
+        std::uint8_t careMask; // Neighbours whose state matters
+    };
+
+    std::vector<TerrainSet> m_terrainSets;
+    std::vector<std::int16_t> m_terrainSetIndices; // Terrain set of each TileType id, -1 if the TileType is not autotiled
+
+    // Functions
+    bool parseRule(const std::string& line, Rule& rule) const;
+    bool addTerrainSet(const std::string& name, std::uint16_t firstId, std::uint16_t lastId, std::uint16_t defaultId,
+                       const std::vector<Rule>& rules);
+
+public:
+    // Constructor
+    explicit Autotiler(std::size_t idCount);
+
+    // Functions
+    bool load(const std::string& filename);
+
+    // Getters
+    bool isAutotiled(std::uint16_t id) const { return id < m_terrainSetIndices.size() && m_terrainSetIndices[id] >= 0; }
+    std::uint16_t getVariant(std::uint16_t id, std::uint8_t emptyNeighbours) const
+    {
+        return m_terrainSets[m_terrainSetIndices[id]].variants[emptyNeighbours];
+    }
+
+    // Return the variant of a cell's TileType matching the solidity of its neighbours, or its own id if it is not autotiled
+    // isSolid(x, y) tells whether a cell of the grid is solid, and neighbours outside of the grid count as solid
+    template<typename IsSolid>
+    std::uint16_t getAutotiledId(std::uint16_t id, unsigned int x, unsigned int y, const sf::Vector2u& dimensions,
+                                 const IsSolid& isSolid) const
+    {
+        if (isAutotiled(id) == false)
+        {
+            return id;
+        }
+
+        std::uint8_t emptyNeighbours = 0;
+        bool hasLeft = x > 0;
+        bool hasRight = x < dimensions.x - 1;
+        bool hasTop = y > 0;
+        bool hasBottom = y < dimensions.y - 1;
+        if (hasTop == true)
+        {
+            emptyNeighbours |= (hasLeft == true && isSolid(x - 1, y - 1) == false) ? TopLeft : 0;
+            emptyNeighbours |= (isSolid(x, y - 1) == false) ? Top : 0;
+            emptyNeighbours |= (hasRight == true && isSolid(x + 1, y - 1) == false) ? TopRight : 0;
+        }
+        emptyNeighbours |= (hasLeft == true && isSolid(x - 1, y) == false) ? Left : 0;
+        emptyNeighbours |= (hasRight == true && isSolid(x + 1, y) == false) ? Right : 0;
+        if (hasBottom == true)
+        {
+            emptyNeighbours |= (hasLeft == true && isSolid(x - 1, y + 1) == false) ? BottomLeft : 0;
+            emptyNeighbours |= (isSolid(x, y + 1) == false) ? Bottom : 0;
+            emptyNeighbours |= (hasRight == true && isSolid(x + 1, y + 1) == false) ? BottomRight : 0;
+        }
+
+        return getVariant(id, emptyNeighbours);
+    }
+};
+
+#endif // AUTOTILER_H
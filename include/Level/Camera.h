@@ -82,6 +82,7 @@ public:
     CameraMode getMode() const { return m_mode; }
     bool isBoundless() const { return m_isBoundless; }
     const sf::Vector2f& getPosition() const { return m_view.getCenter(); }
+    sf::Vector2f getVelocity() const { return m_position - m_previousPosition; } // Movement in the last update, in world coords
     const sf::Vector2f& getDimensions() const { return m_view.getSize(); }
     float getZoom() const { return m_zoom; }
 };
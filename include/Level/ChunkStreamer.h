@@ -0,0 +1,86 @@
+#ifndef CHUNKSTREAMER_H
+#define CHUNKSTREAMER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Level/MapFile.h"
+#include "Level/TileLayer.h"
+
+// Chunks of every layer at one chunk position of a Map
+struct StreamedChunk
+{
+    unsigned int chunkX;
+    unsigned int chunkY;
+    std::vector<TileLayer::Chunk> layers; // One per layer, with a tileCount of 0 where the layer has no Tiles
+};
+
+// Reads and decodes chunks of a binary Map file on a worker thread, for Maps too large to be kept in memory
+// Chunks modified since the file was saved are written to a journal file next to it (<filename>.journal), which takes precedence
+// over the Map file when reading them back, until the Map is saved again
+
+class ChunkStreamer final
+{
+private:
+    struct Task
+    {
+        bool isWrite; // Write the chunk's layers to the journal, or read them into a loaded chunk
+        StreamedChunk chunk;
+    };
+
+    MapFile m_mapFile;
+    std::string m_filename;
+    unsigned int m_layerCount;
+
+    std::fstream m_journal;
+    std::unordered_map<std::uint64_t, std::pair<std::uint64_t, std::size_t>> m_journalIndex; // Chunk key -> data offset and size
+    std::uint64_t m_journalSize;
+    bool m_isJournalOpen; // Only changed while the worker is stopped, so that it can be read without locking
+    std::mutex m_fileMutex; // Guards the files and the journal index
+
+    std::deque<Task> m_tasks;
+    std::vector<StreamedChunk> m_loadedChunks;
+    bool m_isWorking;
+    bool m_isStopping;
+    std::mutex m_taskMutex; // Guards the tasks, the loaded chunks, and the worker's state
+    std::condition_variable m_taskCondition;
+    std::condition_variable m_idleCondition;
+    std::thread m_thread;
+
+    // Functions
+    void worker();
+    bool readLayerChunk(unsigned int z, unsigned int chunkX, unsigned int chunkY, TileLayer::Chunk& chunk);
+    void writeLayerChunks(const StreamedChunk& chunk);
+    std::string getJournalPath() const;
+
+public:
+    // Constructor and destructor
+    ChunkStreamer();
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+    ~ChunkStreamer();
+
+    // Functions
+    bool open(const std::string& filename, unsigned int layerCount);
+    void close();
+    void requestLoad(unsigned int chunkX, unsigned int chunkY);
+    void requestWrite(StreamedChunk chunk);
+    void takeLoadedChunks(std::vector<StreamedChunk>& chunks);
+    void waitUntilIdle();
+    bool readChunkNow(unsigned int z, unsigned int chunkX, unsigned int chunkY, TileLayer::Chunk& chunk);
+    bool replaceMapFile(const std::string& savedFilename);
+
+    // Getters
+    const MapFile& getMapFile() const { return m_mapFile; }
+    const std::string& getFilename() const { return m_filename; }
+    bool isJournalOpen() const { return m_isJournalOpen; }
+};
+
+#endif // CHUNKSTREAMER_H
@@ -0,0 +1,59 @@
+#ifndef COLLISIONLAYER_H
+#define COLLISIONLAYER_H
+
+#include <array>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include "Level/Tile.h"
+#include "Level/TileLayer.h"
+
+// Rectangle of Tiles sharing a TileCollision, in Tile indices
+struct CollisionRect
+{
+    sf::IntRect tileRect;
+    TileCollision collision;
+};
+
+// Colliding Tiles of a Map layer greedily merged into rectangles, so that Entities resolve collisions against a few rectangles
+// instead of every Tile of a long floor or wall, and without catching on the seams between its Tiles
+// Merging is done per region (the size of a TileLayer chunk) so that an edit only rebuilds the rectangles of its region
+// Solid Tiles are merged into maximal rectangles, and Platform Tiles into rows since only their top side collides
+
+class CollisionLayer final
+{
+public:
+    static constexpr unsigned int regionSize = TileLayer::chunkSize;
+
+    using RegionCollisions = std::array<TileCollision, regionSize * regionSize>; // Row-major
+
+private:
+    struct Region
+    {
+        std::vector<CollisionRect> rects;
+        bool isDirty;
+    };
+
+    std::vector<Region> m_regions; // Row-major
+    sf::Vector2u m_dimensions;
+    sf::Vector2u m_regionCounts;
+
+public:
+    // Constructor
+    CollisionLayer();
+
+    // Functions
+    void resize(const sf::Vector2u& dimensions);
+    void findRects(const sf::Vector2u& tileIndex, const sf::Vector2u& range, std::vector<CollisionRect>& rects) const;
+
+    // Setters
+    void setRegion(unsigned int regionX, unsigned int regionY, const RegionCollisions& collisions);
+    void setRegionDirty(unsigned int regionX, unsigned int regionY) { m_regions[regionY * m_regionCounts.x + regionX].isDirty = true; }
+
+    // Getters
+    bool isRegionDirty(unsigned int regionX, unsigned int regionY) const { return m_regions[regionY * m_regionCounts.x + regionX].isDirty; }
+    const sf::Vector2u& getRegionCounts() const { return m_regionCounts; }
+    std::size_t getRectCount() const;
+    std::size_t getMemoryUsage() const;
+};
+
+#endif // COLLISIONLAYER_H
@@ -1,9 +1,11 @@
 #ifndef ENTITY_H
 #define ENTITY_H
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <SFML/Graphics.hpp>
+#include "Level/CollisionLayer.h"
 #include "Level/Map.h"
 #include "Level/Tile.h"
 #include "Misc/AnimatedSprite.h"
@@ -49,6 +51,7 @@ private:
     float m_deceleration;
 
     bool m_isTileCollideable;
+    std::vector<CollisionRect> m_collisionRects; // Reused by performCollisions() to avoid reallocating each tick
     bool m_isEntityCollideable;
 
     bool m_isFacingRight;
@@ -65,14 +68,14 @@ private:
     float m_defaultDescentSpeed;
 
     // Collisions and interactions
-    void tileCollision(const Tile* tile);
+    void tileCollision(const CollisionRect& collisionRect);
     void entityCollision(const Entity* entity);
-    void tileReaction(Tile* tile);
+    void tileReaction(const Tile& tile);
     void entityReaction(Entity* entity);
 
     // TileCollision functions (overrideable)
-    virtual void standardCollision(const Tile* tile);
-    virtual void ladderTopCollision(const Tile* tile);
+    virtual void standardCollision(const sf::FloatRect& bounds);
+    virtual void ladderTopCollision(const sf::FloatRect& bounds);
 
     // EntityCollision functions (overrideable)
     // ---
@@ -151,6 +154,7 @@ public:
     EntityType getEntityType() const { return m_entityType; }
     static std::string getEntityTypeString(EntityType entityType);
     static std::vector<std::string> getTextureNames(EntityType entityType);
+    static std::uint8_t getLightLevel(EntityType entityType);
 
     const sf::Vector2f& getPosition() const { return m_position; }
     const sf::Vector2f& getDimensions() const { return m_dimensions; }
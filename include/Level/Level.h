@@ -1,11 +1,16 @@
 #ifndef LEVEL_H
 #define LEVEL_H
 
+#include <memory>
+#include <ostream>
+#include <set>
 #include <vector>
 #include "Core/Input/InputManager.h"
 #include "Core/ResourceManager.h"
 #include "Level/Camera.h"
 #include "Level/EntityTracker.h"
+#include "Level/LevelGenerator.h"
+#include "Level/LevelSaver.h"
 #include "Level/Map.h"
 #include "Level/ParallaxSprite.h"
 
@@ -25,13 +30,20 @@ private:
     bool m_isCreatorModeEnabled;
     bool m_isEntityDebugBoxVisible;
 
+    std::unique_ptr<LevelSaver> m_levelSaver; // nullptr if the Level is not being saved in the background
+    bool m_hasSaveFailed;
+
     // Functions
+    Entity* createEntity(EntityType entityType, const sf::Vector2f& position);
     bool loadBackground(const std::string& filename);
     bool saveBackground(const std::string& filename) const;
+    void writeBackground(std::ostream& output) const;
     bool loadEntities(const std::string& filename);
     bool saveEntities(const std::string& filename) const;
+    void writeEntities(std::ostream& output) const;
     bool loadResources(const std::string& filename);
     bool saveResources(const std::string& filename) const;
+    void addBackgroundAndEntityResources(std::set<std::string>& resources) const;
 
 public:
     // Constructor and destructor
@@ -45,12 +57,17 @@ public:
 
     bool load(const std::string& levelDirectory);
     bool save(const std::string& levelDirectory) const;
+    bool generate(const LevelGenerator::Settings& settings);
+    bool saveInBackground(const std::string& levelDirectory);
+    void finishSave();
 
     void onWindowResize();
 
     sf::Vector2u coordsToTileIndex(const sf::Vector2f& position) const { return m_map.coordsToTileIndex(position); }
     sf::Vector2f tileIndexToCoords(const sf::Vector2u& position) const { return m_map.tileIndexToCoords(position); }
 
+    void beginEdit() { m_map.beginEdit(); }
+    void commitEdit() { m_map.commitEdit(); }
     void addTile(TileType tileType, const sf::Vector2u& tileIndex, MapLayer layer, bool updateTextures = false);
     void addTileRange(TileType tileType, const sf::Vector2u& tileIndex, const sf::Vector2u& range, MapLayer layer,
                       bool updateTextures = false);
@@ -67,6 +84,11 @@ public:
     // Getters
     const sf::Vector2u& getMapIndexDimensions() const { return m_map.getIndexDimensions(); }
     unsigned int getTileSize() const { return m_map.getTileSize(); }
+    unsigned int getMapDrawnTileCount() const { return m_map.getDrawnTileCount(); }
+    unsigned int getMapOccludedTileCount() const { return m_map.getOccludedTileCount(); }
+    bool isSaving() const { return m_levelSaver != nullptr; }
+    float getSaveProgress() const { return m_levelSaver != nullptr ? m_levelSaver->getProgress() : 0; }
+    bool hasSaveFailed() const { return m_hasSaveFailed; }
     sf::Vector2f getLevelMousePosition() const { return m_inputManager.getMousePosition(m_camera.getView()); }
 };
 
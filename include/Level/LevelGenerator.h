@@ -0,0 +1,37 @@
+#ifndef LEVELGENERATOR_H
+#define LEVELGENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+#include "Level/Autotiler.h"
+#include "Level/TileLayer.h"
+#include "Level/TileRegistry.h"
+
+// Procedural Levels for stress tests and benchmarks: hilly terrain with caves, ladder shafts, hanging vines, and many Entities
+// Every cell only depends on the seed and its position (hashed value noise), so chunks are generated in parallel, in any order,
+// with the same result for a given seed. Levels are generated into a Map (see Map::generate() and Level::generate()), or saved
+// directly to a Level directory without loading any texture (saveLevel(), used by the --generate-level command line option)
+
+class LevelGenerator final
+{
+public:
+    struct Settings
+    {
+        sf::Vector2u dimensions; // In Tiles, from 100x100 to 4096x4096 for benchmarks
+        std::uint32_t seed;
+        unsigned int entityCount;
+        unsigned int tileSize;
+    };
+
+    // Functions
+    static Settings getDefaultSettings(const sf::Vector2u& dimensions, std::uint32_t seed);
+    static bool areSettingsValid(const Settings& settings);
+    static void generateLayers(const Settings& settings, const TileRegistry& tileRegistry, const Autotiler& autotiler,
+                               std::vector<TileLayer>& layers);
+    static void getSpawnTiles(const Settings& settings, std::vector<sf::Vector2u>& spawnTiles);
+    static bool saveLevel(const std::string& levelDirectory, const Settings& settings);
+};
+
+#endif // LEVELGENERATOR_H
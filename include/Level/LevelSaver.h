@@ -0,0 +1,54 @@
+#ifndef LEVELSAVER_H
+#define LEVELSAVER_H
+
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+#include "Level/Map.h"
+
+// Contents of a Level's save files at the time it was saved
+struct LevelSnapshot
+{
+    Map::Snapshot map;
+    std::string background; // Contents of background.txt
+    std::string entities; // Contents of entities.txt
+    std::set<std::string> resources; // Of the background and the Entities, those of the Tiles are added from the Map snapshot
+};
+
+// Saves a snapshot of a Level on a worker thread, so that the Level can still be edited while it is being saved
+// The files are first written to a temporary directory inside the Level directory, and only renamed into place once all of them are
+// complete, so that a save interrupted before then leaves the previous files intact
+
+class LevelSaver final
+{
+private:
+    LevelSnapshot m_snapshot; // Shares the Map's chunks, so it is only destroyed by the thread owning the Map, after the worker
+    std::string m_levelDirectory;
+
+    std::atomic<float> m_progress;
+    std::atomic<bool> m_isDone;
+    bool m_isSaved; // Set by the worker before m_isDone
+    std::thread m_thread;
+
+    // Functions
+    void worker();
+    bool writeFile(const std::string& filename, const std::string& contents) const;
+
+public:
+    // Constructor and destructor
+    LevelSaver(const std::string& levelDirectory, LevelSnapshot snapshot);
+    LevelSaver(const LevelSaver&) = delete;
+    LevelSaver& operator=(const LevelSaver&) = delete;
+    ~LevelSaver();
+
+    // Functions
+    bool wait();
+
+    // Getters
+    const std::string& getLevelDirectory() const { return m_levelDirectory; }
+    float getProgress() const { return m_progress; }
+    bool isDone() const { return m_isDone; }
+};
+
+#endif // LEVELSAVER_H
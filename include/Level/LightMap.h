@@ -0,0 +1,77 @@
+#ifndef LIGHTMAP_H
+#define LIGHTMAP_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "Level/SolidityMask.h"
+#include "Level/TileLayer.h"
+
+// Light level of each cell of a Map, spread from light-emitting Tiles and from moving lights (e.g. carried by Entities)
+// Light spreads to the 4 neighbours of a cell, losing one level per cell, and solid cells are lit but do not pass it on
+// A light only reaches cells within lightRadius of it, so a change (an edit, a moving light) only affects the cells within lightRadius
+// of it. Changes mark those cells dirty, and update() recomputes each dirty rectangle by flood filling the lights of a window
+// extending lightRadius around it, instead of the whole Map. Levels are stored per chunk, allocated only where cells are lit
+
+class LightMap final
+{
+public:
+    static constexpr std::uint8_t maxLightLevel = 15;
+    static constexpr unsigned int lightRadius = maxLightLevel - 1; // Farthest cell (in steps between neighbours) lit by a light
+
+    struct PointLight
+    {
+        sf::Vector2u tileIndex;
+        std::uint8_t level; // 0 if the light is off
+    };
+
+private:
+    using LevelChunk = std::array<std::uint8_t, TileLayer::chunkSize * TileLayer::chunkSize>; // Row-major
+
+    std::vector<std::unique_ptr<LevelChunk>> m_levelChunks; // Row-major table of chunks, nullptr where no cell was lit
+    std::vector<std::vector<PointLight>> m_tileLights; // Light-emitting Tiles of each chunk
+    std::vector<PointLight> m_movingLights; // Indexed by light id
+    std::vector<sf::IntRect> m_dirtyRects; // Cells whose level is out of date, in Tile indices
+    sf::Vector2u m_dimensions;
+    sf::Vector2u m_chunkCounts;
+
+    // Flood fill buffers, kept between updates to avoid allocations
+    std::vector<std::uint8_t> m_windowLevels;
+    std::array<std::vector<std::uint32_t>, maxLightLevel + 1> m_queues; // Cells of the window to spread light from, per level
+
+    std::size_t m_updatedCellCount; // Cells recomputed by the last update()
+
+    // Functions
+    void recomputeRect(const sf::IntRect& rect, const SolidityMask& solidityMask);
+    sf::IntRect getDirtyRect(const sf::Vector2u& tileIndex, const sf::Vector2u& range) const;
+
+public:
+    // Constructor
+    LightMap();
+
+    // Functions
+    void resize(const sf::Vector2u& dimensions);
+    void setDirty(const sf::Vector2u& tileIndex, const sf::Vector2u& range = sf::Vector2u(1, 1));
+    void update(const SolidityMask& solidityMask);
+
+    // Setters
+    void setTileLight(unsigned int x, unsigned int y, std::uint8_t level);
+    void setChunkTileLights(unsigned int chunkX, unsigned int chunkY, std::vector<PointLight> lights);
+    void setMovingLight(std::size_t id, const PointLight& light);
+    void clearMovingLights();
+
+    // Getters
+    std::uint8_t getLevel(unsigned int x, unsigned int y) const
+    {
+        const LevelChunk* chunk = m_levelChunks[(y >> TileLayer::chunkSizeLog2) * m_chunkCounts.x + (x >> TileLayer::chunkSizeLog2)].get();
+        return chunk != nullptr ? (*chunk)[(y & (TileLayer::chunkSize - 1)) * TileLayer::chunkSize + (x & (TileLayer::chunkSize - 1))] : 0;
+    }
+    bool isDirty() const { return m_dirtyRects.empty() == false; }
+    std::size_t getUpdatedCellCount() const { return m_updatedCellCount; }
+    std::size_t getMemoryUsage() const;
+};
+
+#endif // LIGHTMAP_H
@@ -1,11 +1,30 @@
 #ifndef MAP_H
 #define MAP_H
 
+#include <algorithm>
 #include <array>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <SFML/Graphics.hpp>
 #include "Core/ResourceManager.h"
+#include "Level/Autotiler.h"
+#include "Level/CollisionLayer.h"
+#include "Level/LevelGenerator.h"
+#include "Level/LightMap.h"
+#include "Level/SolidityMask.h"
 #include "Level/Tile.h"
+#include "Level/TileLayer.h"
+#include "Level/TileRegistry.h"
+
+class ChunkStreamer;
 
 enum class MapLayer
 {
@@ -17,19 +36,108 @@ enum class MapLayer
 
 class Map final : public sf::Drawable
 {
+public:
+    static constexpr std::size_t maxTileTypeId = 999; // TileType ids are saved as at most 3 digits
+    static const sf::Vector2u maxDimensions; // In Tiles
+
+    // Copy of the saved layers of a fully loaded Map, sharing their chunks with it until either is edited, to be saved on another thread
+    struct Snapshot
+    {
+        std::vector<TileLayer> layers; // The Overlay layer is left empty since it is not saved
+        sf::Vector2u indexDimensions;
+        unsigned int tileSize;
+        std::vector<std::string> textureNames; // Per TileType id
+        std::string baseFilename; // Binary Map file matching the snapshot except for its changed chunks, empty if none
+        std::vector<std::size_t> changedChunks;
+    };
+
 private:
+    struct ChunkMesh
+    {
+        sf::VertexArray vertices; // Quads of the chunk's Tiles, textured from the Tile atlas
+        unsigned int lastDrawnFrame;
+        bool isDirty;
+        bool hasAnimatedTiles;
+        unsigned int occludedTileCount; // Background Tiles left out because they are hidden
+    };
+
+    struct BakedChunk
+    {
+        std::unique_ptr<sf::RenderTexture> renderTexture; // Chunk's Tiles pre-rendered with their layer's color
+        unsigned int lastDrawnFrame;
+        bool isDirty;
+        bool hasAnimatedTiles; // Baked again when their frames change
+    };
+
+    struct LodChunk
+    {
+        sf::Texture texture; // Chunk's Tiles downsampled to a few pixels each, drawn instead of them when zoomed out
+        unsigned int level; // Tiles are downsampled by 2^level
+        unsigned int lastDrawnFrame;
+        bool isDirty;
+        bool hasAnimatedTiles; // Built again when their frames change
+    };
+
+    using OcclusionMask = std::bitset<TileLayer::chunkSize * TileLayer::chunkSize>; // Row-major
+
+    // Residency of a chunk position (all layers) of a streamed Map
+    enum class ChunkState : std::uint8_t
+    {
+        Unloaded,
+        Loading,
+        Loaded
+    };
+
     const ResourceManager& m_resourceManager;
 
-    std::vector<std::vector<std::vector<Tile*>>> m_tiles;
+    std::vector<TileLayer> m_layers; // Sparse chunked storage of cells, one per layer
+    TileRegistry m_tileRegistry; // TileDefs of all TileTypes, and atlas of the textures of those used
+    Autotiler m_autotiler;
+    SolidityMask m_solidityMask; // Solid cells of the Solid layer, for collision queries
+    // Per chunk, cells whose Background Tile is hidden behind an opaque Tile of the Solid layer, and left out of meshes
+    std::vector<OcclusionMask> m_occlusionMasks;
+    mutable CollisionLayer m_collisionLayer; // Colliding Tiles of the Solid layer merged into rectangles, rebuilt when queried while dirty
+    LightMap m_lightMap; // Light levels of the cells, spread from light-emitting Tiles and moving lights, blocked by the Solid layer
+    mutable sf::Texture m_lightTexture; // Light levels of the visible Tiles, one texel per Tile
+    mutable std::vector<sf::Uint8> m_lightPixels;
+    std::uint8_t m_ambientLightLevel; // Minimum light level of all Tiles when drawing the light map
+    mutable std::vector<std::vector<ChunkMesh>> m_chunkMeshes; // One mesh per chunk per layer, (re)built when drawn while dirty
+    mutable std::unordered_map<std::uint64_t, BakedChunk> m_bakedChunks; // Keyed by layer (high 32 bits) and chunk index
+    mutable std::vector<std::unique_ptr<sf::RenderTexture>> m_freeRenderTextures; // Render textures of evicted chunks, for reuse
+    mutable std::unordered_map<std::uint64_t, LodChunk> m_lodChunks; // Keyed as baked chunks
+    mutable std::size_t m_meshVertexCount;
+    mutable unsigned int m_frameCount;
+    mutable unsigned int m_drawCallCount;
+    mutable unsigned int m_lodChunkBuildCount; // Downsampled chunks built in the current frame
+    mutable unsigned int m_drawnTileCount; // Tiles drawn from chunk meshes in the last frame (baked and downsampled chunks excluded)
+    mutable unsigned int m_occludedTileCount; // Background Tiles hidden behind the Solid layer and not drawn in the last frame
+    unsigned int m_animationTick; // Clock shared by all animated Tiles, advanced on update()
 
     mutable sf::RectangleShape m_horizGridLine;
     mutable sf::RectangleShape m_vertGridLine;
 
+    unsigned int m_editDepth;
+    std::unordered_set<std::uint64_t> m_pendingTextureUpdates; // Tiles to update on commitEdit(), keyed by layer (high 32 bits), y and x
+
+    // Streaming of large binary Maps, where only chunks around the Camera are kept in the layers
+    std::unique_ptr<ChunkStreamer> m_chunkStreamer; // nullptr if the Map is fully loaded
+    std::vector<ChunkState> m_chunkStates;
+    std::vector<bool> m_isChunkModified; // Chunks edited since loaded, written back to the streamer's journal when evicted
+    std::vector<std::size_t> m_residentChunks; // Indices of loaded chunks
+    unsigned int m_streamingLoadRadius; // In chunks around the view
+    unsigned int m_streamingEvictRadius;
+
+    // Change journal of a fully loaded Map, so that saving it back to its binary Map file only writes the edited chunks
+    mutable std::string m_savedFilename; // Binary Map file matching the Map except for the unsaved chunks, empty if none
+    mutable std::vector<std::size_t> m_unsavedChunks; // Indices of chunks (all layers) edited since loaded or saved
+    mutable std::vector<bool> m_isChunkUnsaved;
+
     sf::Vector2u m_indexDimensions;
     const unsigned int m_layerCount; // Set to MapLayer::Count in constructor, to avoid repetitive casts
     unsigned int m_tileSize;
 
     std::array<sf::Color, static_cast<std::size_t>(MapLayer::Count)> m_layerColors;
+    mutable std::array<bool, static_cast<std::size_t>(MapLayer::Count)> m_isLayerBaked; // Reset when drawn if baking fails
 
     bool m_isGridVisible;
 
@@ -37,6 +145,45 @@ private:
     virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
     void drawGrid(sf::RenderTarget& target, sf::RenderStates states) const;
 
+    void buildChunkMesh(ChunkMesh& mesh, unsigned int chunkX, unsigned int chunkY, unsigned int z) const;
+    void releaseUndrawnChunkMeshes() const;
+    bool drawBakedChunk(sf::RenderTarget& target, sf::RenderStates states, unsigned int chunkX, unsigned int chunkY, unsigned int z) const;
+    void evictUndrawnBakedChunks() const;
+    unsigned int getLodLevel(float tilePixelSize) const;
+    bool drawLodChunk(sf::RenderTarget& target, sf::RenderStates states, unsigned int chunkX, unsigned int chunkY, unsigned int z,
+                      unsigned int level) const;
+    bool buildLodChunk(LodChunk& lodChunk, const TileLayer::Chunk& chunk, unsigned int level) const;
+    void evictUndrawnLodChunks() const;
+    void releaseBakedChunks(unsigned int z);
+    void resetChunkMeshes();
+    void setLayerDirty(unsigned int z);
+    void setChunkDirty(unsigned int z, std::size_t chunkIndex);
+    void updateSolidityMask(unsigned int chunkX, unsigned int chunkY);
+    void updateOcclusionMask(unsigned int chunkX, unsigned int chunkY);
+    void rebuildSolidityMask();
+    void updateChunkLights(unsigned int chunkX, unsigned int chunkY);
+    void rebuildLightMap();
+    void updateCollisionRegion(unsigned int regionX, unsigned int regionY) const;
+
+    void installStreamedChunks();
+    bool evictChunk(std::size_t chunkIndex);
+    void stopStreaming();
+    void resetSaveJournal(const std::string& savedFilename) const;
+
+    bool parseLayers(std::istream& input, const std::string& filename);
+    bool parseLayersParallel(const std::string& content);
+    void autotileLayers();
+
+    bool resolveTileType(std::uint16_t id);
+    void resolveChunk(TileLayer::Chunk& chunk);
+    void setCell(unsigned int x, unsigned int y, unsigned int z, TileCell cell);
+    void updateTileTextures(const sf::Vector2u& tileIndex, const sf::Vector2u& range, MapLayer layer);
+    std::uint16_t getAutotiledId(unsigned int x, unsigned int y, unsigned int z) const;
+    const TileCell& getCell(unsigned int x, unsigned int y, unsigned int z) const { return m_layers[z].getCell(x, y); }
+    bool isCellSolid(unsigned int x, unsigned int y, unsigned int z) const { return m_tileRegistry.getDef(getCell(x, y, z).id).isSolid(); }
+    bool isOccluding(const TileDef& def) const;
+    std::uint8_t getTileLightLevel(unsigned int x, unsigned int y) const;
+
 public:
     // Constructor and destructor
     explicit Map(const ResourceManager& resourceManager);
@@ -46,11 +193,26 @@ public:
     void update();
     bool load(const std::string& filename);
     bool save(const std::string& filename) const;
+    bool loadBinary(const std::string& filename, bool allowStreaming = false);
+    bool saveBinary(const std::string& filename) const;
+    bool generate(const LevelGenerator::Settings& settings);
+    bool takeSnapshot(Snapshot& snapshot, const std::string& filename) const;
+    void onSnapshotSaveFailed(const std::string& filename) const;
+    static bool saveSnapshot(const Snapshot& snapshot, const std::string& filename, const std::function<void(float)>& onProgress);
+    static void addTextureNames(const Snapshot& snapshot, std::set<std::string>& textureNames);
+
+    void updateLighting() { m_lightMap.update(m_solidityMask); }
+    void drawLightMap(sf::RenderTarget& target, sf::RenderStates states) const;
+
+    void updateStreaming(const sf::FloatRect& viewRect, const sf::Vector2f& viewVelocity);
+    void finishStreaming();
 
     sf::Vector2u coordsToTileIndex(const sf::Vector2f& position) const;
     sf::Vector2f tileIndexToCoords(const sf::Vector2u& position) const;
 
     // Tile functions
+    void beginEdit();
+    void commitEdit();
     void updateTileTexture(const sf::Vector2u& tileIndex, MapLayer layer);
 
     void addTile(TileType tileType, const sf::Vector2u& tileIndex, MapLayer layer, bool updateTextures = false);
@@ -65,7 +227,12 @@ public:
 
     // Setters
     void setLayerColor(sf::Color color, MapLayer layer);
+    void setLayerBaked(MapLayer layer, bool isBaked);
     void setGridVisible(bool isGridVisible) { m_isGridVisible = isGridVisible; }
+    void setStreamingRadii(unsigned int loadRadius, unsigned int evictRadius);
+    void setMovingLight(std::size_t id, const sf::Vector2f& position, std::uint8_t level);
+    void clearMovingLights() { m_lightMap.clearMovingLights(); }
+    void setAmbientLightLevel(std::uint8_t level) { m_ambientLightLevel = std::min(level, LightMap::maxLightLevel); }
 
     // Getters
     const sf::Vector2u& getIndexDimensions() const { return m_indexDimensions; }
@@ -74,9 +241,19 @@ public:
     unsigned int getTileSize() const { return m_tileSize; }
     sf::Vector2u getBounds() const;
     bool isNull() const;
+    std::size_t getMemoryUsage() const;
+    unsigned int getDrawCallCount() const { return m_drawCallCount; }
+    unsigned int getDrawnTileCount() const { return m_drawnTileCount; }
+    unsigned int getOccludedTileCount() const { return m_occludedTileCount; }
+    std::size_t getBakedChunkCount() const { return m_bakedChunks.size(); }
+    bool isStreaming() const { return m_chunkStreamer != nullptr; }
+    std::size_t getResidentChunkCount() const { return m_residentChunks.size(); }
 
-    const Tile* getKTilePtr(const sf::Vector2u& index, MapLayer layer) const;
-    Tile* getTilePtr(const sf::Vector2u& index, MapLayer layer) const;
+    Tile getTile(const sf::Vector2u& index, MapLayer layer) const;
+    const SolidityMask& getSolidityMask() const { return m_solidityMask; }
+    bool isTileSolid(const sf::Vector2u& index) const { return m_solidityMask.isSolid(index.x, index.y); }
+    void getCollisionRects(const sf::Vector2u& tileIndex, const sf::Vector2u& range, std::vector<CollisionRect>& rects) const;
+    const LightMap& getLightMap() const { return m_lightMap; }
 };
 
 #endif // MAP_H
@@ -0,0 +1,63 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+#include "Core/MemoryMappedFile.h"
+#include "Level/TileLayer.h"
+
+// Binary Map file, read in place from a memory-mapped file
+// Layout (little-endian):
+//   Header:      "TMAP", u16 version, u16 layer count, u32 width, u32 height, u32 TileSize, u32 chunk size
+//   Index:       for each layer, one (u32 offset, u32 size) entry per chunk in row-major order (offset 0 if the chunk is empty)
+//   Chunk data:  u8 encoding, followed by either 1024 raw u16 TileType ids, or (u16 run length, u16 TileType id) runs
+// Chunks saved again are appended and their index entries rewritten, leaving their old data unreferenced until the file is
+// saved in full (compacted)
+
+class MapFile final
+{
+public:
+    using ChunkGetter = std::function<const TileLayer::Chunk*(unsigned int z, unsigned int chunkX, unsigned int chunkY)>;
+
+private:
+    MemoryMappedFile m_file;
+
+    unsigned int m_version;
+    unsigned int m_layerCount;
+    sf::Vector2u m_dimensions;
+    sf::Vector2u m_chunkCounts;
+    unsigned int m_tileSize;
+
+    // Functions
+    std::size_t getIndexEntryOffset(unsigned int z, std::size_t chunkIndex) const;
+
+public:
+    // Constructor
+    MapFile();
+
+    // Functions
+    bool open(const std::string& filename);
+    void close();
+    bool readChunk(unsigned int z, unsigned int chunkX, unsigned int chunkY, TileLayer::Chunk& chunk) const;
+
+    static void encodeChunk(const TileLayer::Chunk& chunk, std::vector<char>& buffer);
+    static bool decodeChunk(const char* data, std::size_t size, TileLayer::Chunk& chunk);
+    static bool save(const std::string& filename, const sf::Vector2u& dimensions, unsigned int tileSize, unsigned int layerCount,
+                     const ChunkGetter& getChunk);
+    static bool saveChunks(const std::string& filename, const sf::Vector2u& dimensions, unsigned int tileSize, unsigned int layerCount,
+                           const std::vector<std::size_t>& chunkIndices, const ChunkGetter& getChunk);
+
+    // Getters
+    bool isOpen() const { return m_file.isOpen(); }
+    unsigned int getVersion() const { return m_version; }
+    unsigned int getLayerCount() const { return m_layerCount; }
+    const sf::Vector2u& getDimensions() const { return m_dimensions; }
+    const sf::Vector2u& getChunkCounts() const { return m_chunkCounts; }
+    unsigned int getTileSize() const { return m_tileSize; }
+    bool hasChunk(unsigned int z, unsigned int chunkX, unsigned int chunkY) const;
+};
+
+#endif // MAPFILE_H
@@ -0,0 +1,59 @@
+#ifndef MAPQUERY_H
+#define MAPQUERY_H
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Level/Map.h"
+#include "Level/Tile.h"
+
+struct Ray
+{
+    sf::Vector2f origin;
+    sf::Vector2f direction; // Does not need to be normalized
+    float maxDistance;
+};
+
+struct RaycastHit
+{
+    bool isHit;
+    sf::Vector2u tileIndex; // Solid Tile hit
+    sf::Vector2f position; // Point where the ray enters the Tile
+    sf::Vector2f normal; // Normal of the Tile's side which was hit, (0, 0) if the ray starts inside of it
+    float distance;
+};
+
+struct SweepHit
+{
+    bool isHit;
+    sf::Vector2u tileIndex; // First solid Tile touched
+    sf::Vector2f position; // Position of the box (top left) at contact
+    sf::Vector2f normal; // Normal of the Tile's side which was touched
+    float time; // Fraction of the displacement done before contact, in [0, 1]
+};
+
+// Spatial queries against the Solid layer of a Map (raycasts, swept boxes, overlaps), for line of sight, AI, and movement
+// Queries are const, allocate nothing (results are written to caller-provided vectors), and mostly read the Map's solidity mask,
+// so that many of them can be done each tick. Coordinates are world coordinates, and areas outside of the Map are empty
+
+class MapQuery final
+{
+private:
+    const Map& m_map;
+
+    // Functions
+    bool getTileRange(const sf::FloatRect& area, sf::Vector2u& tileIndex, sf::Vector2u& range) const;
+
+public:
+    // Constructor
+    explicit MapQuery(const Map& map);
+
+    // Functions
+    RaycastHit raycast(const Ray& ray) const;
+    void raycast(const std::vector<Ray>& rays, std::vector<RaycastHit>& hits) const;
+    bool isLineOfSightClear(const sf::Vector2f& start, const sf::Vector2f& end) const;
+    SweepHit sweepBox(const sf::FloatRect& box, const sf::Vector2f& displacement) const;
+    bool isAreaClear(const sf::FloatRect& area) const;
+    std::size_t findTiles(const sf::FloatRect& area, MapLayer layer, TileCategory category, std::vector<Tile>& tiles) const;
+};
+
+#endif // MAPQUERY_H
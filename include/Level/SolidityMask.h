@@ -0,0 +1,45 @@
+#ifndef SOLIDITYMASK_H
+#define SOLIDITYMASK_H
+
+#include <cstdint>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+// Packed bitset of the solid cells of a Map layer, one bit per cell in rows of 64-bit words
+// Rows and rectangles of cells (e.g. the footprint of an Entity's bounding box) are tested a word at a time
+// Ranges are given as a starting index and a size, like Tile ranges of the Map, and are clamped to the mask's dimensions
+
+class SolidityMask final
+{
+private:
+    std::vector<std::uint64_t> m_words; // Row-major, each row padded to a whole number of words
+    sf::Vector2u m_dimensions;
+    std::size_t m_wordsPerRow;
+
+public:
+    // Constructor
+    SolidityMask();
+
+    // Functions
+    void resize(const sf::Vector2u& dimensions);
+    void fill(bool isSolid);
+
+    // Setters
+    void setSolid(unsigned int x, unsigned int y, bool isSolid);
+    void setRowSolid(unsigned int x, unsigned int y, unsigned int count, bool isSolid);
+
+    // Getters
+    bool isSolid(unsigned int x, unsigned int y) const
+    {
+        return x < m_dimensions.x && y < m_dimensions.y && (m_words[y * m_wordsPerRow + (x >> 6)] >> (x & 63) & 1) != 0;
+    }
+    bool isAnySolidInRow(unsigned int x, unsigned int y, unsigned int count) const;
+    bool isAllSolidInRow(unsigned int x, unsigned int y, unsigned int count) const;
+    bool isAnySolid(const sf::Vector2u& index, const sf::Vector2u& range) const;
+    bool isAllSolid(const sf::Vector2u& index, const sf::Vector2u& range) const;
+    int findFirstSolidInRow(unsigned int x, unsigned int y, unsigned int count) const;
+    const sf::Vector2u& getDimensions() const { return m_dimensions; }
+    std::size_t getMemoryUsage() const { return m_words.capacity() * sizeof(std::uint64_t); }
+};
+
+#endif // SOLIDITYMASK_H
@@ -1,10 +1,15 @@
 #ifndef TILE_H
 #define TILE_H
 
+#include <cstdint>
+#include <string>
+#include <vector>
 #include <SFML/Graphics.hpp>
 
 enum class TileType
 {
+    Unloaded = 1, // Solid placeholder for Tiles of streamed Map chunks which are not loaded yet
+
     GrassTopLeftSides = 100,
     GrassTopSide = 101,
     GrassTopRightSides = 102,
@@ -51,42 +56,86 @@ enum class TileType
     Post = 501
 };
 
-class Tile : public sf::Drawable
+// Ranges of TileType ids, as listed in tile_info.txt
+enum class TileCategory
 {
-private:
-    TileType m_tileType;
+    Special, // 000 - 009, not rendered
+    Background, // 010 - 099
+    Static, // 100 - 199
+    Animated, // 200 - 299
+    Large, // 300 - 399
+    Small, // 400 - 499
+    Decoration, // 500 - 599
+    Undefined, // 600 - 899
+    Custom // 900 - 999
+};
+
+enum class TileCollision
+{
+    None,
+    Solid,
+    Platform // Only collides with Entities from above (e.g. ladder tops)
+};
+
+// Frame of an animated TileType
+struct TileFrame
+{
+    std::string textureName; // Same dimensions as the TileType's texture
+    unsigned int duration; // In ticks
+};
 
-    sf::Sprite m_sprite;
+// Properties shared by all Tiles of a TileType, defined once in the TileRegistry
+struct TileDef
+{
+    std::string textureName; // Empty if the TileType is not rendered
+    sf::IntRect textureRect; // Region of the Tile atlas, set when the TileType is first used
+    bool isOpaque; // Texture (and every animation frame) has no transparent pixel, set when the TileType is first used
+    TileCollision collision;
+    float climbFactor; // Speed factor at which Entities climb the Tile, 0 if it cannot be climbed
+    std::uint8_t lightLevel; // Light emitted by the Tile (see LightMap), 0 if none
+    TileCategory category;
+    bool isDefined;
+    std::vector<TileFrame> frames; // Empty if the TileType is not animated
 
-    sf::Vector2f m_position;
-    sf::Vector2f m_dimensions;
+    bool isSolid() const { return collision != TileCollision::None; }
+    bool isAnimated() const { return frames.empty() == false; }
+};
 
-    bool m_isSolid;
+// Compact storage of a Map cell, holding the TileType id (0 if the cell is empty) and flags
+// Everything else about a Tile follows from its TileType's TileDef and the cell's index
+struct TileCell
+{
+    std::uint16_t id;
+    std::uint16_t flags;
+
+    bool isEmpty() const { return id == 0; }
+};
+
+// Lightweight view of a Map cell created on demand by the Map, giving access to the Tile's type, TileDef, and placement
+
+class Tile final
+{
+private:
+    TileCell m_cell;
+    const TileDef* m_def;
+    sf::Vector2u m_index;
+    unsigned int m_tileSize;
 
-protected:
-    // Functions
-    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    static const TileDef s_nullDef;
 
 public:
-    // Constructor and destructor
-    Tile(const sf::Texture& texture, TileType tileType);
-    virtual ~Tile() {}
-
-    // Setters
-    void setTileType(TileType tileType) { m_tileType = tileType; }
-    void setTexture(const sf::Texture& texture);
-    void setPosition(const sf::Vector2f& position);
-    void setDimensions(const sf::Vector2f& dimensions);
-    void setSolid(bool isSolid) { m_isSolid = isSolid; }
-    void setColor(sf::Color color) { m_sprite.setColor(color); }
+    // Constructor
+    Tile(TileCell cell = {0, 0}, const TileDef* def = nullptr, const sf::Vector2u& index = {0, 0}, unsigned int tileSize = 0);
 
     // Getters
-    TileType getTileType() const { return m_tileType; }
+    bool isNull() const { return m_cell.isEmpty(); }
+    TileType getTileType() const { return static_cast<TileType>(m_cell.id); }
     static std::string getTileTypeString(TileType tileType);
-    static std::string getTextureName(TileType tileType);
-    const sf::Vector2f& getPosition() const { return m_position; }
-    const sf::Vector2f& getDimensions() const { return m_dimensions; }
-    bool isSolid() const { return m_isSolid; }
+    const TileDef& getDef() const { return m_def != nullptr ? *m_def : s_nullDef; }
+    const sf::Vector2u& getIndex() const { return m_index; }
+    sf::Vector2f getPosition() const { return sf::Vector2f(m_index.x * m_tileSize, m_index.y * m_tileSize); }
+    sf::Vector2f getDimensions() const { return sf::Vector2f(m_tileSize, m_tileSize); }
+    bool isSolid() const { return getDef().isSolid(); }
 };
 
 #endif // TILE_H
@@ -0,0 +1,38 @@
+#ifndef TILEATLAS_H
+#define TILEATLAS_H
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+// Single texture into which the textures of TileTypes are copied on first use, so that whole chunks of Tiles can be drawn
+// with one draw call. Textures are packed in rows ("shelves"), and the atlas grows in height as needed
+
+class TileAtlas final
+{
+private:
+    sf::Image m_image; // CPU-side copy of the atlas, used to keep its content when it grows
+    sf::Texture m_texture;
+    std::vector<sf::IntRect> m_textureRects; // Indexed by TileType id, empty rect when not in the atlas
+
+    sf::Vector2u m_shelfPosition; // Position at which the next texture will be placed
+    unsigned int m_shelfHeight;
+
+    // Functions
+    bool grow(unsigned int height);
+
+public:
+    // Constructor
+    explicit TileAtlas(std::size_t idCount);
+
+    // Functions
+    bool add(std::size_t id, const sf::Texture& texture);
+    bool update(std::size_t id, const sf::Image& image);
+    void clear();
+
+    // Getters
+    bool contains(std::size_t id) const { return id < m_textureRects.size() && m_textureRects[id].width != 0; }
+    const sf::IntRect& getTextureRect(std::size_t id) const { return m_textureRects[id]; }
+    const sf::Texture& getTexture() const { return m_texture; }
+};
+
+#endif // TILEATLAS_H
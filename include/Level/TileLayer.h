@@ -0,0 +1,64 @@
+#ifndef TILELAYER_H
+#define TILELAYER_H
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+#include "Level/Tile.h"
+
+// Sparse storage of a Map layer's cells in fixed-size square chunks, allocated only while they contain Tiles
+// Cell lookup is O(1) through a table of chunk pointers, and resizing only rebuilds that table
+// Copies of a layer share its chunks until either writes to them (copy on write), so that a snapshot is cheap to take
+
+class TileLayer final
+{
+public:
+    static constexpr unsigned int chunkSizeLog2 = 5;
+    static constexpr unsigned int chunkSize = 1 << chunkSizeLog2; // Chunks are 32x32 cells
+
+    struct Chunk
+    {
+        std::array<TileCell, chunkSize * chunkSize> cells; // Row-major
+        unsigned int tileCount;
+    };
+
+private:
+    std::vector<std::shared_ptr<Chunk>> m_chunks; // Row-major table of chunks, nullptr where a chunk has no Tiles
+    sf::Vector2u m_dimensions;
+    sf::Vector2u m_chunkCounts;
+    std::size_t m_allocatedChunkCount;
+
+    static const TileCell s_emptyCell;
+
+    // Functions
+    void clearOutsideBounds(Chunk& chunk, const sf::Vector2u& chunkIndex);
+    static Chunk& getWritableChunk(std::shared_ptr<Chunk>& chunk);
+
+public:
+    // Constructor
+    TileLayer();
+
+    // Functions
+    void resize(const sf::Vector2u& dimensions);
+    void clear();
+
+    // Setters
+    void setCell(unsigned int x, unsigned int y, TileCell cell);
+    void setChunk(unsigned int chunkX, unsigned int chunkY, const Chunk& chunk);
+    void setChunk(unsigned int chunkX, unsigned int chunkY, std::unique_ptr<Chunk> chunk);
+
+    // Getters
+    const TileCell& getCell(unsigned int x, unsigned int y) const
+    {
+        const Chunk* chunk = m_chunks[(y >> chunkSizeLog2) * m_chunkCounts.x + (x >> chunkSizeLog2)].get();
+        return chunk != nullptr ? chunk->cells[(y & (chunkSize - 1)) * chunkSize + (x & (chunkSize - 1))] : s_emptyCell;
+    }
+    const Chunk* getChunk(unsigned int chunkX, unsigned int chunkY) const { return m_chunks[chunkY * m_chunkCounts.x + chunkX].get(); }
+    const sf::Vector2u& getDimensions() const { return m_dimensions; }
+    const sf::Vector2u& getChunkCounts() const { return m_chunkCounts; }
+    std::size_t getAllocatedChunkCount() const { return m_allocatedChunkCount; }
+    std::size_t getMemoryUsage() const;
+};
+
+#endif // TILELAYER_H
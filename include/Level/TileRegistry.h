@@ -0,0 +1,59 @@
+#ifndef TILEREGISTRY_H
+#define TILEREGISTRY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Core/ResourceManager.h"
+#include "Level/Tile.h"
+#include "Level/TileAtlas.h"
+
+// Table of the TileDef of each TileType id, loaded from a definition file, and the atlas holding the textures of the TileTypes used
+// Map cells only store TileType ids, and every Tile of a TileType shares its TileDef
+// Animated TileTypes keep their frames in memory and copy the current one over their region of the atlas when it changes, so
+// that all of their Tiles animate without rewriting any vertex, at a cost per tick proportional to the number of animated TileTypes
+
+class TileRegistry final
+{
+private:
+    struct Animation
+    {
+        std::uint16_t id;
+        std::vector<sf::Image> frameImages; // One per TileFrame of the TileType's TileDef
+        std::vector<std::vector<sf::Image>> frameLodImages; // Downsampled frames, the current one's moved to the TileType's images
+        unsigned int duration; // Sum of the frames' durations, in ticks
+        std::size_t currentFrame; // Frame currently in the atlas
+    };
+
+    std::vector<TileDef> m_defs; // Indexed by TileType id
+    TileAtlas m_atlas; // Textures of the TileTypes used, added on first use
+    std::vector<Animation> m_animations; // Animated TileTypes in the atlas
+    std::vector<std::vector<sf::Image>> m_lodImages; // Indexed by TileType id, then level - 1, empty when not in the atlas
+
+    // Functions
+    bool parseDef(const std::string& line, std::uint16_t& id, TileDef& def) const;
+    bool parseFrames(const std::string& frameList, TileDef& def) const;
+    void addAnimation(std::uint16_t id, const ResourceManager& resourceManager);
+    std::vector<sf::Image> buildLodImages(const sf::Image& image) const;
+
+public:
+    // Constructor
+    explicit TileRegistry(std::size_t idCount);
+
+    // Functions
+    bool load(const std::string& filename);
+    bool resolve(std::uint16_t id, const ResourceManager& resourceManager);
+    bool updateAnimations(unsigned int tick);
+    void clearAtlas();
+
+    // Getters
+    static TileCategory getCategory(std::uint16_t id);
+    const TileDef& getDef(std::uint16_t id) const { return m_defs[id < m_defs.size() ? id : 0]; }
+    bool isResolved(std::uint16_t id) const { return m_atlas.contains(id); }
+    std::size_t getAnimationCount() const { return m_animations.size(); }
+    const sf::Image* getLodImage(std::uint16_t id, unsigned int level) const;
+    const sf::Texture& getAtlasTexture() const { return m_atlas.getTexture(); }
+};
+
+#endif // TILEREGISTRY_H
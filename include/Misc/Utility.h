@@ -2,6 +2,8 @@
 #define UTILITY_H
 
 #include <algorithm>
+#include <functional>
+#include <string>
 #include <SFML/Graphics.hpp>
 
 namespace Utility
@@ -24,6 +26,9 @@ namespace Utility
 
     void setSpriteScaleToFill(sf::Sprite& sprite, const sf::Vector2f& fillDimensions);
     void setSpriteScaleToFit(sf::Sprite& sprite, const sf::Vector2f& fitDimensions);
+
+    std::string formatByteCount(std::size_t bytes);
+    void runParallel(std::size_t taskCount, const std::function<void(std::size_t)>& task);
 } // namespace Utility
 
 #endif // UTILITY_H
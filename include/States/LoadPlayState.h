@@ -1,7 +1,6 @@
 #ifndef LOADPLAYSTATE_H
 #define LOADPLAYSTATE_H
 
-#include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include "Gui/Gui.h"
 #include "States/State.h"
@@ -13,7 +12,6 @@ private:
 
     sf::Sprite m_backgroundSprite;
     sf::Text m_loadingText;
-    sf::Sound m_startSound;
     ProgressBar m_loadingBar;
 
     unsigned int m_progress;
@@ -10,8 +10,6 @@
 class PlayState final : public State
 {
 private:
-    sf::RectangleShape m_darkness;
-
     sf::Music m_music;
 
     GuiSpriteButton m_muteButton;
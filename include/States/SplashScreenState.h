@@ -1,7 +1,6 @@
 #ifndef SPLASHSCREENSTATE_H
 #define SPLASHSCREENSTATE_H
 
-#include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include "States/State.h"
 
@@ -10,7 +9,6 @@ class SplashScreenState final : public State
 private:
     sf::Sprite m_splash;
     sf::Sprite m_mask;
-    sf::Sound m_sound;
 
     int m_alpha;
 
@@ -0,0 +1,93 @@
+#include "Core/AudioManager.h"
+#include <algorithm>
+
+AudioManager::AudioManager(std::size_t voiceCount)
+    : m_voices(voiceCount, Voice{sf::Sound(), SoundPriority::Low, 0})
+    , m_playCount(0)
+    , m_stolenCount(0)
+    , m_droppedCount(0)
+    , m_peakActiveVoiceCount(0)
+{
+}
+
+// Return a free voice, or steal the oldest voice with the lowest priority not above the given one
+// Return nullptr if every voice is busy playing a sound of higher priority
+AudioManager::Voice* AudioManager::findVoice(SoundPriority priority)
+{
+    Voice* stealableVoice = nullptr;
+    for (auto& voice : m_voices)
+    {
+        if (voice.sound.getStatus() == sf::Sound::Stopped)
+        {
+            return &voice;
+        }
+
+        if (voice.priority <= priority &&
+            (stealableVoice == nullptr || voice.priority < stealableVoice->priority ||
+             (voice.priority == stealableVoice->priority && voice.playOrder < stealableVoice->playOrder)))
+        {
+            stealableVoice = &voice;
+        }
+    }
+
+    if (stealableVoice != nullptr)
+    {
+        stealableVoice->sound.stop();
+        m_stolenCount++;
+    }
+    return stealableVoice;
+}
+
+// Play a sound on a pooled voice without keeping a handle to it, and return false if no voice was available
+// The sound buffer must outlive the sound, which is stopped by SFML if its buffer is destroyed while playing
+bool AudioManager::play(const sf::SoundBuffer& soundBuffer, float volume, float pitch, SoundPriority priority)
+{
+    Voice* voice = findVoice(priority);
+    if (voice == nullptr)
+    {
+        m_droppedCount++;
+        return false;
+    }
+
+    voice->sound.setBuffer(soundBuffer);
+    voice->sound.setVolume(volume);
+    voice->sound.setPitch(pitch);
+    voice->sound.play();
+    voice->priority = priority;
+    voice->playOrder = m_playCount++;
+
+    m_peakActiveVoiceCount = std::max(m_peakActiveVoiceCount, getActiveVoiceCount());
+    return true;
+}
+
+// Stop every playing voice
+void AudioManager::stopAll()
+{
+    for (auto& voice : m_voices)
+    {
+        voice.sound.stop();
+    }
+}
+
+// Output voice usage statistics
+void AudioManager::printStats(std::ostream& os) const
+{
+    os << "Audio voice report\n"
+       << "    Voices: " << getActiveVoiceCount() << " active / " << m_voices.size() << " (peak " << m_peakActiveVoiceCount << ")\n"
+       << "    Sounds played: " << m_playCount << ", stolen: " << m_stolenCount << ", dropped: " << m_droppedCount << "\n"
+       << std::endl;
+}
+
+// Return the number of voices currently playing or paused
+std::size_t AudioManager::getActiveVoiceCount() const
+{
+    std::size_t activeVoiceCount = 0;
+    for (const auto& voice : m_voices)
+    {
+        if (voice.sound.getStatus() != sf::Sound::Stopped)
+        {
+            activeVoiceCount++;
+        }
+    }
+    return activeVoiceCount;
+}
@@ -1,8 +1,21 @@
 #include "Core/FileManager.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <SFML/System.hpp>
 #if !defined(SFML_SYSTEM_WINDOWS) // MSVC does not support dirent.h
 #include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <direct.h>
+#endif
+#if defined(SFML_SYSTEM_LINUX)
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
 #endif
 #if defined(SFML_SYSTEM_ANDROID)
 #include <SFML/System/NativeActivity.hpp>
@@ -10,6 +23,21 @@
 #include <android/native_activity.h>
 #endif
 
+bool FileManager::fileExists(const std::string& filename)
+{
+#if defined(SFML_SYSTEM_ANDROID)
+    AAsset* file = AAssetManager_open(sf::getNativeActivity()->assetManager, filename.c_str(), AASSET_MODE_UNKNOWN);
+    if (file != nullptr)
+    {
+        AAsset_close(file);
+        return true;
+    }
+    return false;
+#else
+    return std::ifstream(resourcePath() + filename).good();
+#endif
+}
+
 int FileManager::getFileCount(const std::string& directory)
 {
 #if !defined(SFML_SYSTEM_WINDOWS) // MSVC does not support dirent.h
@@ -60,6 +88,91 @@ std::vector<std::string> FileManager::getFilenamesInDirectory(const std::string&
 #endif
 }
 
+// Create a directory (not its parents), returning true if it was created or already exists
+bool FileManager::createDirectory(const std::string& directory)
+{
+    std::string path = resourcePath() + directory;
+#if !defined(SFML_SYSTEM_WINDOWS)
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#else
+    return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#endif
+}
+
+// Remove an empty directory
+bool FileManager::removeDirectory(const std::string& directory)
+{
+    std::string path = resourcePath() + directory;
+#if !defined(SFML_SYSTEM_WINDOWS)
+    return rmdir(path.c_str()) == 0;
+#else
+    return _rmdir(path.c_str()) == 0;
+#endif
+}
+
+// Replace a file by renaming another one over it (atomic where supported)
+// Some systems do not allow renaming over an existing file, in which case it is removed first
+bool FileManager::replaceFile(const std::string& source, const std::string& destination)
+{
+    std::string sourcePath = resourcePath() + source;
+    std::string destinationPath = resourcePath() + destination;
+    if (std::rename(sourcePath.c_str(), destinationPath.c_str()) == 0)
+    {
+        return true;
+    }
+    std::remove(destinationPath.c_str());
+    return std::rename(sourcePath.c_str(), destinationPath.c_str()) == 0;
+}
+
+// Copy a file in blocks, reporting the fraction copied so far to onProgress
+// On Linux the copy is first attempted as a reflink, which shares the source's data until either file is modified and takes
+// constant time on file systems supporting it (such as Btrfs and XFS)
+bool FileManager::copyFile(const std::string& source, const std::string& destination, const std::function<void(float)>& onProgress)
+{
+    std::string sourcePath = resourcePath() + source;
+    std::string destinationPath = resourcePath() + destination;
+#if defined(SFML_SYSTEM_LINUX) && defined(FICLONE)
+    int sourceDescriptor = open(sourcePath.c_str(), O_RDONLY);
+    int destinationDescriptor = open(destinationPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool isCloned = sourceDescriptor >= 0 && destinationDescriptor >= 0 && ioctl(destinationDescriptor, FICLONE, sourceDescriptor) == 0;
+    if (sourceDescriptor >= 0)
+    {
+        close(sourceDescriptor);
+    }
+    if (destinationDescriptor >= 0)
+    {
+        close(destinationDescriptor);
+    }
+    if (isCloned == true)
+    {
+        onProgress(1);
+        return true;
+    }
+#endif
+
+    std::ifstream sourceFile(sourcePath, std::ios::binary | std::ios::ate);
+    std::ofstream destinationFile(destinationPath, std::ios::binary | std::ios::trunc);
+    if (!sourceFile || !destinationFile)
+    {
+        return false;
+    }
+    std::streamoff fileSize = sourceFile.tellg();
+    sourceFile.seekg(0);
+
+    std::vector<char> buffer(1024 * 1024);
+    for (std::streamoff copiedSize = 0; copiedSize < fileSize;)
+    {
+        std::streamsize blockSize = static_cast<std::streamsize>(std::min<std::streamoff>(buffer.size(), fileSize - copiedSize));
+        if (!sourceFile.read(buffer.data(), blockSize) || !destinationFile.write(buffer.data(), blockSize))
+        {
+            return false;
+        }
+        copiedSize += blockSize;
+        onProgress(static_cast<float>(copiedSize) / fileSize);
+    }
+    return static_cast<bool>(destinationFile.flush());
+}
+
 #if defined(SFML_SYSTEM_ANDROID)
 /// Read a given compressed text file from the assets directory on Android
 std::string FileManager::readTxtFromAssets(const std::string& filename)
@@ -20,7 +20,7 @@ namespace
 /// Initialize the window and main systems
 GameEngine::GameEngine()
     : m_isPowerSaverEnabled(true)
-    , m_loopDebugOverlay(resourceManager.getFont("altFont"))
+    , m_loopDebugOverlay(resourceManager.getFont("altFont"), resourceManager, audioManager)
     , inputManager(m_window)
 {
     // Output game info
@@ -429,6 +429,12 @@ double GameEngine::getTargetFps() const
     return 1000000 / static_cast<double>(m_timePerDraw.asMicroseconds());
 }
 
+// Show the Tile counts of the Map drawn in the current frame on the loop debug overlay
+void GameEngine::recordMapDraw(unsigned int drawnTileCount, unsigned int occludedTileCount)
+{
+    m_loopDebugOverlay.recordMapDraw(drawnTileCount, occludedTileCount);
+}
+
 /// Quit game
 void GameEngine::quit()
 {
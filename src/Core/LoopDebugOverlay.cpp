@@ -1,21 +1,32 @@
 #include "Core/LoopDebugOverlay.h"
 #include <string>
+#include "Core/AudioManager.h"
 #include "Core/GameEngine.h"
+#include "Core/ResourceManager.h"
+#include "Misc/Utility.h"
 
 namespace
 {
     const sf::Time samplingTime = sf::milliseconds(250);
 } // namespace
 
-LoopDebugOverlay::LoopDebugOverlay(const sf::Font& font)
+LoopDebugOverlay::LoopDebugOverlay(const sf::Font& font, const ResourceManager& resourceManager, const AudioManager& audioManager)
     : m_upsText("UPS: ", font, 15)
     , m_fpsText("FPS: ", font, 15)
     , m_updateStrainText("UPS Strain: ", font, 15)
     , m_drawStrainText("FPS Strain: ", font, 15)
+    , m_resourceMemoryText("Resources: ", font, 15)
+    , m_audioVoicesText("Voices: ", font, 15)
+    , m_mapTilesText("Map Tiles: ", font, 15)
+    , m_resourceManager(resourceManager)
+    , m_audioManager(audioManager)
     , m_recordedUps(0)
     , m_recordedFps(0)
     , m_updateCounter(0)
     , m_drawCounter(0)
+    , m_mapDrawnTileCount(0)
+    , m_mapOccludedTileCount(0)
+    , m_isMapRecorded(false)
     , m_isVisible(false)
 {
     m_upsText.setFillColor(sf::Color::White);
@@ -34,6 +45,18 @@ LoopDebugOverlay::LoopDebugOverlay(const sf::Font& font)
     m_drawStrainText.setOutlineColor(sf::Color(50, 50, 50));
     m_drawStrainText.setOutlineThickness(1);
 
+    m_resourceMemoryText.setFillColor(sf::Color::White);
+    m_resourceMemoryText.setOutlineColor(sf::Color(50, 50, 50));
+    m_resourceMemoryText.setOutlineThickness(1);
+
+    m_audioVoicesText.setFillColor(sf::Color::White);
+    m_audioVoicesText.setOutlineColor(sf::Color(50, 50, 50));
+    m_audioVoicesText.setOutlineThickness(1);
+
+    m_mapTilesText.setFillColor(sf::Color::White);
+    m_mapTilesText.setOutlineColor(sf::Color(50, 50, 50));
+    m_mapTilesText.setOutlineThickness(1);
+
     onWindowResize();
 }
 
@@ -45,6 +68,9 @@ void LoopDebugOverlay::draw(sf::RenderTarget& target, sf::RenderStates states) c
         target.draw(m_fpsText, states);
         target.draw(m_updateStrainText, states);
         target.draw(m_drawStrainText, states);
+        target.draw(m_resourceMemoryText, states);
+        target.draw(m_audioVoicesText, states);
+        target.draw(m_mapTilesText, states);
     }
 }
 
@@ -87,11 +113,48 @@ void LoopDebugOverlay::recordDraw(sf::Time lastDrawTime)
         tempString.erase(tempString.end() - 3, tempString.end());
         m_drawStrainText.setString("FPS Strain: " + tempString + "%");
 
+        m_resourceMemoryText.setString("Resources: " + Utility::formatByteCount(m_resourceManager.getRamUsage()) + " RAM, " +
+                                       Utility::formatByteCount(m_resourceManager.getVramUsage()) + " VRAM");
+        m_audioVoicesText.setString("Voices: " + std::to_string(m_audioManager.getActiveVoiceCount()) + "/" +
+                                    std::to_string(m_audioManager.getVoiceCount()) + " (peak " +
+                                    std::to_string(m_audioManager.getPeakActiveVoiceCount()) + ")");
+
+        // Overdraw saved by leaving out occluded Background Tiles, as a share of the Tiles which would be drawn without occlusion
+        if (m_isMapRecorded == true)
+        {
+            unsigned int totalTileCount = m_mapDrawnTileCount + m_mapOccludedTileCount;
+            tempString = std::to_string(totalTileCount > 0 ? 100.0 * m_mapOccludedTileCount / totalTileCount : 0.0);
+            tempString.erase(tempString.end() - 5, tempString.end());
+            m_mapTilesText.setString("Map Tiles: " + std::to_string(m_mapDrawnTileCount) + " drawn, " +
+                                     std::to_string(m_mapOccludedTileCount) + " occluded (" + tempString + "% saved)");
+        }
+        else
+        {
+            m_mapTilesText.setString("Map Tiles: -");
+        }
+        m_isMapRecorded = false;
+
+        // Report any glyph the font prewarm list missed
+        m_resourceManager.checkGlyphCache(m_upsText);
+        m_resourceManager.checkGlyphCache(m_updateStrainText);
+        m_resourceManager.checkGlyphCache(m_fpsText);
+        m_resourceManager.checkGlyphCache(m_drawStrainText);
+        m_resourceManager.checkGlyphCache(m_resourceMemoryText);
+        m_resourceManager.checkGlyphCache(m_audioVoicesText);
+        m_resourceManager.checkGlyphCache(m_mapTilesText);
+
         m_sampledDrawTime = sf::Time::Zero;
         m_drawCounter = 0;
     }
 }
 
+void LoopDebugOverlay::recordMapDraw(unsigned int drawnTileCount, unsigned int occludedTileCount)
+{
+    m_mapDrawnTileCount = drawnTileCount;
+    m_mapOccludedTileCount = occludedTileCount;
+    m_isMapRecorded = true;
+}
+
 void LoopDebugOverlay::onWindowResize()
 {
     m_upsText.setPosition(5, 5);
@@ -102,4 +165,13 @@ void LoopDebugOverlay::onWindowResize()
                               m_updateStrainText.getFont()->getLineSpacing(m_updateStrainText.getCharacterSize()));
     m_drawStrainText.setPosition(m_fpsText.getPosition().x,
                                  m_fpsText.getGlobalBounds().top + m_fpsText.getFont()->getLineSpacing(m_fpsText.getCharacterSize()));
+    m_resourceMemoryText.setPosition(m_drawStrainText.getPosition().x,
+                                     m_drawStrainText.getGlobalBounds().top +
+                                         m_drawStrainText.getFont()->getLineSpacing(m_drawStrainText.getCharacterSize()));
+    m_audioVoicesText.setPosition(m_resourceMemoryText.getPosition().x,
+                                  m_resourceMemoryText.getGlobalBounds().top +
+                                      m_resourceMemoryText.getFont()->getLineSpacing(m_resourceMemoryText.getCharacterSize()));
+    m_mapTilesText.setPosition(m_audioVoicesText.getPosition().x,
+                               m_audioVoicesText.getGlobalBounds().top +
+                                   m_audioVoicesText.getFont()->getLineSpacing(m_audioVoicesText.getCharacterSize()));
 }
@@ -0,0 +1,129 @@
+#include "Core/MemoryMappedFile.h"
+#include <iostream>
+#include "Core/FileManager.h"
+#if defined(SFML_SYSTEM_WINDOWS)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(SFML_SYSTEM_ANDROID)
+#include <SFML/System/NativeActivity.hpp>
+#include <android/asset_manager.h>
+#include <android/native_activity.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MemoryMappedFile::MemoryMappedFile()
+    : m_data(nullptr)
+    , m_size(0)
+#if defined(SFML_SYSTEM_WINDOWS)
+    , m_fileHandle(nullptr)
+    , m_mappingHandle(nullptr)
+#elif defined(SFML_SYSTEM_ANDROID)
+    , m_asset(nullptr)
+#endif
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+// Map a whole file into memory, returning false if it cannot be opened or is empty
+bool MemoryMappedFile::open(const std::string& filename)
+{
+    close();
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    HANDLE file = CreateFileA((FileManager::resourcePath() + filename).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER fileSize;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &fileSize) != 0 && fileSize.QuadPart > 0 &&
+            (mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) != nullptr)
+        {
+            m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if (m_data != nullptr)
+            {
+                m_size = static_cast<std::size_t>(fileSize.QuadPart);
+                m_fileHandle = file;
+                m_mappingHandle = mapping;
+                return true;
+            }
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+    }
+#elif defined(SFML_SYSTEM_ANDROID)
+    AAssetManager* assetManager = sf::getNativeActivity()->assetManager;
+    m_asset = AAssetManager_open(assetManager, filename.c_str(), AASSET_MODE_BUFFER);
+    if (m_asset != nullptr)
+    {
+        m_data = static_cast<const char*>(AAsset_getBuffer(m_asset));
+        m_size = AAsset_getLength(m_asset);
+        if (m_data != nullptr && m_size > 0)
+        {
+            return true;
+        }
+        close();
+    }
+#else
+    int file = ::open((FileManager::resourcePath() + filename).c_str(), O_RDONLY);
+    if (file != -1)
+    {
+        struct stat fileStatus;
+        if (fstat(file, &fileStatus) == 0 && fileStatus.st_size > 0)
+        {
+            void* data = mmap(nullptr, static_cast<std::size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            if (data != MAP_FAILED)
+            {
+                m_data = static_cast<const char*>(data);
+                m_size = static_cast<std::size_t>(fileStatus.st_size);
+            }
+        }
+        ::close(file); // The mapping stays valid after the file is closed
+        if (m_data != nullptr)
+        {
+            return true;
+        }
+    }
+#endif
+
+    std::cerr << "MemoryMappedFile error: Unable to map \"" << filename << "\".\n";
+    return false;
+}
+
+// Unmap the file, if one is open
+void MemoryMappedFile::close()
+{
+#if defined(SFML_SYSTEM_WINDOWS)
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mappingHandle);
+        CloseHandle(m_fileHandle);
+    }
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+#elif defined(SFML_SYSTEM_ANDROID)
+    if (m_asset != nullptr)
+    {
+        AAsset_close(m_asset);
+    }
+    m_asset = nullptr;
+#else
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
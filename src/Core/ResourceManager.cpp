@@ -1,13 +1,181 @@
 #include "Core/ResourceManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include "Core/FileManager.h"
+#include "Misc/Utility.h"
+
+namespace
+{
+    // Textures larger than this (4096x1024 RGBA) trigger a warning when loaded, unless changed with setTextureSizeWarningThreshold()
+    const std::size_t defaultTextureSizeWarningThreshold = 4096 * 1024 * 4;
+
+    // Default limit on the estimated memory used by loaded and prefetched resources, which prefetching will not exceed
+    const std::size_t defaultMemoryBudget = 512 * 1024 * 1024;
+
+    // Rate at which the prefetch thread reads files when throttled, to leave disk bandwidth to the running game
+    const std::size_t prefetchThrottledBytesPerSecond = 4 * 1024 * 1024;
+    const std::chrono::milliseconds prefetchThrottledItemPause(5);
+
+    const char* const resourceTypeNames[] = {"Texture", "Font", "SoundBuffer", "Shader"};
+
+    // Largest character size accepted in font prewarm lists
+    const unsigned int maxPrewarmCharacterSize = 1024;
+
+    // Pack the parameters identifying a glyph in a font's cache into a single key
+    // The outline thickness is kept in 1/16ths of a pixel and clamped to the 15 bits left, negative thicknesses counting as 0
+    std::uint64_t getGlyphKey(sf::Uint32 codePoint, unsigned int characterSize, bool isBold, float outlineThickness)
+    {
+        float outlineSixteenths = std::min(std::max(0.f, outlineThickness * 16), static_cast<float>(0x7FFF));
+        return static_cast<std::uint64_t>(codePoint) | (static_cast<std::uint64_t>(characterSize & 0xFFFF) << 32) |
+               (static_cast<std::uint64_t>(isBold) << 48) | (static_cast<std::uint64_t>(outlineSixteenths) << 49);
+    }
+
+    // Return the characters of a named character set used in font prewarm lists, or an empty string if the name is unknown
+    sf::String getNamedCharacterSet(const std::string& name)
+    {
+        sf::String characters;
+        if (name == "ascii")
+        {
+            for (sf::Uint32 codePoint = 0x20; codePoint <= 0x7E; codePoint++)
+            {
+                characters += codePoint;
+            }
+        }
+        else if (name == "latin1")
+        {
+            for (sf::Uint32 codePoint = 0xA0; codePoint <= 0xFF; codePoint++)
+            {
+                characters += codePoint;
+            }
+        }
+        else if (name == "digits")
+        {
+            characters = "0123456789.,-+:%";
+        }
+        return characters;
+    }
+
+    // Return the size of a resource file in bytes, or 0 if it cannot be opened
+    std::size_t getFileSize(const std::string& filename)
+    {
+#if defined(SFML_SYSTEM_ANDROID)
+        return FileManager::readTxtFromAssets(filename).size();
+#else
+        std::ifstream file(FileManager::resourcePath() + filename, std::ios::binary | std::ios::ate);
+        if (file)
+        {
+            return static_cast<std::size_t>(file.tellg());
+        }
+        return 0;
+#endif
+    }
+
+    // Return the number of bytes used by an image of the given size, at 4 bytes per pixel
+    std::size_t getImageByteCount(const sf::Vector2u& size)
+    {
+        return static_cast<std::size_t>(size.x) * size.y * 4;
+    }
+
+    // Return the unsigned integer stored in the given number of bytes, most significant first or last
+    std::uint32_t readBigEndian(const unsigned char* bytes, std::size_t count)
+    {
+        std::uint32_t value = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            value = (value << 8) | bytes[i];
+        }
+        return value;
+    }
+
+    std::uint32_t readLittleEndian(const unsigned char* bytes, std::size_t count)
+    {
+        std::uint32_t value = 0;
+        for (std::size_t i = count; i > 0; i--)
+        {
+            value = (value << 8) | bytes[i - 1];
+        }
+        return value;
+    }
+
+    // Read the size of an image from the header of its resource file without decoding it
+    // Return false if the file cannot be read or is not a PNG, JPEG, BMP or GIF image
+    bool readImageSize(const std::string& filename, sf::Vector2u& size)
+    {
+        sf::FileInputStream file;
+        unsigned char header[26];
+        if (file.open(FileManager::resourcePath() + filename) == false || file.read(header, sizeof(header)) != sizeof(header))
+        {
+            return false;
+        }
+
+        if (std::memcmp(header, "\x89PNG\r\n\x1a\n", 8) == 0 && std::memcmp(header + 12, "IHDR", 4) == 0)
+        {
+            size = sf::Vector2u(readBigEndian(header + 16, 4), readBigEndian(header + 20, 4));
+        }
+        else if (std::memcmp(header, "GIF8", 4) == 0)
+        {
+            size = sf::Vector2u(readLittleEndian(header + 6, 2), readLittleEndian(header + 8, 2));
+        }
+        else if (std::memcmp(header, "BM", 2) == 0 && readLittleEndian(header + 14, 4) >= 40)
+        {
+            // The height is negative for images stored top to bottom
+            auto height = static_cast<std::int32_t>(readLittleEndian(header + 22, 4));
+            size = sf::Vector2u(readLittleEndian(header + 18, 4), static_cast<unsigned int>(height < 0 ? -height : height));
+        }
+        else if (header[0] == 0xFF && header[1] == 0xD8)
+        {
+            // Walk the JPEG segments up to the start of frame, which holds the size
+            sf::Int64 position = 2;
+            unsigned char segment[9];
+            while (file.seek(position) == position && file.read(segment, 4) == 4 && segment[0] == 0xFF)
+            {
+                bool isStartOfFrame = segment[1] >= 0xC0 && segment[1] <= 0xCF && segment[1] != 0xC4 && segment[1] != 0xC8 &&
+                                      segment[1] != 0xCC;
+                if (isStartOfFrame == true)
+                {
+                    if (file.read(segment + 4, 5) != 5)
+                    {
+                        return false;
+                    }
+                    size = sf::Vector2u(readBigEndian(segment + 7, 2), readBigEndian(segment + 5, 2));
+                    break;
+                }
+                position += 2 + readBigEndian(segment + 2, 2);
+            }
+        }
+
+        return size.x != 0 && size.y != 0;
+    }
+
+    // Return the contents of a text resource file, or an empty string if it cannot be opened
+    std::string readFile(const std::string& filename)
+    {
+#if defined(SFML_SYSTEM_ANDROID)
+        return FileManager::readTxtFromAssets(filename);
+#else
+        std::ifstream file(FileManager::resourcePath() + filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+#endif
+    }
+} // namespace
 
 // Create defaults to use when an unloaded resource is referenced,
 // and load resources loaded for the entire duration of the program
 ResourceManager::ResourceManager()
+    : m_memoryUsage()
+    , m_textureSizeWarningThreshold(defaultTextureSizeWarningThreshold)
+    , m_glyphCacheMissCount(0)
+    , m_prefetchedBytes(0)
+    , m_isPrefetchCancelled(false)
+    , m_isPrefetchThrottled(true)
+    , m_isPrefetchComplete(false)
+    , m_memoryBudget(defaultMemoryBudget)
 {
     // The sf::Context below is unused but its existence is necessary to make OpenGL calls without having
     // an active window, which is the case here when loading textures before the window has been created
@@ -18,100 +186,628 @@ ResourceManager::ResourceManager()
     loadSoundBuffer("error", "res/sounds/error.ogg");
     m_shaders["defaultShader"];
 
+    loadManifest("data/resource_manifest.txt");
     loadInitialResources();
+    loadFontPrewarmList("data/font_prewarm.txt");
 }
 
 ResourceManager::~ResourceManager()
 {
+    stopPrefetching();
 }
 
 // Load resources loaded on startup
 bool ResourceManager::loadInitialResources()
 {
     static const std::string initialResourcesFilename = "data/initial_resources.txt";
+
+    std::vector<std::string> names;
+    if (m_manifest.load(initialResourcesFilename, &names))
+    {
+        for (const auto& name : names)
+        {
+            loadResource(name);
+        }
+
+        std::cout << "Initial resources successfully loaded.\n\n";
+        return true;
+    }
+
+    std::cerr << "ResourceManager error: Unable to open \"" << initialResourcesFilename << "\".\n"
+              << "Initial resources loading failed.\n\n";
+    return false;
+}
+
+// Rasterize the glyphs listed in a font prewarm file so that text drawn later does not stall on glyph rendering
+// Lines have the format: fontName size[,size...] [outline:thickness] charset... where each charset is either a named set
+// (ascii, latin1, or digits) or a quoted string of characters. Invalid lines are reported and skipped
+bool ResourceManager::loadFontPrewarmList(const std::string& filename)
+{
 #if defined(SFML_SYSTEM_ANDROID)
-    std::istringstream inputFile(FileManager::readTxtFromAssets(initialResourcesFilename));
+    std::istringstream inputFile(FileManager::readTxtFromAssets(filename));
 #else
-    std::ifstream inputFile(FileManager::resourcePath() + initialResourcesFilename);
+    std::ifstream inputFile(FileManager::resourcePath() + filename);
 #endif
 
-    if (inputFile)
+    if (!inputFile)
+    {
+        std::cerr << "ResourceManager error: Unable to open \"" << filename << "\".\n"
+                  << "Font prewarming failed.\n\n";
+        return false;
+    }
+
+    bool isListValid = true;
+    std::string line;
+    while (std::getline(inputFile, line))
     {
-        std::string line;
-        while (std::getline(inputFile, line))
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+
+        // Ignore empty lines or those starting with '#'
+        if (line.empty() || line.front() == '#')
         {
-            // Ignore empty lines or those starting with '#'
-            if (line.empty() || line.front() == '#')
+            continue;
+        }
+
+        // Read font name and comma-separated character sizes
+        std::istringstream lineStream(line);
+        std::string name;
+        std::string sizesString;
+        lineStream >> name >> sizesString;
+        std::vector<unsigned int> characterSizes;
+        std::istringstream sizesStream(sizesString);
+        std::string sizeString;
+        bool isLineValid = sizesString.empty() == false;
+        while (isLineValid == true && std::getline(sizesStream, sizeString, ','))
+        {
+            std::istringstream sizeStream(sizeString);
+            int characterSize = 0;
+            isLineValid = (sizeStream >> characterSize) && sizeStream.eof() == true && characterSize > 0 &&
+                          characterSize <= static_cast<int>(maxPrewarmCharacterSize);
+            characterSizes.push_back(static_cast<unsigned int>(characterSize));
+        }
+
+        // Read options and character sets
+        float outlineThickness = 0;
+        sf::String characters;
+        std::string remainder;
+        std::getline(lineStream, remainder);
+        std::size_t pos = remainder.find_first_not_of(' ');
+        while (isLineValid == true && pos != std::string::npos)
+        {
+            if (remainder[pos] == '"')
             {
-                continue;
+                std::size_t endPos = remainder.find('"', pos + 1);
+                characters += sf::String::fromUtf8(remainder.begin() + static_cast<std::ptrdiff_t>(pos) + 1,
+                                                   remainder.begin() + static_cast<std::ptrdiff_t>(std::min(endPos, remainder.size())));
+                pos = endPos == std::string::npos ? endPos : endPos + 1;
             }
+            else
+            {
+                std::size_t endPos = remainder.find(' ', pos);
+                std::string token = remainder.substr(pos, endPos - pos);
+                if (token.compare(0, 8, "outline:") == 0)
+                {
+                    std::istringstream thicknessStream(token.substr(8));
+                    isLineValid = (thicknessStream >> outlineThickness) && thicknessStream.eof() == true && outlineThickness >= 0;
+                }
+                else if (getNamedCharacterSet(token).isEmpty())
+                {
+                    std::cerr << "ResourceManager warning: Ignoring unknown character set \"" << token << "\" in file: \"" << filename
+                              << "\".\n";
+                }
+                else
+                {
+                    characters += getNamedCharacterSet(token);
+                }
+                pos = endPos;
+            }
+            pos = pos == std::string::npos ? pos : remainder.find_first_not_of(' ', pos);
+        }
+
+        if (isLineValid == false)
+        {
+            std::cerr << "ResourceManager error: Invalid font prewarm line \"" << line << "\" in file: \"" << filename << "\".\n";
+            isListValid = false;
+            continue;
+        }
+        prewarmFont(name, characters, characterSizes, outlineThickness);
+    }
+
+    return isListValid;
+}
+
+// Record the estimated number of bytes used by a newly loaded resource
+void ResourceManager::recordMemoryUsage(ResourceType type, const std::string& name, std::size_t bytes)
+{
+    std::size_t typeIndex = static_cast<std::size_t>(type);
+    std::lock_guard<std::mutex> lock(m_memoryUsageMutex);
+    m_resourceBytes[typeIndex][name] = bytes;
+    m_memoryUsage[typeIndex] += bytes;
+}
+
+// Remove an unloaded resource from the memory accounting
+void ResourceManager::eraseMemoryUsage(ResourceType type, const std::string& name)
+{
+    std::size_t typeIndex = static_cast<std::size_t>(type);
+    std::lock_guard<std::mutex> lock(m_memoryUsageMutex);
+    auto it = m_resourceBytes[typeIndex].find(name);
+    if (it != m_resourceBytes[typeIndex].cend())
+    {
+        m_memoryUsage[typeIndex] -= it->second;
+        m_resourceBytes[typeIndex].erase(it);
+    }
+}
 
-            // Read resource name
-            std::string name = line.substr(0, line.find(' '));
+// Manifest functions
 
-            // Read quoted filename
-            std::size_t firstDelimPos = line.find('"', name.size() + 1);
-            std::size_t lastDelimPos = line.find('"', firstDelimPos + 1);
-            std::string filename = line.substr(firstDelimPos + 1, lastDelimPos - (firstDelimPos + 1));
+// Parse a manifest file and add its resource declarations to the manifest, optionally outputting the names it lists
+bool ResourceManager::loadManifest(const std::string& filename, std::vector<std::string>* names)
+{
+    return m_manifest.load(filename, names);
+}
 
-            // Load resource
-            if (filename.find("images") != std::string::npos)
+// Load a resource declared in the manifest, dispatching on its type, and return false if it was never declared
+bool ResourceManager::loadResource(const std::string& name)
+{
+    const ResourceManifestEntry* entry = m_manifest.getEntry(name);
+    if (entry == nullptr)
+    {
+        std::cerr << "ResourceManager error: Unknown resource \"" << name << "\" (not declared in the resource manifest).\n";
+        return false;
+    }
+
+    // Use prefetched data if available, in which case the load functions below find the resource already loaded
+    loadPrefetchedResource(name, *entry);
+
+    switch (entry->type)
+    {
+    case ResourceType::Texture:
+        loadTexture(name, entry->filename, entry->textureRect);
+        if (entry->isRepeated == true)
+        {
+            setTextureRepeated(name, true);
+        }
+        if (entry->isSmooth == true)
+        {
+            setTextureSmooth(name, true);
+        }
+        break;
+    case ResourceType::Font:
+        loadFont(name, entry->filename);
+        break;
+    case ResourceType::SoundBuffer:
+        loadSoundBuffer(name, entry->filename);
+        break;
+    case ResourceType::Shader:
+        loadShader(name, entry->filename, entry->shaderType);
+        break;
+    }
+
+    return true;
+}
+
+// Record the video memory used by a newly loaded texture, warning if it exceeds the size threshold
+void ResourceManager::recordTextureMemoryUsage(const std::string& name, const sf::Texture& texture)
+{
+    // Textures are stored in video memory as 4 bytes per pixel
+    std::size_t bytes = static_cast<std::size_t>(texture.getSize().x) * texture.getSize().y * 4;
+    recordMemoryUsage(ResourceType::Texture, name, bytes);
+    if (bytes > m_textureSizeWarningThreshold)
+    {
+        std::cerr << "ResourceManager warning: Texture \"" << name << "\" (" << texture.getSize().x << "x" << texture.getSize().y
+                  << ") uses " << Utility::formatByteCount(bytes) << ", exceeding the "
+                  << Utility::formatByteCount(m_textureSizeWarningThreshold) << " threshold.\n";
+    }
+}
+
+// Decode resources on the prefetch thread, keeping them until loaded, without exceeding the given number of bytes
+// Sizes are checked before decoding, and the images shared by several textures count against the budget while decoded
+// Throttled by default to leave disk bandwidth and CPU time to the running game
+void ResourceManager::prefetchWorker(std::vector<std::pair<std::string, ResourceManifestEntry>> entries, std::size_t budget)
+{
+    // Sort by file so that the textures cropped from the same image follow each other, to decode it once and free it after the last
+    std::stable_sort(entries.begin(),
+                     entries.end(),
+                     [](const std::pair<std::string, ResourceManifestEntry>& entry,
+                        const std::pair<std::string, ResourceManifestEntry>& otherEntry) {
+                         return entry.second.filename < otherEntry.second.filename;
+                     });
+
+    sf::Image image; // Image shared by several textures with different rects
+    std::string imageFilename;
+    std::size_t usedBytes = 0;
+    auto releaseImage = [&]() {
+        usedBytes -= getImageByteCount(image.getSize());
+        image = sf::Image();
+        imageFilename.clear();
+    };
+
+    // Resources which would exceed the memory budget are skipped, and then loaded normally
+    // Nothing is output from this thread, so that its messages do not interleave with those of the main thread
+    auto skipResource = [this](const std::string& name) {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        m_prefetchSkippedNames.push_back(name);
+    };
+
+    for (std::size_t i = 0; i < entries.size(); i++)
+    {
+        if (m_isPrefetchCancelled == true)
+        {
+            return;
+        }
+
+        const std::string& name = entries[i].first;
+        const ResourceManifestEntry& entry = entries[i].second;
+        if (imageFilename.empty() == false && imageFilename != entry.filename)
+        {
+            releaseImage(); // The last textures of the previous image were skipped
+        }
+
+        PrefetchedResource resource{sf::Image(), {}, 0, 0, "", 0};
+        std::size_t readBytes = 0;
+        switch (entry.type)
+        {
+        case ResourceType::Texture:
+        {
+            bool isImageDecoded = imageFilename == entry.filename;
+            bool isLastOfImage = i + 1 == entries.size() || entries[i + 1].second.type != ResourceType::Texture ||
+                                 entries[i + 1].second.filename != entry.filename;
+            bool isWholeImage = entry.textureRect.width == 0 || entry.textureRect.height == 0;
+
+            // The only texture of an image which uses all of it is decoded directly, the others are cropped from the shared image
+            bool isDecodedDirectly = isImageDecoded == false && isLastOfImage == true && isWholeImage == true;
+            sf::Image& decodedImage = isDecodedDirectly == true ? resource.image : image;
+            auto decodeImage = [&]() {
+                if (!decodedImage.loadFromFile(FileManager::resourcePath() + entry.filename))
+                {
+                    return false;
+                }
+                readBytes = getFileSize(entry.filename);
+                if (isDecodedDirectly == false)
+                {
+                    imageFilename = entry.filename;
+                    usedBytes += getImageByteCount(image.getSize());
+                }
+                return true;
+            };
+
+            // Images whose size cannot be read from their header are decoded first, then checked against the budget
+            sf::Vector2u imageSize = image.getSize();
+            if (isImageDecoded == false && readImageSize(entry.filename, imageSize) == false)
             {
-                loadTexture(name, filename);
+                if (decodeImage() == false)
+                {
+                    continue;
+                }
+                imageSize = decodedImage.getSize();
+                isImageDecoded = true;
             }
-            else if (filename.find("fonts") != std::string::npos)
+
+            sf::Vector2u textureSize = isWholeImage == true ? imageSize
+                                                            : sf::Vector2u(static_cast<unsigned int>(entry.textureRect.width),
+                                                                           static_cast<unsigned int>(entry.textureRect.height));
+            std::size_t neededBytes = getImageByteCount(textureSize);
+            if (isDecodedDirectly == false && isImageDecoded == false)
             {
-                loadFont(name, filename);
+                neededBytes += getImageByteCount(imageSize);
             }
-            else if (filename.find("sounds") != std::string::npos)
+            if (usedBytes + neededBytes > budget)
             {
-                loadSoundBuffer(name, filename);
+                skipResource(name);
+                continue;
             }
-            else if (filename.find("shaders") != std::string::npos)
+            if (isImageDecoded == false && decodeImage() == false)
             {
-                // Parse extension from filename
-                std::size_t lastPeriodPos = filename.rfind('.');
-                std::string extension;
-                if (lastPeriodPos != std::string::npos)
-                {
-                    extension = filename.substr(lastPeriodPos + 1);
-                }
+                continue;
+            }
 
-                // Deduce shader type from extension
-                if (extension == "vert")
-                {
-                    loadShader(name, filename, sf::Shader::Vertex);
-                }
-                else if (extension == "geom")
+            // Crop the image to the texture rect like sf::Texture::loadFromFile() would, treating an empty rect as the whole image
+            if (isDecodedDirectly == false)
+            {
+                if (isWholeImage == true)
                 {
-                    loadShader(name, filename, sf::Shader::Geometry);
+                    resource.image = image;
                 }
-                else if (extension == "frag")
+                else
                 {
-                    loadShader(name, filename, sf::Shader::Fragment);
+                    resource.image.create(textureSize.x, textureSize.y);
+                    resource.image.copy(image, 0, 0, entry.textureRect);
                 }
-                else
+                if (isLastOfImage == true)
                 {
-                    std::cerr << "ResourceManager error: Unable to deduce shader type for filename \"" << filename
-                              << "\" from unknown extension \"" << extension << "\" (extension should be .vert, .geom or .frag)\n";
+                    releaseImage();
                 }
             }
-            else
+            resource.bytes = getImageByteCount(resource.image.getSize());
+            break;
+        }
+        case ResourceType::SoundBuffer:
+        {
+            // Opening the file only reads its header, which gives the size of the samples before decoding them
+            sf::InputSoundFile file;
+            if (!file.openFromFile(FileManager::resourcePath() + entry.filename))
+            {
+                continue;
+            }
+            if (usedBytes + static_cast<std::size_t>(file.getSampleCount()) * sizeof(sf::Int16) > budget)
             {
-                std::cerr << "ResourceManager error: Unable to deduce resource type for \"" << name << "\" from filename \"" << filename
-                          << "\"\n";
+                skipResource(name);
+                continue;
+            }
+            resource.samples.resize(static_cast<std::size_t>(file.getSampleCount()));
+            resource.samples.resize(static_cast<std::size_t>(file.read(resource.samples.data(), file.getSampleCount())));
+            resource.channelCount = file.getChannelCount();
+            resource.sampleRate = file.getSampleRate();
+            resource.bytes = resource.samples.size() * sizeof(sf::Int16);
+            readBytes = getFileSize(entry.filename);
+            break;
+        }
+        case ResourceType::Shader:
+            if (usedBytes + getFileSize(entry.filename) > budget)
+            {
+                skipResource(name);
+                continue;
             }
+            resource.source = readFile(entry.filename);
+            resource.bytes = resource.source.size();
+            readBytes = resource.bytes;
+            break;
+        case ResourceType::Font:
+            // Fonts are streamed from their file by FreeType, so there is nothing to decode ahead of time
+            continue;
         }
+        usedBytes += resource.bytes;
 
-        std::cout << "Initial resources successfully loaded.\n\n";
+        {
+            std::lock_guard<std::mutex> lock(m_prefetchMutex);
+            m_prefetchedBytes += resource.bytes;
+            m_prefetchedResources.emplace(name, std::move(resource));
+        }
+
+        // Throttle reads, in short sleeps to react quickly when the prefetch must finish or stop
+        auto throttleEnd = std::chrono::steady_clock::now() + prefetchThrottledItemPause +
+                           std::chrono::milliseconds(readBytes * 1000 / prefetchThrottledBytesPerSecond);
+        while (m_isPrefetchThrottled == true && m_isPrefetchCancelled == false && std::chrono::steady_clock::now() < throttleEnd)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+    m_isPrefetchComplete = true;
+}
+
+// Create a resource from its prefetched data, if it was prefetched and is not loaded yet, and return whether it was
+bool ResourceManager::loadPrefetchedResource(const std::string& name, const ResourceManifestEntry& entry)
+{
+    PrefetchedResource resource;
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        auto it = m_prefetchedResources.find(name);
+        if (it == m_prefetchedResources.end())
+        {
+            return false;
+        }
+        resource = std::move(it->second);
+        m_prefetchedBytes -= resource.bytes;
+        m_prefetchedResources.erase(it);
+    }
+
+    switch (entry.type)
+    {
+    case ResourceType::Texture:
+    {
+        sf::Texture texture;
+        if (m_textures.find(name) != m_textures.cend() || !texture.loadFromImage(resource.image))
+        {
+            return false;
+        }
+        auto it = m_textures.emplace(name, std::move(texture)).first;
+        recordTextureMemoryUsage(name, it->second);
         return true;
     }
+    case ResourceType::SoundBuffer:
+    {
+        sf::SoundBuffer soundBuffer;
+        if (m_soundBuffers.find(name) != m_soundBuffers.cend() ||
+            !soundBuffer.loadFromSamples(resource.samples.data(), resource.samples.size(), resource.channelCount, resource.sampleRate))
+        {
+            return false;
+        }
+        m_soundBuffers.emplace(name, std::move(soundBuffer));
+        recordMemoryUsage(ResourceType::SoundBuffer, name, resource.bytes);
+        return true;
+    }
+    case ResourceType::Shader:
+    {
+        if (m_shaders.find(name) != m_shaders.cend())
+        {
+            return false;
+        }
+        if (!m_shaders[name].loadFromMemory(resource.source, entry.shaderType))
+        {
+            m_shaders.erase(name);
+            return false;
+        }
+        recordMemoryUsage(ResourceType::Shader, name, resource.bytes);
+        return true;
+    }
+    case ResourceType::Font:
+        break;
+    }
 
-    std::cerr << "ResourceManager error: Unable to open \"" << initialResourcesFilename << "\".\n"
-              << "Initial resources loading failed.\n\n";
     return false;
 }
 
+// Memory accounting functions
+
+// Return the estimated system memory used by fonts, sound buffers, and shader sources
+std::size_t ResourceManager::getRamUsage() const
+{
+    return getMemoryUsage(ResourceType::Font) + getMemoryUsage(ResourceType::SoundBuffer) + getMemoryUsage(ResourceType::Shader);
+}
+
+// Return the largest loaded resources of all types, sorted by decreasing size
+std::vector<ResourceMemoryRecord> ResourceManager::getLargestResources(std::size_t count) const
+{
+    std::vector<ResourceMemoryRecord> records;
+    std::unique_lock<std::mutex> lock(m_memoryUsageMutex);
+    for (std::size_t typeIndex = 0; typeIndex < m_resourceBytes.size(); typeIndex++)
+    {
+        for (const auto& resource : m_resourceBytes[typeIndex])
+        {
+            records.push_back({resource.first, static_cast<ResourceType>(typeIndex), resource.second});
+        }
+    }
+    lock.unlock();
+
+    count = std::min(count, records.size());
+    std::partial_sort(records.begin(), records.begin() + count, records.end(),
+                      [](const ResourceMemoryRecord& a, const ResourceMemoryRecord& b) {
+                          return a.bytes > b.bytes || (a.bytes == b.bytes && a.name < b.name);
+                      });
+    records.resize(count);
+    return records;
+}
+
+// Output the memory used per resource type and the largest loaded resources
+void ResourceManager::printMemoryReport(std::ostream& os, std::size_t count) const
+{
+    os << "Resource memory report\n";
+    {
+        std::lock_guard<std::mutex> lock(m_memoryUsageMutex);
+        for (std::size_t typeIndex = 0; typeIndex < m_resourceBytes.size(); typeIndex++)
+        {
+            os << "    " << std::left << std::setw(12) << resourceTypeNames[typeIndex] << std::right << std::setw(12)
+               << Utility::formatByteCount(m_memoryUsage[typeIndex]) << " (" << m_resourceBytes[typeIndex].size() << " loaded)\n";
+        }
+    }
+    os << "    RAM: " << Utility::formatByteCount(getRamUsage()) << ", VRAM: " << Utility::formatByteCount(getVramUsage()) << "\n";
+    os << "    Prefetched: " << Utility::formatByteCount(getPrefetchedBytes()) << ", budget: " << Utility::formatByteCount(m_memoryBudget)
+       << "\n";
+    os << "    Glyph cache misses: " << m_glyphCacheMissCount << "\n";
+
+    os << "Largest resources:\n";
+    for (const auto& record : getLargestResources(count))
+    {
+        os << "    " << std::right << std::setw(12) << Utility::formatByteCount(record.bytes) << "  "
+           << resourceTypeNames[static_cast<std::size_t>(record.type)] << " \"" << record.name << "\"\n";
+    }
+    os << std::endl;
+}
+
+// Prefetch functions
+
+// Start decoding resources declared in the manifest on a background thread, to later load them instantly with loadResource()
+// Replaces any previous prefetch, keeping the already decoded resources which are still requested
+void ResourceManager::prefetchResources(const std::vector<std::string>& names)
+{
+    stopPrefetching();
+    m_isPrefetchComplete = false;
+
+    std::unordered_set<std::string> requestedNames(names.cbegin(), names.cend());
+    std::size_t prefetchedBytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        m_prefetchSkippedNames.clear();
+        for (auto it = m_prefetchedResources.begin(); it != m_prefetchedResources.end();)
+        {
+            if (requestedNames.count(it->first) == 0)
+            {
+                m_prefetchedBytes -= it->second.bytes;
+                it = m_prefetchedResources.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        prefetchedBytes = m_prefetchedBytes;
+    }
+
+    // Only prefetch declared resources which are neither loaded nor prefetched yet
+    std::vector<std::pair<std::string, ResourceManifestEntry>> entries;
+    for (const auto& name : names)
+    {
+        const ResourceManifestEntry* entry = m_manifest.getEntry(name);
+        if (entry == nullptr || m_prefetchedResources.count(name) != 0 ||
+            (entry->type == ResourceType::Texture && m_textures.count(name) != 0) ||
+            (entry->type == ResourceType::SoundBuffer && m_soundBuffers.count(name) != 0) ||
+            (entry->type == ResourceType::Shader && m_shaders.count(name) != 0))
+        {
+            continue;
+        }
+        entries.emplace_back(name, *entry);
+    }
+
+    std::size_t usedBytes = getRamUsage() + getVramUsage() + prefetchedBytes;
+    std::size_t budget = m_memoryBudget > usedBytes ? m_memoryBudget - usedBytes : 0;
+    if (entries.empty() || budget == 0)
+    {
+        return;
+    }
+
+    m_isPrefetchCancelled = false;
+    m_isPrefetchThrottled = true;
+    m_prefetchThread = std::thread(&ResourceManager::prefetchWorker, this, std::move(entries), budget);
+}
+
+// Wait for the current prefetch to complete without throttling, used when the prefetched resources are about to be loaded
+void ResourceManager::finishPrefetching()
+{
+    m_isPrefetchThrottled = false;
+    if (m_prefetchThread.joinable())
+    {
+        m_prefetchThread.join();
+    }
+}
+
+// Cancel the current prefetch, keeping the resources it already decoded
+void ResourceManager::stopPrefetching()
+{
+    m_isPrefetchCancelled = true;
+    if (m_prefetchThread.joinable())
+    {
+        m_prefetchThread.join();
+    }
+}
+
+// Report the outcome of a completed prefetch once, to be called regularly from the main thread while prefetching
+void ResourceManager::updatePrefetching()
+{
+    if (m_isPrefetchComplete.exchange(false) == false)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_prefetchMutex);
+    std::cout << "Prefetching complete: " << m_prefetchedResources.size() << " resources ("
+              << Utility::formatByteCount(m_prefetchedBytes) << ") held until loaded.\n";
+    for (const auto& name : m_prefetchSkippedNames)
+    {
+        std::cout << "Prefetching of \"" << name << "\" skipped to respect the resource memory budget.\n";
+    }
+    m_prefetchSkippedNames.clear();
+}
+
+// Cancel the current prefetch and free the resources it decoded, when they will not be loaded (e.g. another level was loaded)
+void ResourceManager::releasePrefetchedResources()
+{
+    stopPrefetching();
+    m_isPrefetchComplete = false;
+
+    std::lock_guard<std::mutex> lock(m_prefetchMutex);
+    m_prefetchedResources.clear();
+    m_prefetchedBytes = 0;
+    m_prefetchSkippedNames.clear();
+}
+
+// Return the estimated memory held by prefetched resources waiting to be loaded
+std::size_t ResourceManager::getPrefetchedBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_prefetchMutex);
+    return m_prefetchedBytes;
+}
+
 // Texture functions
 
 // Load a texture and bind it to the map if the key is available, and return a reference to the const loaded texture
@@ -132,6 +828,7 @@ const sf::Texture& ResourceManager::loadTexture(const std::string& name, const s
         return m_textures.at("missingTexture");
     }
     it = m_textures.emplace(name, std::move(texture)).first;
+    recordTextureMemoryUsage(name, it->second);
     return it->second;
 }
 
@@ -142,6 +839,7 @@ void ResourceManager::unloadTexture(const std::string& name)
     if (it != m_textures.cend())
     {
         m_textures.erase(it);
+        eraseMemoryUsage(ResourceType::Texture, name);
     }
     else
     {
@@ -183,7 +881,7 @@ void ResourceManager::setTextureSmooth(const std::string& name, bool isSmooth)
     auto it = m_textures.find(name);
     if (it != m_textures.end())
     {
-        it->second.setRepeated(isSmooth);
+        it->second.setSmooth(isSmooth);
     }
     else
     {
@@ -211,6 +909,7 @@ const sf::Font& ResourceManager::loadFont(const std::string& name, const std::st
         return m_fonts.at("fallbackFont");
     }
     it = m_fonts.emplace(name, std::move(font)).first;
+    recordMemoryUsage(ResourceType::Font, name, getFileSize(filename));
     return it->second;
 }
 
@@ -220,7 +919,9 @@ void ResourceManager::unloadFont(const std::string& name)
     auto it = m_fonts.find(name);
     if (it != m_fonts.cend())
     {
+        m_cachedGlyphs.erase(&it->second);
         m_fonts.erase(it);
+        eraseMemoryUsage(ResourceType::Font, name);
     }
     else
     {
@@ -242,6 +943,87 @@ const sf::Font& ResourceManager::getFont(const std::string& name) const
     return m_fonts.at("fallbackFont");
 }
 
+// Rasterize the given characters at each character size into the font's page textures, so that the first draw of text using
+// them does not stall. Must be called from the thread drawing with the font, since sf::Font is not thread-safe
+void ResourceManager::prewarmFont(const std::string& name, const sf::String& characters, const std::vector<unsigned int>& characterSizes,
+                                  float outlineThickness)
+{
+    auto it = m_fonts.find(name);
+    if (it == m_fonts.end())
+    {
+        std::cerr << "ResourceManager error: Tried prewarming unloaded or nonexistent font \"" << name << "\".\n";
+        return;
+    }
+
+    std::unordered_set<std::uint64_t>& cachedGlyphs = m_cachedGlyphs[&it->second];
+    for (unsigned int characterSize : characterSizes)
+    {
+        for (sf::Uint32 codePoint : characters)
+        {
+            it->second.getGlyph(codePoint, characterSize, false, 0);
+            cachedGlyphs.insert(getGlyphKey(codePoint, characterSize, false, 0));
+            if (outlineThickness != 0)
+            {
+                it->second.getGlyph(codePoint, characterSize, false, outlineThickness);
+                cachedGlyphs.insert(getGlyphKey(codePoint, characterSize, false, outlineThickness));
+            }
+        }
+    }
+}
+
+// Report the glyphs of a text which were not prewarmed and will be rasterized on its first draw, and return how many there were
+// Each missing glyph is only reported once, since SFML keeps it cached afterwards
+std::size_t ResourceManager::checkGlyphCache(const sf::Text& text) const
+{
+    const sf::Font* font = text.getFont();
+    if (font == nullptr)
+    {
+        return 0;
+    }
+
+    bool isBold = (text.getStyle() & sf::Text::Bold) != 0;
+    std::unordered_set<std::uint64_t>& cachedGlyphs = m_cachedGlyphs[font];
+    std::size_t missCount = 0;
+    for (sf::Uint32 codePoint : text.getString())
+    {
+        // Line breaks and tabs are never rasterized
+        if (codePoint == '\n' || codePoint == '\t')
+        {
+            continue;
+        }
+
+        for (float outlineThickness : {0.0f, text.getOutlineThickness()})
+        {
+            if (cachedGlyphs.insert(getGlyphKey(codePoint, text.getCharacterSize(), isBold, outlineThickness)).second == true)
+            {
+                // Find the font's name for the report
+                std::string fontName = "unnamed";
+                for (const auto& namedFont : m_fonts)
+                {
+                    if (&namedFont.second == font)
+                    {
+                        fontName = namedFont.first;
+                    }
+                }
+
+                std::cerr << "ResourceManager warning: Glyph cache miss for U+" << std::hex << std::uppercase << std::setw(4)
+                          << std::setfill('0') << codePoint << std::dec << std::nouppercase << std::setfill(' ') << " at size "
+                          << text.getCharacterSize() << (isBold ? " (bold)" : "") << " with outline " << outlineThickness << " in font \""
+                          << fontName << "\".\n";
+                missCount++;
+            }
+
+            if (text.getOutlineThickness() == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    m_glyphCacheMissCount += missCount;
+    return missCount;
+}
+
 // SoundBuffer functions
 
 // Load a sound buffer and bind it to the map if the key is available, and return a reference to the const loaded sound buffer
@@ -262,6 +1044,7 @@ const sf::SoundBuffer& ResourceManager::loadSoundBuffer(const std::string& name,
         return m_soundBuffers.at("error");
     }
     it = m_soundBuffers.emplace(name, std::move(soundBuffer)).first;
+    recordMemoryUsage(ResourceType::SoundBuffer, name, static_cast<std::size_t>(it->second.getSampleCount()) * sizeof(sf::Int16));
     return it->second;
 }
 
@@ -272,6 +1055,7 @@ void ResourceManager::unloadSoundBuffer(const std::string& name)
     if (it != m_soundBuffers.cend())
     {
         m_soundBuffers.erase(it);
+        eraseMemoryUsage(ResourceType::SoundBuffer, name);
     }
     else
     {
@@ -313,6 +1097,7 @@ const sf::Shader& ResourceManager::loadShader(const std::string& name, const std
         m_shaders.erase(name);
         return m_shaders.at("defaultShader");
     }
+    recordMemoryUsage(ResourceType::Shader, name, getFileSize(filename));
     return shader;
 }
 
@@ -323,6 +1108,7 @@ void ResourceManager::unloadShader(const std::string& name)
     if (it != m_shaders.cend())
     {
         m_shaders.erase(it);
+        eraseMemoryUsage(ResourceType::Shader, name);
     }
     else
     {
@@ -0,0 +1,171 @@
+#include "Core/ResourceManifest.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "Core/FileManager.h"
+
+// Parse a manifest file, registering every declared resource, and optionally output the names it lists in order
+// Lines are either declarations (name "filename" [rect:x,y,width,height] [repeated] [smooth]) or bare names referring to
+// resources declared in a previously loaded manifest
+bool ResourceManifest::load(const std::string& filename, std::vector<std::string>* names)
+{
+#if defined(SFML_SYSTEM_ANDROID)
+    std::istringstream inputFile(FileManager::readTxtFromAssets(filename));
+#else
+    std::ifstream inputFile(FileManager::resourcePath() + filename);
+#endif
+
+    if (inputFile)
+    {
+        std::string line;
+        while (std::getline(inputFile, line))
+        {
+            // Remove trailing whitespace (including '\r' from files saved with CRLF line endings)
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+
+            // Ignore empty lines or those starting with '#'
+            if (line.empty() || line.front() == '#')
+            {
+                continue;
+            }
+
+            // Read resource name
+            std::string name = line.substr(0, line.find(' '));
+
+            // Register the declaration if the line has a quoted filename, otherwise treat it as a reference
+            if (line.find('"') != std::string::npos)
+            {
+                ResourceManifestEntry entry;
+                if (!parseDeclaration(line, name, entry))
+                {
+                    std::cerr << "ResourceManifest error: Parsing declaration of \"" << name << "\" failed in file: \"" << filename
+                              << "\".\n";
+                    continue;
+                }
+                m_entries[name] = entry;
+            }
+
+            if (names != nullptr)
+            {
+                names->push_back(name);
+            }
+        }
+
+        return true;
+    }
+
+    std::cerr << "ResourceManifest error: Unable to open \"" << filename << "\".\n";
+    return false;
+}
+
+// Parse a resource declaration line into a manifest entry
+bool ResourceManifest::parseDeclaration(const std::string& line, const std::string& name, ResourceManifestEntry& entry) const
+{
+    // Read quoted filename
+    std::size_t firstDelimPos = line.find('"', name.size());
+    std::size_t lastDelimPos = line.find('"', firstDelimPos + 1);
+    if (lastDelimPos == std::string::npos)
+    {
+        return false;
+    }
+    entry.filename = line.substr(firstDelimPos + 1, lastDelimPos - (firstDelimPos + 1));
+    entry.textureRect = sf::IntRect();
+    entry.shaderType = sf::Shader::Fragment;
+    entry.isRepeated = false;
+    entry.isSmooth = false;
+
+    // Deduce resource type from filename
+    if (entry.filename.find("images") != std::string::npos)
+    {
+        entry.type = ResourceType::Texture;
+    }
+    else if (entry.filename.find("fonts") != std::string::npos)
+    {
+        entry.type = ResourceType::Font;
+    }
+    else if (entry.filename.find("sounds") != std::string::npos)
+    {
+        entry.type = ResourceType::SoundBuffer;
+    }
+    else if (entry.filename.find("shaders") != std::string::npos)
+    {
+        entry.type = ResourceType::Shader;
+
+        // Parse extension from filename
+        std::size_t lastPeriodPos = entry.filename.rfind('.');
+        std::string extension;
+        if (lastPeriodPos != std::string::npos)
+        {
+            extension = entry.filename.substr(lastPeriodPos + 1);
+        }
+
+        // Deduce shader type from extension
+        if (extension == "vert")
+        {
+            entry.shaderType = sf::Shader::Vertex;
+        }
+        else if (extension == "geom")
+        {
+            entry.shaderType = sf::Shader::Geometry;
+        }
+        else if (extension == "frag")
+        {
+            entry.shaderType = sf::Shader::Fragment;
+        }
+        else
+        {
+            std::cerr << "ResourceManifest error: Unable to deduce shader type for filename \"" << entry.filename
+                      << "\" from unknown extension \"" << extension << "\" (extension should be .vert, .geom or .frag)\n";
+            return false;
+        }
+    }
+    else
+    {
+        std::cerr << "ResourceManifest error: Unable to deduce resource type for \"" << name << "\" from filename \"" << entry.filename
+                  << "\"\n";
+        return false;
+    }
+
+    // Read options following the filename
+    std::istringstream optionStream(line.substr(lastDelimPos + 1));
+    std::string option;
+    while (optionStream >> option)
+    {
+        if (option == "repeated")
+        {
+            entry.isRepeated = true;
+        }
+        else if (option == "smooth")
+        {
+            entry.isSmooth = true;
+        }
+        else if (option.compare(0, 5, "rect:") == 0)
+        {
+            std::istringstream rectStream(option.substr(5));
+            char comma;
+            if (!(rectStream >> entry.textureRect.left >> comma >> entry.textureRect.top >> comma >> entry.textureRect.width >> comma >>
+                  entry.textureRect.height))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            std::cerr << "ResourceManifest warning: Ignoring unknown option \"" << option << "\" for \"" << name << "\".\n";
+        }
+    }
+
+    return true;
+}
+
+// Return a pointer to the declaration of a resource, or nullptr if it was never declared
+const ResourceManifestEntry* ResourceManifest::getEntry(const std::string& name) const
+{
+    auto it = m_entries.find(name);
+    if (it != m_entries.cend())
+    {
+        return &it->second;
+    }
+
+    return nullptr;
+}
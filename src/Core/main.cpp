@@ -1,15 +1,47 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
 #include <SFML/Config.hpp>
 #include "Core/GameEngine.h"
+#include "Level/LevelGenerator.h"
 #include "States/SplashScreenState.h"
 #if defined(SFML_SYSTEM_IOS)
 #include <SFML/Main.hpp>
 #elif defined(SFML_SYSTEM_ANDROID)
-#include <iostream>
 #include "Misc/AndroidCout.h"
 #endif
 
-int main()
+namespace
+{
+    // Generate a Level for benchmarks without opening a window:
+    // --generate-level <level directory> <width> <height> [seed] [Entity count]
+    int generateLevel(int argc, char* argv[])
+    {
+        if (argc < 5)
+        {
+            std::cerr << "Usage: " << argv[0] << " --generate-level <level directory> <width> <height> [seed] [Entity count]\n";
+            return EXIT_FAILURE;
+        }
+
+        sf::Vector2u dimensions(static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)),
+                                static_cast<unsigned int>(std::strtoul(argv[4], nullptr, 10)));
+        std::uint32_t seed = argc > 5 ? static_cast<std::uint32_t>(std::strtoul(argv[5], nullptr, 10)) : 0;
+        LevelGenerator::Settings settings = LevelGenerator::getDefaultSettings(dimensions, seed);
+        if (argc > 6)
+        {
+            settings.entityCount = static_cast<unsigned int>(std::strtoul(argv[6], nullptr, 10));
+        }
+        return LevelGenerator::saveLevel(argv[2], settings) == true ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
 {
+    if (argc > 1 && std::string(argv[1]) == "--generate-level")
+    {
+        return generateLevel(argc, argv);
+    }
+
 #if defined(SFML_SYSTEM_ANDROID)
     androidBuffer = new AndroidBuffer;
     std::cout.rdbuf(pAndroidBuffer);
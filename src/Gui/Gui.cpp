@@ -187,11 +187,13 @@ void GuiRectButton::setText(const std::string& text)
 
 // GuiRectSoundButton
 
-GuiRectSoundButton::GuiRectSoundButton(const sf::Font& font, const sf::SoundBuffer& soundBuffer, const sf::Vector2f& position,
-                                       const sf::Vector2f& dimensions, float borderThickness, int textPadding, const std::string& text,
-                                       GuiStyle style)
+GuiRectSoundButton::GuiRectSoundButton(AudioManager& audioManager, const sf::Font& font, const sf::SoundBuffer& soundBuffer,
+                                       const sf::Vector2f& position, const sf::Vector2f& dimensions, float borderThickness, int textPadding,
+                                       const std::string& text, GuiStyle style)
     : GuiRectButton(font, position, dimensions, borderThickness, textPadding, text, style)
-    , m_sound(soundBuffer)
+    , m_audioManager(audioManager)
+    , m_soundBuffer(soundBuffer)
+    , m_volume(100)
 {
 }
 
@@ -203,7 +205,7 @@ void GuiRectSoundButton::setState(GuiState state)
         switch (m_state)
         {
         case GuiState::Hovered:
-            m_sound.play();
+            m_audioManager.play(m_soundBuffer, m_volume, 1, SoundPriority::Low);
             break;
         default:
             break;
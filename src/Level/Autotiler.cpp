@@ -0,0 +1,152 @@
+#include "Level/Autotiler.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "Core/FileManager.h"
+
+Autotiler::Autotiler(std::size_t idCount)
+    : m_terrainSetIndices(idCount, -1)
+{
+}
+
+// Parse a rule line: a TileType id followed by the 3 rows of the 3x3 neighbourhood (e.g. "101 *1* 0.0 000"), where
+// '1' is an empty neighbour, '0' a solid one (or outside of the Map), '*' either, and '.' the Tile itself
+bool Autotiler::parseRule(const std::string& line, Rule& rule) const
+{
+    std::istringstream lineStream(line);
+    std::string rows[3];
+    if (!(lineStream >> rule.id >> rows[0] >> rows[1] >> rows[2]))
+    {
+        return false;
+    }
+
+    std::string pattern = rows[0] + rows[1] + rows[2];
+    if (pattern.size() != 9 || pattern[4] != '.')
+    {
+        return false;
+    }
+    pattern.erase(4, 1);
+
+    rule.emptyMask = 0;
+    rule.careMask = 0;
+    for (std::size_t i = 0; i < pattern.size(); i++)
+    {
+        if (pattern[i] == '1')
+        {
+            rule.emptyMask |= 1 << i;
+            rule.careMask |= 1 << i;
+        }
+        else if (pattern[i] == '0')
+        {
+            rule.careMask |= 1 << i;
+        }
+        else if (pattern[i] != '*')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Fold a terrain set's rules into its table, where each mask gets the first rule it matches (or the default variant)
+bool Autotiler::addTerrainSet(const std::string& name, std::uint16_t firstId, std::uint16_t lastId, std::uint16_t defaultId,
+                              const std::vector<Rule>& rules)
+{
+    if (firstId > lastId || lastId >= m_terrainSetIndices.size())
+    {
+        std::cerr << "Autotiler error: Invalid TileType id range for terrain set \"" << name << "\".\n";
+        return false;
+    }
+
+    TerrainSet terrainSet;
+    terrainSet.name = name;
+    for (unsigned int mask = 0; mask < terrainSet.variants.size(); mask++)
+    {
+        terrainSet.variants[mask] = defaultId;
+        for (const auto& rule : rules)
+        {
+            if ((mask & rule.careMask) == rule.emptyMask)
+            {
+                terrainSet.variants[mask] = rule.id;
+                break;
+            }
+        }
+    }
+
+    for (std::uint16_t id = firstId; id <= lastId; id++)
+    {
+        m_terrainSetIndices[id] = static_cast<std::int16_t>(m_terrainSets.size());
+    }
+    m_terrainSets.push_back(terrainSet);
+    return true;
+}
+
+// Load terrain sets from a rule file, where each set starts with "terrain <name> <first id> <last id> <default id>",
+// is followed by its rules in order of priority, and ends with "end"
+bool Autotiler::load(const std::string& filename)
+{
+#if defined(SFML_SYSTEM_ANDROID)
+    std::istringstream inputFile(FileManager::readTxtFromAssets(filename));
+#else
+    std::ifstream inputFile(FileManager::resourcePath() + filename);
+#endif
+
+    if (inputFile)
+    {
+        std::string name;
+        std::uint16_t firstId = 0;
+        std::uint16_t lastId = 0;
+        std::uint16_t defaultId = 0;
+        std::vector<Rule> rules;
+        bool isInTerrainSet = false;
+
+        std::string line;
+        while (std::getline(inputFile, line))
+        {
+            // Remove trailing whitespace (including '\r' from files saved with CRLF line endings)
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+
+            // Ignore empty lines or those starting with '#'
+            if (line.empty() || line.front() == '#')
+            {
+                continue;
+            }
+
+            if (line.compare(0, 8, "terrain ") == 0)
+            {
+                std::istringstream lineStream(line.substr(8));
+                if (!(lineStream >> name >> firstId >> lastId >> defaultId))
+                {
+                    std::cerr << "Autotiler error: Parsing terrain set header failed in file: \"" << filename << "\".\n";
+                    return false;
+                }
+                rules.clear();
+                isInTerrainSet = true;
+            }
+            else if (line == "end" && isInTerrainSet == true)
+            {
+                if (addTerrainSet(name, firstId, lastId, defaultId, rules) == false)
+                {
+                    return false;
+                }
+                isInTerrainSet = false;
+            }
+            else
+            {
+                Rule rule;
+                if (isInTerrainSet == false || parseRule(line, rule) == false)
+                {
+                    std::cerr << "Autotiler error: Parsing rule \"" << line << "\" failed in file: \"" << filename << "\".\n";
+                    return false;
+                }
+                rules.push_back(rule);
+            }
+        }
+
+        return true;
+    }
+
+    std::cerr << "Autotiler error: Unable to open \"" << filename << "\".\n";
+    return false;
+}
@@ -0,0 +1,259 @@
+#include "Level/ChunkStreamer.h"
+#include <cstdio>
+#include <iostream>
+#include "Core/FileManager.h"
+
+namespace
+{
+    // Return the key of a layer's chunk in the journal index
+    std::uint64_t getJournalKey(unsigned int z, unsigned int chunkX, unsigned int chunkY)
+    {
+        return static_cast<std::uint64_t>(z) << 32 | static_cast<std::uint64_t>(chunkY) << 16 | chunkX;
+    }
+} // namespace
+
+ChunkStreamer::ChunkStreamer()
+    : m_layerCount(0)
+    , m_journalSize(0)
+    , m_isJournalOpen(false)
+    , m_isWorking(false)
+    , m_isStopping(false)
+{
+}
+
+ChunkStreamer::~ChunkStreamer()
+{
+    close();
+}
+
+// Process tasks in the order they were requested, so that a chunk written back and then requested again is read back correctly
+void ChunkStreamer::worker()
+{
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_taskMutex);
+            m_isWorking = false;
+            m_idleCondition.notify_all();
+            m_taskCondition.wait(lock, [this]() { return m_isStopping == true || m_tasks.empty() == false; });
+            if (m_isStopping == true)
+            {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            m_isWorking = true;
+        }
+
+        if (task.isWrite == true)
+        {
+            writeLayerChunks(task.chunk);
+            continue;
+        }
+
+        task.chunk.layers.resize(m_layerCount);
+        for (unsigned int z = 0; z < m_layerCount; z++)
+        {
+            std::lock_guard<std::mutex> lock(m_fileMutex);
+            readLayerChunk(z, task.chunk.chunkX, task.chunk.chunkY, task.chunk.layers[z]);
+        }
+
+        std::lock_guard<std::mutex> lock(m_taskMutex);
+        m_loadedChunks.push_back(std::move(task.chunk));
+    }
+}
+
+// Decode a layer's chunk from the journal if it was written back, otherwise from the Map file (m_fileMutex must be locked)
+// Corrupted chunks are read as empty, and false is returned
+bool ChunkStreamer::readLayerChunk(unsigned int z, unsigned int chunkX, unsigned int chunkY, TileLayer::Chunk& chunk)
+{
+    bool isRead = true;
+    auto it = m_journalIndex.find(getJournalKey(z, chunkX, chunkY));
+    if (it != m_journalIndex.end())
+    {
+        std::vector<char> data(it->second.second);
+        m_journal.seekg(it->second.first);
+        isRead = m_journal.read(data.data(), data.size()) && MapFile::decodeChunk(data.data(), data.size(), chunk);
+        m_journal.clear();
+    }
+    else if (m_mapFile.hasChunk(z, chunkX, chunkY) == true)
+    {
+        isRead = m_mapFile.readChunk(z, chunkX, chunkY, chunk);
+    }
+    else
+    {
+        chunk.tileCount = 0;
+    }
+
+    if (isRead == false)
+    {
+        std::cerr << "ChunkStreamer error: Corrupted chunk (" << chunkX << ", " << chunkY << ") on layer " << z << " of \"" << m_filename
+                  << "\", read as empty.\n";
+        chunk.tileCount = 0;
+    }
+    return isRead;
+}
+
+// Append a chunk's layers to the journal, replacing any previous version of them
+void ChunkStreamer::writeLayerChunks(const StreamedChunk& chunk)
+{
+    std::vector<char> data;
+    for (unsigned int z = 0; z < chunk.layers.size(); z++)
+    {
+        data.clear();
+        MapFile::encodeChunk(chunk.layers[z], data);
+
+        std::lock_guard<std::mutex> lock(m_fileMutex);
+        m_journal.seekp(m_journalSize);
+        if (!m_journal.write(data.data(), data.size()))
+        {
+            std::cerr << "ChunkStreamer error: Unable to write chunk (" << chunk.chunkX << ", " << chunk.chunkY << ") to the journal of \""
+                      << m_filename << "\", its changes are lost.\n";
+            m_journal.clear();
+            continue;
+        }
+        m_journalIndex[getJournalKey(z, chunk.chunkX, chunk.chunkY)] = std::make_pair(m_journalSize, data.size());
+        m_journalSize += data.size();
+    }
+    m_journal.flush();
+}
+
+// Return the path of the journal file
+std::string ChunkStreamer::getJournalPath() const
+{
+    return FileManager::resourcePath() + m_filename + ".journal";
+}
+
+// Map a binary Map file and start the worker thread, with an empty journal
+// Without a journal (e.g. on read-only storage), chunks can still be streamed, but not written back
+bool ChunkStreamer::open(const std::string& filename, unsigned int layerCount)
+{
+    close();
+    if (m_mapFile.open(filename) == false)
+    {
+        return false;
+    }
+    m_filename = filename;
+    m_layerCount = layerCount;
+
+    m_journal.open(getJournalPath(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    m_isJournalOpen = m_journal.is_open();
+    if (m_isJournalOpen == false)
+    {
+        std::cerr << "ChunkStreamer warning: Unable to create the journal of \"" << filename << "\", modified chunks will stay loaded.\n";
+    }
+
+    m_isStopping = false;
+    m_isWorking = false;
+    m_thread = std::thread(&ChunkStreamer::worker, this);
+    return true;
+}
+
+// Stop the worker thread, dropping the requests it did not process yet, and delete the journal
+void ChunkStreamer::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_taskMutex);
+        m_isStopping = true;
+        m_tasks.clear();
+        m_loadedChunks.clear();
+    }
+    m_taskCondition.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    if (m_journal.is_open())
+    {
+        m_journal.close();
+        std::remove(getJournalPath().c_str());
+    }
+    m_isJournalOpen = false;
+    m_journalIndex.clear();
+    m_journalSize = 0;
+    m_mapFile.close();
+    m_filename.clear();
+}
+
+// Queue the decoding of a chunk of every layer, returned later by takeLoadedChunks()
+void ChunkStreamer::requestLoad(unsigned int chunkX, unsigned int chunkY)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_taskMutex);
+        m_tasks.push_back(Task{false, StreamedChunk{chunkX, chunkY, {}}});
+    }
+    m_taskCondition.notify_one();
+}
+
+// Queue the writing of a modified chunk's layers to the journal
+void ChunkStreamer::requestWrite(StreamedChunk chunk)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_taskMutex);
+        m_tasks.push_back(Task{true, std::move(chunk)});
+    }
+    m_taskCondition.notify_one();
+}
+
+// Move the chunks decoded since the last call to a vector
+void ChunkStreamer::takeLoadedChunks(std::vector<StreamedChunk>& chunks)
+{
+    std::lock_guard<std::mutex> lock(m_taskMutex);
+    chunks.swap(m_loadedChunks);
+    m_loadedChunks.clear();
+}
+
+// Block until every queued request has been processed
+void ChunkStreamer::waitUntilIdle()
+{
+    std::unique_lock<std::mutex> lock(m_taskMutex);
+    m_idleCondition.wait(lock, [this]() { return m_thread.joinable() == false || (m_tasks.empty() == true && m_isWorking == false); });
+}
+
+// Decode a layer's chunk on the calling thread, including its written back changes
+bool ChunkStreamer::readChunkNow(unsigned int z, unsigned int chunkX, unsigned int chunkY, TileLayer::Chunk& chunk)
+{
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    return readLayerChunk(z, chunkX, chunkY, chunk);
+}
+
+// Replace the streamed Map file with a newly saved one containing every change, which makes the journal obsolete
+bool ChunkStreamer::replaceMapFile(const std::string& savedFilename)
+{
+    waitUntilIdle();
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+
+    // The file must be unmapped before being replaced, and some systems do not allow renaming over an existing file
+    std::string path = FileManager::resourcePath() + m_filename;
+    std::string savedPath = FileManager::resourcePath() + savedFilename;
+    m_mapFile.close();
+    bool isReplaced = std::rename(savedPath.c_str(), path.c_str()) == 0;
+    if (isReplaced == false)
+    {
+        std::remove(path.c_str());
+        isReplaced = std::rename(savedPath.c_str(), path.c_str()) == 0;
+    }
+
+    // If the file could not be replaced, keep streaming from the saved file
+    if (isReplaced == false)
+    {
+        std::cerr << "ChunkStreamer error: Unable to replace \"" << m_filename << "\" with \"" << savedFilename << "\".\n";
+    }
+    if (m_mapFile.open(isReplaced == true ? m_filename : savedFilename) == false)
+    {
+        std::cerr << "ChunkStreamer error: Unable to reopen \"" << m_filename << "\" after saving it.\n";
+        return false;
+    }
+
+    if (m_journal.is_open())
+    {
+        m_journal.close();
+        m_journal.open(getJournalPath(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+        m_isJournalOpen = m_journal.is_open();
+    }
+    m_journalIndex.clear();
+    m_journalSize = 0;
+    return isReplaced;
+}
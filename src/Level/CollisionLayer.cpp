@@ -0,0 +1,125 @@
+#include "Level/CollisionLayer.h"
+#include <algorithm>
+#include <bitset>
+
+CollisionLayer::CollisionLayer()
+    : m_dimensions(0, 0)
+    , m_regionCounts(0, 0)
+{
+}
+
+// Resize the layer, removing all rectangles and marking every region dirty
+void CollisionLayer::resize(const sf::Vector2u& dimensions)
+{
+    m_dimensions = dimensions;
+    m_regionCounts = sf::Vector2u((dimensions.x + regionSize - 1) / regionSize, (dimensions.y + regionSize - 1) / regionSize);
+    m_regions.clear();
+    m_regions.resize(m_regionCounts.x * m_regionCounts.y, Region{std::vector<CollisionRect>(), true});
+}
+
+// Append the rectangles overlapping a range of Tiles to rects (rectangles of dirty regions are out of date)
+void CollisionLayer::findRects(const sf::Vector2u& tileIndex, const sf::Vector2u& range, std::vector<CollisionRect>& rects) const
+{
+    if (tileIndex.x >= m_dimensions.x || tileIndex.y >= m_dimensions.y || range.x == 0 || range.y == 0)
+    {
+        return;
+    }
+
+    sf::IntRect rangeRect(tileIndex.x, tileIndex.y, std::min(range.x, m_dimensions.x - tileIndex.x),
+                          std::min(range.y, m_dimensions.y - tileIndex.y));
+    for (unsigned int regionY = tileIndex.y / regionSize; regionY <= (rangeRect.top + rangeRect.height - 1) / regionSize; regionY++)
+    {
+        for (unsigned int regionX = tileIndex.x / regionSize; regionX <= (rangeRect.left + rangeRect.width - 1) / regionSize; regionX++)
+        {
+            // Rectangles never span several regions, so none is found twice
+            for (const auto& rect : m_regions[regionY * m_regionCounts.x + regionX].rects)
+            {
+                if (rect.tileRect.intersects(rangeRect) == true)
+                {
+                    rects.push_back(rect);
+                }
+            }
+        }
+    }
+}
+
+// Merge the colliding Tiles of a region into rectangles, given the TileCollision of each of its cells
+// Cells are scanned row by row, and each uncovered cell starts a rectangle grown first to the right, then downwards
+void CollisionLayer::setRegion(unsigned int regionX, unsigned int regionY, const RegionCollisions& collisions)
+{
+    Region& region = m_regions[regionY * m_regionCounts.x + regionX];
+    region.rects.clear();
+    region.isDirty = false;
+
+    unsigned int left = regionX * regionSize;
+    unsigned int top = regionY * regionSize;
+    unsigned int width = std::min(regionSize, m_dimensions.x - left);
+    unsigned int height = std::min(regionSize, m_dimensions.y - top);
+    std::bitset<regionSize * regionSize> isCovered;
+    for (unsigned int y = 0; y < height; y++)
+    {
+        for (unsigned int x = 0; x < width; x++)
+        {
+            TileCollision collision = collisions[y * regionSize + x];
+            if (collision == TileCollision::None || isCovered[y * regionSize + x] == true)
+            {
+                continue;
+            }
+
+            unsigned int rectWidth = 1;
+            while (x + rectWidth < width && collisions[y * regionSize + x + rectWidth] == collision &&
+                   isCovered[y * regionSize + x + rectWidth] == false)
+            {
+                rectWidth++;
+            }
+
+            unsigned int rectHeight = 1;
+            while (collision == TileCollision::Solid && y + rectHeight < height)
+            {
+                unsigned int rowStart = (y + rectHeight) * regionSize + x;
+                bool isRowMergeable = true;
+                for (unsigned int i = 0; i < rectWidth && isRowMergeable == true; i++)
+                {
+                    isRowMergeable = collisions[rowStart + i] == collision && isCovered[rowStart + i] == false;
+                }
+                if (isRowMergeable == false)
+                {
+                    break;
+                }
+                rectHeight++;
+            }
+
+            for (unsigned int j = 0; j < rectHeight; j++)
+            {
+                for (unsigned int i = 0; i < rectWidth; i++)
+                {
+                    isCovered[(y + j) * regionSize + x + i] = true;
+                }
+            }
+            region.rects.push_back(CollisionRect{sf::IntRect(left + x, top + y, rectWidth, rectHeight), collision});
+            x += rectWidth - 1;
+        }
+    }
+}
+
+// Return the number of rectangles of all regions
+std::size_t CollisionLayer::getRectCount() const
+{
+    std::size_t rectCount = 0;
+    for (const auto& region : m_regions)
+    {
+        rectCount += region.rects.size();
+    }
+    return rectCount;
+}
+
+// Return the approximate memory used by the regions and their rectangles, in bytes
+std::size_t CollisionLayer::getMemoryUsage() const
+{
+    std::size_t bytes = m_regions.capacity() * sizeof(Region);
+    for (const auto& region : m_regions)
+    {
+        bytes += region.rects.capacity() * sizeof(CollisionRect);
+    }
+    return bytes;
+}
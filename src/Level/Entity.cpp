@@ -1,4 +1,5 @@
 #include "Level/Entity.h"
+#include <algorithm>
 #include <cmath>
 
 namespace
@@ -42,25 +43,23 @@ Entity::Entity(Map& map, std::vector<Entity*>& entities, EntityType entityType,
     m_tileReactionDot.setFillColor(sf::Color::Cyan);
 }
 
-// Apply collision with a pointer to a const Tile
-void Entity::tileCollision(const Tile* tile)
+// Apply collision with a rectangle of Tiles sharing a TileCollision
+void Entity::tileCollision(const CollisionRect& collisionRect)
 {
-    if (tile == nullptr)
-    {
-        return;
-    }
+    float tileSize = static_cast<float>(m_map.getTileSize());
+    sf::FloatRect bounds(collisionRect.tileRect.left * tileSize, collisionRect.tileRect.top * tileSize,
+                         collisionRect.tileRect.width * tileSize, collisionRect.tileRect.height * tileSize);
 
-    if (tile->isSolid())
+    switch (collisionRect.collision)
     {
-        switch (tile->getTileType())
-        {
-        default:
-            standardCollision(tile);
-            break;
-        case TileType::LadderTop:
-            ladderTopCollision(tile);
-            break;
-        }
+    case TileCollision::Solid:
+        standardCollision(bounds);
+        break;
+    case TileCollision::Platform:
+        ladderTopCollision(bounds);
+        break;
+    case TileCollision::None:
+        break;
     }
 }
 
@@ -70,27 +69,22 @@ void Entity::entityCollision(const Entity* entity)
     // TODO
 }
 
-// Perform reactions with a pointer to a Tile
-void Entity::tileReaction(Tile* tile)
+// Perform reactions with a Tile
+void Entity::tileReaction(const Tile& tile)
 {
-    if (tile == nullptr)
+    if (tile.isNull() == true)
     {
         m_state = EntityState::Still;
         return;
     }
 
-    switch (tile->getTileType())
+    if (tile.getDef().climbFactor > 0)
+    {
+        climb(tile.getDef().climbFactor);
+    }
+    else
     {
-    case TileType::Ladder:
-    case TileType::LadderTop:
-        climb();
-        break;
-    case TileType::Vine:
-        climb(0.75);
-        break;
-    default:
         m_state = EntityState::Still;
-        break;
     }
 }
 
@@ -107,11 +101,11 @@ void Entity::entityReaction(Entity* entity)
     }
 }
 
-// Collision used for Tiles that have collision for all four sides
-void Entity::standardCollision(const Tile* tile)
+// Collision used for Tiles that have collision for all four sides, given the bounds of a rectangle of them
+void Entity::standardCollision(const sf::FloatRect& bounds)
 {
-    sf::Vector2f tilePosition = tile->getPosition();
-    sf::Vector2f tileDimensions = tile->getDimensions();
+    sf::Vector2f tilePosition(bounds.left, bounds.top);
+    sf::Vector2f tileDimensions(bounds.width, bounds.height);
     // Check for Y-axis overlap
     if (m_position.y + m_dimensions.y / 2 + m_velocity.y >= tilePosition.y &&
         m_position.y - m_dimensions.y / 2 + m_velocity.y < tilePosition.y + tileDimensions.y)
@@ -234,11 +228,11 @@ void Entity::standardCollision(const Tile* tile)
     }
 }
 
-// Collision used for LadderTop Tiles that have collision for all four sides
-void Entity::ladderTopCollision(const Tile* tile)
+// Collision used for LadderTop Tiles that have collision for all four sides, given the bounds of a row of them
+void Entity::ladderTopCollision(const sf::FloatRect& bounds)
 {
-    sf::Vector2f tilePosition = tile->getPosition();
-    sf::Vector2f tileDimensions = tile->getDimensions();
+    sf::Vector2f tilePosition(bounds.left, bounds.top);
+    sf::Vector2f tileDimensions(bounds.width, bounds.height);
     // If Entity is going downwards
     if (m_velocity.y >= 0)
     {
@@ -449,46 +443,37 @@ void Entity::performCollisions()
     // Collision with Tiles
     if (m_isTileCollideable == true)
     {
-        // Loop through Tiles in the same direction as the Entity's velocity to fix collision problems
+        // Skip the whole range if none of its Tiles is solid, a few words of the Map's solidity mask at a time
         sf::Vector2u positionIndex = m_map.coordsToTileIndex(m_position);
-        if (m_velocity.x >= 0)
-        {
-            for (int i = -range - 1; i <= range + 1; i++)
-            {
-                if (m_velocity.y >= 0)
-                {
-                    for (int j = -range - 1; j <= range + 1; j++)
-                    {
-                        tileCollision(m_map.getKTilePtr(sf::Vector2u(positionIndex.x + i, positionIndex.y + j), MapLayer::Solid));
-                    }
-                }
-                else
-                {
-                    for (int j = range + 1; j >= -range - 1; j--)
-                    {
-                        tileCollision(m_map.getKTilePtr(sf::Vector2u(positionIndex.x + i, positionIndex.y + j), MapLayer::Solid));
-                    }
-                }
-            }
-        }
-        else
+        int rangeIndex = static_cast<int>(range + 1);
+        sf::Vector2u rangeStart(std::max(static_cast<int>(positionIndex.x) - rangeIndex, 0),
+                                std::max(static_cast<int>(positionIndex.y) - rangeIndex, 0));
+        sf::Vector2u rangeEnd(positionIndex.x + rangeIndex + 1, positionIndex.y + rangeIndex + 1);
+        if (m_map.getSolidityMask().isAnySolid(rangeStart, rangeEnd - rangeStart) == true)
         {
-            for (int i = range + 1; i >= -range - 1; i--)
+            // Collide with the merged rectangles of the range's solid Tiles rather than with each Tile
+            m_collisionRects.clear();
+            m_map.getCollisionRects(rangeStart, rangeEnd - rangeStart, m_collisionRects);
+
+            // Resolve rectangles in the same direction as the Entity's velocity to fix collision problems
+            bool isGoingLeft = m_velocity.x < 0;
+            bool isGoingUp = m_velocity.y < 0;
+            std::sort(m_collisionRects.begin(), m_collisionRects.end(),
+                      [isGoingLeft, isGoingUp](const CollisionRect& a, const CollisionRect& b)
+                      {
+                          int aX = isGoingLeft == true ? -(a.tileRect.left + a.tileRect.width) : a.tileRect.left;
+                          int bX = isGoingLeft == true ? -(b.tileRect.left + b.tileRect.width) : b.tileRect.left;
+                          if (aX != bX)
+                          {
+                              return aX < bX;
+                          }
+                          int aY = isGoingUp == true ? -(a.tileRect.top + a.tileRect.height) : a.tileRect.top;
+                          int bY = isGoingUp == true ? -(b.tileRect.top + b.tileRect.height) : b.tileRect.top;
+                          return aY < bY;
+                      });
+            for (const auto& collisionRect : m_collisionRects)
             {
-                if (m_velocity.y >= 0)
-                {
-                    for (int j = -range - 1; j <= range + 1; j++)
-                    {
-                        tileCollision(m_map.getKTilePtr(sf::Vector2u(positionIndex.x + i, positionIndex.y + j), MapLayer::Solid));
-                    }
-                }
-                else
-                {
-                    for (int j = range + 1; j >= -range - 1; j--)
-                    {
-                        tileCollision(m_map.getKTilePtr(sf::Vector2u(positionIndex.x + i, positionIndex.y + j), MapLayer::Solid));
-                    }
-                }
+                tileCollision(collisionRect);
             }
         }
     }
@@ -559,19 +544,19 @@ void Entity::update()
     // Cycle through the possible points to do a TileReaction on a Tile on one of those points, if found
     for (std::size_t i = 0; i < tileReactionPoints.size(); i++)
     {
-        Tile* tile = m_map.getTilePtr(m_map.coordsToTileIndex(tileReactionPoints[i]), MapLayer::Solid);
-        if (tile != nullptr)
+        Tile tile = m_map.getTile(m_map.coordsToTileIndex(tileReactionPoints[i]), MapLayer::Solid);
+        if (tile.isNull() == false)
         {
             tileReaction(tile);
             m_tileReactionDot.setPosition(tileReactionPoints[i]);
             break;
         }
-        // If no valid Tile is found, perform TileReaction on first point (equivalent to nullptr) anyway
+        // If no valid Tile is found, perform TileReaction on first point (equivalent to a null Tile) anyway
         // (to reset Entity state)
         if (i == tileReactionPoints.size() - 1)
         {
             m_tileReactionDot.setPosition(tileReactionPoints.front());
-            tileReaction(nullptr);
+            tileReaction(Tile());
         }
     }
 
@@ -719,6 +704,20 @@ std::vector<std::string> Entity::getTextureNames(EntityType entityType)
     return {};
 }
 
+// Return the level of the light carried by Entities of a type (see LightMap), 0 if they carry none
+std::uint8_t Entity::getLightLevel(EntityType entityType)
+{
+    static const std::unordered_map<EntityType, std::uint8_t> entityLightLevels = {{EntityType::Player, 12}};
+
+    auto it = entityLightLevels.find(entityType);
+    if (it != entityLightLevels.cend())
+    {
+        return it->second;
+    }
+
+    return 0;
+}
+
 // Functions used for getting Entity's pixel position bounds
 
 float Entity::getLeftPixelPosition() const
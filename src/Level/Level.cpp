@@ -9,6 +9,11 @@
 #include "Level/Player.h"
 #include "Misc/Utility.h"
 
+namespace
+{
+    const std::uint8_t ambientLightLevel = 10; // Light level of the Tiles which no light reaches, out of LightMap::maxLightLevel
+} // namespace
+
 Level::Level(const ResourceManager& resourceManager, const InputManager& inputManager)
     : m_resourceManager(resourceManager)
     , m_inputManager(inputManager)
@@ -16,9 +21,12 @@ Level::Level(const ResourceManager& resourceManager, const InputManager& inputMa
     , m_hasFocus(true)
     , m_isCreatorModeEnabled(false)
     , m_isEntityDebugBoxVisible(false)
+    , m_hasSaveFailed(false)
 {
     m_map.setLayerColor(sf::Color(112, 112, 112, 255), MapLayer::Background);
     m_map.setLayerColor(sf::Color(255, 255, 255, 192), MapLayer::Overlay);
+    m_map.setLayerBaked(MapLayer::Background, true);
+    m_map.setAmbientLightLevel(ambientLightLevel);
 
     m_camera.setFollowLerp(0.2);
     m_camera.setBoundless(false);
@@ -217,47 +225,83 @@ bool Level::saveBackground(const std::string& filename) const
     if (outputFile)
     {
         std::cout << "Saving background...\n";
-        outputFile << "# Syntax:\n"
-                      "# resourceName parallaxValue pos:[TL|TM|TR|ML|MM|MR|BL|BM|BR] repeatTexture[-o]:[XY|X|Y] "
-                      "scale[-o]:[x,y|map] offset[-o]:x,y\n\n";
+        writeBackground(outputFile);
+        std::cout << "Background successfully saved.\n\n";
+        return true;
+    }
 
-        std::vector<ParallaxSprite> sortedParallaxSprites(m_parallaxSprites);
-        std::sort(sortedParallaxSprites.begin(),
-                  sortedParallaxSprites.end(),
-                  [](const ParallaxSprite& a, const ParallaxSprite& b) { return a.getParallax() > b.getParallax(); });
+    std::cerr << "Level error: Unable to save \"" << filename << "\".\n"
+              << "Background saving failed.\n\n";
+    return false;
+}
 
-        std::cout << "Number of parallax sprites: " << m_parallaxSprites.size() << '\n';
+// Write the contents of the background's save file
+void Level::writeBackground(std::ostream& output) const
+{
+    output << "# Syntax:\n"
+              "# resourceName parallaxValue pos:[TL|TM|TR|ML|MM|MR|BL|BM|BR] repeatTexture[-o]:[XY|X|Y] "
+              "scale[-o]:[x,y|map] offset[-o]:x,y\n\n";
 
-        std::cout << "Parallax sprites:\n";
-        for (const auto& parallaxSprite : m_parallaxSprites)
-        {
-            outputFile << parallaxSprite.getResourceName() << ' ' << parallaxSprite.getParallax()
-                       << " positionMode:" << parallaxSprite.getPositionModeString();
-            if (!parallaxSprite.getRepeatTextureString().empty())
-            {
-                outputFile << " repeatTexture:" << parallaxSprite.getRepeatTextureString();
-            }
-            if (!parallaxSprite.getScaleString().empty())
-            {
-                outputFile << " scale:" << parallaxSprite.getScaleString();
-            }
-            if (!parallaxSprite.getOffsetString().empty())
-            {
-                outputFile << " offset:" << parallaxSprite.getOffsetString();
-            }
-            outputFile << '\n';
+    std::vector<ParallaxSprite> sortedParallaxSprites(m_parallaxSprites);
+    std::sort(sortedParallaxSprites.begin(),
+              sortedParallaxSprites.end(),
+              [](const ParallaxSprite& a, const ParallaxSprite& b) { return a.getParallax() > b.getParallax(); });
+
+    std::cout << "Number of parallax sprites: " << m_parallaxSprites.size() << '\n';
 
-            std::cout << parallaxSprite.getResourceName() << ' ' << parallaxSprite.getParallax()
-                      << " positionMode:" << parallaxSprite.getPositionModeString() << '\n';
+    std::cout << "Parallax sprites:\n";
+    for (const auto& parallaxSprite : m_parallaxSprites)
+    {
+        output << parallaxSprite.getResourceName() << ' ' << parallaxSprite.getParallax()
+               << " positionMode:" << parallaxSprite.getPositionModeString();
+        if (!parallaxSprite.getRepeatTextureString().empty())
+        {
+            output << " repeatTexture:" << parallaxSprite.getRepeatTextureString();
         }
+        if (!parallaxSprite.getScaleString().empty())
+        {
+            output << " scale:" << parallaxSprite.getScaleString();
+        }
+        if (!parallaxSprite.getOffsetString().empty())
+        {
+            output << " offset:" << parallaxSprite.getOffsetString();
+        }
+        output << '\n';
 
-        std::cout << "Background successfully saved.\n\n";
-        return true;
+        std::cout << parallaxSprite.getResourceName() << ' ' << parallaxSprite.getParallax()
+                  << " positionMode:" << parallaxSprite.getPositionModeString() << '\n';
     }
+}
 
-    std::cerr << "Level error: Unable to save \"" << filename << "\".\n"
-              << "Background saving failed.\n\n";
-    return false;
+// Create an Entity with its animations, returning nullptr for unknown EntityTypes
+Entity* Level::createEntity(EntityType entityType, const sf::Vector2f& position)
+{
+    Entity* entity = nullptr;
+    switch (entityType)
+    {
+    case EntityType::Player:
+        entity = new Player(m_map, m_entities, m_inputManager, position);
+        entity->setStateAnimation(EntityState::Still,
+                                  AnimatedSprite(m_resourceManager.getTexture("characterStill"), sf::Vector2u(54, 82), 22),
+                                  3);
+        entity->setStateAnimation(EntityState::Running,
+                                  AnimatedSprite(m_resourceManager.getTexture("characterRunning"), sf::Vector2u(82, 82), 27),
+                                  1);
+        entity->setStateAnimation(EntityState::Climbing,
+                                  AnimatedSprite(m_resourceManager.getTexture("characterClimbing"), sf::Vector2u(70, 82), 8),
+                                  2);
+        entity->setStateAnimation(EntityState::Jumping,
+                                  AnimatedSprite(m_resourceManager.getTexture("characterJumping"), sf::Vector2u(66, 82), 3),
+                                  2);
+        entity->setStateAnimation(EntityState::Falling,
+                                  AnimatedSprite(m_resourceManager.getTexture("characterFalling"), sf::Vector2u(72, 82), 3),
+                                  2);
+        entity->setPosition(position);
+        break;
+    default:
+        break;
+    }
+    return entity;
 }
 
 // Load the Entities from a save file
@@ -268,6 +312,7 @@ bool Level::loadEntities(const std::string& filename)
     {
         delete entity;
     }
+    m_map.clearMovingLights();
 
     std::ifstream inputFile(FileManager::resourcePath() + filename);
     if (inputFile)
@@ -285,30 +330,7 @@ bool Level::loadEntities(const std::string& filename)
             float xPosition = 0;
             float yPosition = 0;
             inputFile >> type >> xPosition >> yPosition;
-            switch (static_cast<EntityType>(type))
-            {
-            case EntityType::Player:
-                entity = new Player(m_map, m_entities, m_inputManager, sf::Vector2f(xPosition, yPosition));
-                entity->setStateAnimation(EntityState::Still,
-                                          AnimatedSprite(m_resourceManager.getTexture("characterStill"), sf::Vector2u(54, 82), 22),
-                                          3);
-                entity->setStateAnimation(EntityState::Running,
-                                          AnimatedSprite(m_resourceManager.getTexture("characterRunning"), sf::Vector2u(82, 82), 27),
-                                          1);
-                entity->setStateAnimation(EntityState::Climbing,
-                                          AnimatedSprite(m_resourceManager.getTexture("characterClimbing"), sf::Vector2u(70, 82), 8),
-                                          2);
-                entity->setStateAnimation(EntityState::Jumping,
-                                          AnimatedSprite(m_resourceManager.getTexture("characterJumping"), sf::Vector2u(66, 82), 3),
-                                          2);
-                entity->setStateAnimation(EntityState::Falling,
-                                          AnimatedSprite(m_resourceManager.getTexture("characterFalling"), sf::Vector2u(72, 82), 3),
-                                          2);
-                entity->setPosition({xPosition, yPosition});
-                break;
-            default:
-                break;
-            }
+            entity = createEntity(static_cast<EntityType>(type), sf::Vector2f(xPosition, yPosition));
             std::cout << Entity::getEntityTypeString(entity->getEntityType()) << " at (" << entity->getPosition().x << ", "
                       << entity->getPosition().y << ")\n";
         }
@@ -329,18 +351,7 @@ bool Level::saveEntities(const std::string& filename) const
     if (outputFile)
     {
         std::cout << "Saving Entities...\n";
-        outputFile << m_entities.size() << '\n';
-        std::cout << "Number of Entities: " << m_entities.size() << '\n';
-
-        std::cout << "Entities:\n";
-        for (const auto& entity : m_entities)
-        {
-            outputFile << static_cast<int>(entity->getEntityType()) << ' ' << entity->getPosition().x << ' ' << entity->getPosition().y
-                       << "\n";
-            std::cout << Entity::getEntityTypeString(entity->getEntityType()) << " at (" << entity->getPosition().x << ", "
-                      << entity->getPosition().y << ")\n";
-        }
-
+        writeEntities(outputFile);
         std::cout << "Entities successfully saved.\n\n";
         return true;
     }
@@ -350,6 +361,44 @@ bool Level::saveEntities(const std::string& filename) const
     return false;
 }
 
+// Write the contents of the Entities' save file
+void Level::writeEntities(std::ostream& output) const
+{
+    output << m_entities.size() << '\n';
+    std::cout << "Number of Entities: " << m_entities.size() << '\n';
+
+    std::cout << "Entities:\n";
+    for (const auto& entity : m_entities)
+    {
+        output << static_cast<int>(entity->getEntityType()) << ' ' << entity->getPosition().x << ' ' << entity->getPosition().y << "\n";
+        std::cout << Entity::getEntityTypeString(entity->getEntityType()) << " at (" << entity->getPosition().x << ", "
+                  << entity->getPosition().y << ")\n";
+    }
+}
+
+// Add the resources necessary for the background and the Entities to a set
+void Level::addBackgroundAndEntityResources(std::set<std::string>& resources) const
+{
+    // Background
+    for (const auto& parallaxSprite : m_parallaxSprites)
+    {
+        resources.insert(parallaxSprite.getResourceName());
+    }
+
+    // Entities
+    for (const auto& entity : m_entities)
+    {
+        if (entity != nullptr)
+        {
+            std::vector<std::string> entityTextureNames = Entity::getTextureNames(entity->getEntityType());
+            for (const auto& textureName : entityTextureNames)
+            {
+                resources.insert(textureName);
+            }
+        }
+    }
+}
+
 // Load the list of necessary resources for the Level from a save file
 bool Level::loadResources(const std::string& filename)
 {
@@ -374,33 +423,16 @@ bool Level::saveResources(const std::string& filename) const
             {
                 for (unsigned int x = 0; x < m_map.getIndexDimensions().x; x++)
                 {
-                    const Tile* tile = m_map.getKTilePtr(sf::Vector2u(x, y), static_cast<MapLayer>(z));
-                    if (tile != nullptr)
+                    Tile tile = m_map.getTile(sf::Vector2u(x, y), static_cast<MapLayer>(z));
+                    if (tile.isNull() == false && tile.getDef().textureName.empty() == false)
                     {
-                        resources.insert(Tile::getTextureName(tile->getTileType()));
+                        resources.insert(tile.getDef().textureName);
                     }
                 }
             }
         }
 
-        // Background
-        for (const auto& parallaxSprite : m_parallaxSprites)
-        {
-            resources.insert(parallaxSprite.getResourceName());
-        }
-
-        // Entities
-        for (const auto& entity : m_entities)
-        {
-            if (entity != nullptr)
-            {
-                std::vector<std::string> entityTextureNames = Entity::getTextureNames(entity->getEntityType());
-                for (const auto& textureName : entityTextureNames)
-                {
-                    resources.insert(textureName);
-                }
-            }
-        }
+        addBackgroundAndEntityResources(resources);
 
         std::cout << "Number of resources: " << resources.size() << '\n';
 
@@ -497,6 +529,11 @@ void Level::update()
 {
     m_map.update();
 
+    if (m_levelSaver != nullptr && m_levelSaver->isDone() == true)
+    {
+        finishSave();
+    }
+
     if (m_isCreatorModeEnabled == false)
     {
         for (const auto& entity : m_entities)
@@ -505,7 +542,18 @@ void Level::update()
         }
     }
 
+    // Entities carry their lights, which only update the light map around them when they move to another Tile
+    for (std::size_t i = 0; i < m_entities.size(); i++)
+    {
+        m_map.setMovingLight(i, m_entities[i]->getPosition(), Entity::getLightLevel(m_entities[i]->getEntityType()));
+    }
+    m_map.updateLighting();
+
     m_camera.update();
+
+    // Stream the Map's chunks around the Camera's view (does nothing if the Map is fully loaded)
+    sf::FloatRect viewRect(m_camera.getPosition() - m_camera.getDimensions() / 2.0f, m_camera.getDimensions());
+    m_map.updateStreaming(viewRect, m_camera.getVelocity());
 }
 
 void Level::draw(sf::RenderTarget& target, sf::RenderStates states, float lag)
@@ -532,6 +580,12 @@ void Level::draw(sf::RenderTarget& target, sf::RenderStates states, float lag)
         target.draw(*entity, states);
     }
 
+    // Lighting (Tiles are edited in full light in creator mode)
+    if (m_isCreatorModeEnabled == false)
+    {
+        m_map.drawLightMap(target, states);
+    }
+
     // Reset the target's view back to its initial view
     target.setView(oldView);
 }
@@ -539,8 +593,13 @@ void Level::draw(sf::RenderTarget& target, sf::RenderStates states, float lag)
 // Load all Level components, such as the Map, the Entities and the Parallax background
 bool Level::load(const std::string& levelDirectory)
 {
+    finishSave();
     std::cout << "\nLoading Level: " << levelDirectory << "\n\n";
-    if (m_map.load(levelDirectory + "/tiles.txt") && loadBackground(levelDirectory + "/background.txt") &&
+
+    // Prefer the binary Map (streamed if large), the text Map being imported if the Level was never saved in the binary format
+    bool isMapLoaded = FileManager::fileExists(levelDirectory + "/tiles.bin") ? m_map.loadBinary(levelDirectory + "/tiles.bin", true)
+                                                                                : m_map.load(levelDirectory + "/tiles.txt");
+    if (isMapLoaded && loadBackground(levelDirectory + "/background.txt") &&
         loadEntities(levelDirectory + "/entities.txt") && loadResources(levelDirectory + "/resources.txt"))
     {
         m_camera.setBounds(static_cast<sf::Vector2f>(m_map.getBounds()));
@@ -553,6 +612,11 @@ bool Level::load(const std::string& levelDirectory)
             }
         }
 
+        // Load the chunks around the initial view before the first update, so that Entities start on loaded Tiles
+        sf::FloatRect viewRect(m_camera.getPosition() - m_camera.getDimensions() / 2.0f, m_camera.getDimensions());
+        m_map.updateStreaming(viewRect, sf::Vector2f(0, 0));
+        m_map.finishStreaming();
+
         std::cout << "Level successfully loaded.\n\n";
         return true;
     }
@@ -561,15 +625,56 @@ bool Level::load(const std::string& levelDirectory)
     return false;
 }
 
+// Replace the Level with a procedurally generated one (see LevelGenerator), with a Player at each of its spawn Tiles
+bool Level::generate(const LevelGenerator::Settings& settings)
+{
+    finishSave();
+    std::cout << "\nGenerating Level\n\n";
+
+    if (m_map.generate(settings) == false)
+    {
+        std::cout << "Failed to generate Level.\n\n";
+        return false;
+    }
+
+    // Remove all Entities (necessary when changing level)
+    for (const auto& entity : m_entities)
+    {
+        delete entity;
+    }
+    m_map.clearMovingLights();
+    m_entities.clear();
+
+    std::vector<sf::Vector2u> spawnTiles;
+    LevelGenerator::getSpawnTiles(settings, spawnTiles);
+    for (const auto& spawnTile : spawnTiles)
+    {
+        m_entities.push_back(createEntity(EntityType::Player, m_map.tileIndexToCoords(spawnTile)));
+    }
+    std::cout << "Number of Entities: " << m_entities.size() << "\n\n";
+
+    m_camera.setBounds(static_cast<sf::Vector2f>(m_map.getBounds()));
+    if (m_isCreatorModeEnabled == false && !m_entities.empty())
+    {
+        m_camera.setFollow(*m_entities.front(), true);
+    }
+
+    std::cout << "Level successfully generated.\n\n";
+    return true;
+}
+
+// Save all Level components on the calling thread, overwriting the files in place (see saveInBackground())
 bool Level::save(const std::string& levelDirectory) const
 {
+    // Wait for a background save to the same files, its result being reported on the next update()
+    if (m_levelSaver != nullptr)
+    {
+        m_levelSaver->wait();
+    }
+
     std::cout << "\nSaving Level: " << levelDirectory << "\n\n";
-    // TODO
-    // check if dir exists
-    // if not, create it
-    // make temp copy and replace if everything works
 
-    if (m_map.save(levelDirectory + "/tiles.txt") && saveBackground(levelDirectory + "/background.txt") &&
+    if (m_map.saveBinary(levelDirectory + "/tiles.bin") && saveBackground(levelDirectory + "/background.txt") &&
         saveEntities(levelDirectory + "/entities.txt") && saveResources(levelDirectory + "/resources.txt"))
     {
         std::cout << "Level successfully saved.\n\n";
@@ -580,6 +685,57 @@ bool Level::save(const std::string& levelDirectory) const
     return false;
 }
 
+// Save all Level components on a worker thread from a snapshot taken now, so that the Level can be edited while it is saved
+// The Level directory is created if needed, and its files are only replaced once all of them are written
+// Levels with a streamed Map cannot be snapshotted, so they are saved by save() instead
+// Return false if the Level could not be saved, the result of a background save being known once isSaving() returns false
+bool Level::saveInBackground(const std::string& levelDirectory)
+{
+    finishSave();
+
+    LevelSnapshot snapshot;
+    if (m_map.takeSnapshot(snapshot.map, levelDirectory + "/tiles.bin") == false)
+    {
+        m_hasSaveFailed = save(levelDirectory) == false;
+        return m_hasSaveFailed == false;
+    }
+
+    std::cout << "\nSaving Level in the background: " << levelDirectory << "\n\n";
+    std::ostringstream backgroundOutput;
+    writeBackground(backgroundOutput);
+    snapshot.background = backgroundOutput.str();
+    std::ostringstream entitiesOutput;
+    writeEntities(entitiesOutput);
+    snapshot.entities = entitiesOutput.str();
+    addBackgroundAndEntityResources(snapshot.resources);
+
+    m_levelSaver.reset(new LevelSaver(levelDirectory, std::move(snapshot)));
+    m_hasSaveFailed = false;
+    return true;
+}
+
+// Wait for the Level being saved in the background, if any, and report whether it was saved
+void Level::finishSave()
+{
+    if (m_levelSaver == nullptr)
+    {
+        return;
+    }
+
+    m_hasSaveFailed = m_levelSaver->wait() == false;
+    if (m_hasSaveFailed == true)
+    {
+        // The Map's change journal assumed the save would succeed
+        m_map.onSnapshotSaveFailed(m_levelSaver->getLevelDirectory() + "/tiles.bin");
+        std::cout << "Failed to save Level.\n\n";
+    }
+    else
+    {
+        std::cout << "Level successfully saved.\n\n";
+    }
+    m_levelSaver.reset();
+}
+
 void Level::onWindowResize()
 {
     // Resize Camera to window dimensions
@@ -612,6 +768,7 @@ void Level::setCreatorModeEnabled(bool isCreatorModeEnabled)
 {
     m_isCreatorModeEnabled = isCreatorModeEnabled;
     m_map.setGridVisible(m_isCreatorModeEnabled);
+    m_map.setLayerBaked(MapLayer::Background, m_isCreatorModeEnabled == false); // The Background is edited in creator mode
     m_camera.setBoundless(m_isCreatorModeEnabled);
     if (m_isCreatorModeEnabled == true)
     {
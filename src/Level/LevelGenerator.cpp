@@ -0,0 +1,438 @@
+#include "Level/LevelGenerator.h"
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include "Core/FileManager.h"
+#include "Level/Entity.h"
+#include "Level/Map.h"
+#include "Level/MapFile.h"
+#include "Misc/Utility.h"
+
+namespace
+{
+    const std::uint16_t groundId = 104; // Autotiled (grass terrain set)
+    const std::uint16_t woodId = 150;
+    const std::uint16_t ladderId = 200;
+    const std::uint16_t ladderTopId = 201;
+    const std::uint16_t vineId = 500;
+
+    const float hillWavelength = 48; // In Tiles
+    const float maxHillAmplitude = 24;
+    const unsigned int caveDepth = 6; // Caves start this far below the surface
+    const float caveThreshold = 0.62f; // Fraction of the cave noise's range above which cells are carved
+    const float tunnelHalfWidth = 0.035f; // Tunnels are carved where the tunnel noise is this close to its median
+    const unsigned int ladderColumnSpacing = 23; // Average number of columns between two ladder shafts
+    const unsigned int minLadderDepth = caveDepth + 4;
+    const unsigned int maxLadderDepth = minLadderDepth + 40;
+    const unsigned int vineColumnSpacing = 3;
+    const unsigned int maxVineLength = 6;
+    const unsigned int platformLength = 6;
+    const unsigned int platformRowSpacing = 8;
+    const unsigned int platformSpacing = 5; // Average number of platform slots between two platforms of a row
+
+    const std::string parallaxSprites[] = {"parallaxMountains5 0.5", "parallaxMountains4 0.4", "parallaxMountains3 0.3",
+                                           "parallaxMountains2 0.2", "parallaxMountains1 0.1"};
+
+    // Hashes of distinct features are salted, so that they are not correlated
+    enum Salt : std::uint32_t
+    {
+        Surface = 1,
+        Caves = 16,
+        Tunnels = 32,
+        Ladders = 48,
+        LadderDepths,
+        Vines,
+        VineLengths,
+        Platforms,
+        Spawns
+    };
+
+    // Mix the bits of a 32-bit value (MurmurHash3 finalizer)
+    std::uint32_t mix(std::uint32_t h)
+    {
+        h ^= h >> 16;
+        h *= 0x85EBCA6B;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35;
+        h ^= h >> 16;
+        return h;
+    }
+
+    // Hash a seed, a salt, and integer coordinates into uniformly distributed bits
+    std::uint32_t hash(std::uint32_t seed, std::uint32_t salt, int x, int y = 0)
+    {
+        std::uint32_t h = mix(seed ^ (salt * 0x9E3779B9));
+        h = mix(h ^ (static_cast<std::uint32_t>(x) * 0x27D4EB2D));
+        return mix(h ^ (static_cast<std::uint32_t>(y) * 0x165667B1));
+    }
+
+    // Map a hash to [0, 1)
+    float getUnitValue(std::uint32_t h)
+    {
+        return static_cast<float>(h >> 8) / (1 << 24);
+    }
+
+    // Value noise in [0, 1): random values at integer coordinates, smoothly interpolated in between
+    float getValueNoise(std::uint32_t seed, std::uint32_t salt, float x, float y)
+    {
+        float floorX = std::floor(x);
+        float floorY = std::floor(y);
+        int left = static_cast<int>(floorX);
+        int top = static_cast<int>(floorY);
+        float tx = x - floorX;
+        float ty = y - floorY;
+        tx = tx * tx * (3 - 2 * tx);
+        ty = ty * ty * (3 - 2 * ty);
+
+        float topLeft = getUnitValue(hash(seed, salt, left, top));
+        float topRight = getUnitValue(hash(seed, salt, left + 1, top));
+        float bottomLeft = getUnitValue(hash(seed, salt, left, top + 1));
+        float bottomRight = getUnitValue(hash(seed, salt, left + 1, top + 1));
+        float topValue = topLeft + (topRight - topLeft) * tx;
+        float bottomValue = bottomLeft + (bottomRight - bottomLeft) * tx;
+        return topValue + (bottomValue - topValue) * ty;
+    }
+
+    // Sum octaves of value noise, each of twice the frequency and half the amplitude of the previous one, normalized to [0, 1)
+    float getFractalNoise(std::uint32_t seed, std::uint32_t salt, float x, float y, unsigned int octaveCount)
+    {
+        float sum = 0;
+        float amplitude = 1;
+        float amplitudeSum = 0;
+        for (unsigned int octave = 0; octave < octaveCount; octave++)
+        {
+            sum += getValueNoise(seed, salt + octave, x, y) * amplitude;
+            amplitudeSum += amplitude;
+            amplitude /= 2;
+            x *= 2;
+            y *= 2;
+        }
+        return sum / amplitudeSum;
+    }
+
+    // Return the row of the topmost ground Tile of a column
+    int getSurfaceY(const LevelGenerator::Settings& settings, int x)
+    {
+        float height = static_cast<float>(settings.dimensions.y);
+        float amplitude = std::min(height / 8, maxHillAmplitude);
+        float noise = getFractalNoise(settings.seed, Salt::Surface, x / hillWavelength, 0, 4);
+        int surfaceY = static_cast<int>(height / 4 + (noise - 0.5f) * 4 * amplitude);
+        return std::max(2, std::min(surfaceY, static_cast<int>(settings.dimensions.y / 2)));
+    }
+
+    // Return true if a column has a ladder shaft going down from the surface
+    bool isLadderColumn(const LevelGenerator::Settings& settings, int x)
+    {
+        return x > 0 && x < static_cast<int>(settings.dimensions.x) - 1 && hash(settings.seed, Salt::Ladders, x) % ladderColumnSpacing == 0;
+    }
+
+    // Return the TileType id of a cell of the Solid layer, vines excepted, given the surface row of its column
+    // Ground is carved by caves (blobs) and tunnels (thin bands) below the surface, and by ladder shafts from the surface
+    std::uint16_t getTerrainId(const LevelGenerator::Settings& settings, int x, int y, int surfaceY)
+    {
+        if (y < surfaceY)
+        {
+            return 0;
+        }
+
+        if (isLadderColumn(settings, x) == true)
+        {
+            int depth = static_cast<int>(minLadderDepth + hash(settings.seed, Salt::LadderDepths, x) % (maxLadderDepth - minLadderDepth));
+            if (y < std::min(surfaceY + depth, static_cast<int>(settings.dimensions.y) - 1))
+            {
+                return y == surfaceY ? ladderTopId : ladderId;
+            }
+        }
+
+        // The bottom row is left solid so that Entities cannot fall out of the Map
+        if (y < surfaceY + static_cast<int>(caveDepth) || y >= static_cast<int>(settings.dimensions.y) - 1)
+        {
+            return groundId;
+        }
+        bool isCave = getFractalNoise(settings.seed, Salt::Caves, x / 20.f, y / 14.f, 3) > caveThreshold ||
+                      std::abs(getFractalNoise(settings.seed, Salt::Tunnels, x / 40.f, y / 24.f, 2) - 0.5f) < tunnelHalfWidth;
+        if (isCave == false)
+        {
+            return groundId;
+        }
+
+        // Wooden platforms are laid on some rows of the caves
+        bool isPlatform = y % platformRowSpacing == 0 &&
+                          hash(settings.seed, Salt::Platforms, x / static_cast<int>(platformLength), y) % platformSpacing == 0;
+        return isPlatform == true ? woodId : 0;
+    }
+
+    // Generate the Background and Solid chunks at a chunk position, either being nullptr if it has no Tiles
+    // The terrain is generated with a margin around the chunk, for autotiling and for the vines hanging into it
+    void generateChunks(const LevelGenerator::Settings& settings, const TileRegistry& tileRegistry, const Autotiler& autotiler,
+                        unsigned int chunkX, unsigned int chunkY, std::unique_ptr<TileLayer::Chunk>& background,
+                        std::unique_ptr<TileLayer::Chunk>& solid)
+    {
+        const int chunkSize = static_cast<int>(TileLayer::chunkSize);
+        const int marginTop = static_cast<int>(maxVineLength);
+        const int gridWidth = chunkSize + 2;
+        const int gridHeight = marginTop + chunkSize + 1;
+        const int left = static_cast<int>(chunkX) * chunkSize;
+        const int top = static_cast<int>(chunkY) * chunkSize;
+        const int width = static_cast<int>(settings.dimensions.x);
+        const int height = static_cast<int>(settings.dimensions.y);
+
+        // Cells outside of the Map are solid, as for autotiling
+        int surfaceYs[chunkSize + 2];
+        for (int gridX = 0; gridX < gridWidth; gridX++)
+        {
+            int x = left + gridX - 1;
+            surfaceYs[gridX] = x >= 0 && x < width ? getSurfaceY(settings, x) : 0;
+        }
+        std::vector<std::uint16_t> terrain(gridWidth * gridHeight, groundId);
+        for (int gridY = 0; gridY < gridHeight; gridY++)
+        {
+            int y = top + gridY - marginTop;
+            for (int gridX = 0; gridX < gridWidth; gridX++)
+            {
+                int x = left + gridX - 1;
+                if (x >= 0 && x < width && y >= 0 && y < height)
+                {
+                    terrain[gridY * gridWidth + gridX] = getTerrainId(settings, x, y, surfaceYs[gridX]);
+                }
+            }
+        }
+
+        auto getTerrain = [&terrain, left, top, marginTop, gridWidth](unsigned int x, unsigned int y)
+        {
+            return terrain[(static_cast<int>(y) - top + marginTop) * gridWidth + static_cast<int>(x) - left + 1];
+        };
+        auto isSolid = [&tileRegistry, &getTerrain](unsigned int x, unsigned int y)
+        {
+            return tileRegistry.getDef(getTerrain(x, y)).isSolid();
+        };
+        auto isBackgroundSolid = [&surfaceYs, left](unsigned int x, unsigned int y)
+        {
+            return static_cast<int>(y) >= surfaceYs[static_cast<int>(x) - left + 1];
+        };
+        auto setCell = [](std::unique_ptr<TileLayer::Chunk>& chunk, int localX, int localY, std::uint16_t id)
+        {
+            if (chunk == nullptr)
+            {
+                chunk.reset(new TileLayer::Chunk);
+                chunk->cells.fill(TileCell{0, 0});
+                chunk->tileCount = 0;
+            }
+            chunk->cells[localY * TileLayer::chunkSize + localX] = TileCell{id, 0};
+            chunk->tileCount++;
+        };
+
+        for (int y = top; y < std::min(top + chunkSize, height); y++)
+        {
+            for (int x = left; x < std::min(left + chunkSize, width); x++)
+            {
+                // The Background layer is ground wherever the Solid layer is below the surface
+                if (isBackgroundSolid(x, y) == true)
+                {
+                    std::uint16_t backgroundId = autotiler.getAutotiledId(groundId, x, y, settings.dimensions, isBackgroundSolid);
+                    setCell(background, x - left, y - top, backgroundId);
+                }
+
+                std::uint16_t id = getTerrain(x, y);
+                if (id == 0 && hash(settings.seed, Salt::Vines, x) % vineColumnSpacing == 0)
+                {
+                    // Vines hang from the ground above caves, if it is close enough
+                    int length = 1 + static_cast<int>(hash(settings.seed, Salt::VineLengths, x) % maxVineLength);
+                    for (int ceilingY = y - 1; ceilingY >= std::max(y - length, 0); ceilingY--)
+                    {
+                        std::uint16_t ceilingId = getTerrain(x, ceilingY);
+                        if (ceilingId != 0)
+                        {
+                            id = ceilingId == groundId ? vineId : 0;
+                            break;
+                        }
+                    }
+                }
+                if (id != 0)
+                {
+                    setCell(solid, x - left, y - top, autotiler.getAutotiledId(id, x, y, settings.dimensions, isSolid));
+                }
+            }
+        }
+    }
+
+    // Write a text file, returning false if it could not be written
+    bool writeFile(const std::string& filename, const std::string& content)
+    {
+        std::ofstream outputFile(FileManager::resourcePath() + filename);
+        if (outputFile)
+        {
+            outputFile << content;
+            return static_cast<bool>(outputFile);
+        }
+        return false;
+    }
+} // namespace
+
+// Return the default Settings for a size of Level, with one Entity per 8 columns
+LevelGenerator::Settings LevelGenerator::getDefaultSettings(const sf::Vector2u& dimensions, std::uint32_t seed)
+{
+    return Settings{dimensions, seed, std::max(dimensions.x / 8, 1u), 64};
+}
+
+// Return true if Levels can be generated with the Settings, which must fit in a Map
+bool LevelGenerator::areSettingsValid(const Settings& settings)
+{
+    return settings.dimensions.x > 0 && settings.dimensions.y > 0 && settings.dimensions.x <= Map::maxDimensions.x &&
+           settings.dimensions.y <= Map::maxDimensions.y && settings.tileSize > 0;
+}
+
+// Generate the Background and Solid layers of a Level (the Overlay layer is left empty), with their Tiles already autotiled
+// Chunks are generated in parallel, then installed in the layers, which are resized to the Level's dimensions
+void LevelGenerator::generateLayers(const Settings& settings, const TileRegistry& tileRegistry, const Autotiler& autotiler,
+                                    std::vector<TileLayer>& layers)
+{
+    layers.assign(static_cast<std::size_t>(MapLayer::Count), TileLayer());
+    for (auto& layer : layers)
+    {
+        layer.resize(settings.dimensions);
+    }
+
+    const sf::Vector2u& chunkCounts = layers[0].getChunkCounts();
+    std::size_t chunkCount = static_cast<std::size_t>(chunkCounts.x) * chunkCounts.y;
+    std::vector<std::unique_ptr<TileLayer::Chunk>> backgroundChunks(chunkCount);
+    std::vector<std::unique_ptr<TileLayer::Chunk>> solidChunks(chunkCount);
+    Utility::runParallel(chunkCount, [&](std::size_t chunkIndex)
+    {
+        generateChunks(settings, tileRegistry, autotiler, static_cast<unsigned int>(chunkIndex % chunkCounts.x),
+                       static_cast<unsigned int>(chunkIndex / chunkCounts.x), backgroundChunks[chunkIndex], solidChunks[chunkIndex]);
+    });
+
+    TileLayer& background = layers[static_cast<std::size_t>(MapLayer::Background)];
+    TileLayer& solid = layers[static_cast<std::size_t>(MapLayer::Solid)];
+    for (std::size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
+    {
+        unsigned int chunkX = static_cast<unsigned int>(chunkIndex % chunkCounts.x);
+        unsigned int chunkY = static_cast<unsigned int>(chunkIndex / chunkCounts.x);
+        background.setChunk(chunkX, chunkY, std::move(backgroundChunks[chunkIndex]));
+        solid.setChunk(chunkX, chunkY, std::move(solidChunks[chunkIndex]));
+    }
+}
+
+// Write the Tiles where Entities spawn to spawnTiles, each being the top of two empty cells standing on the surface
+void LevelGenerator::getSpawnTiles(const Settings& settings, std::vector<sf::Vector2u>& spawnTiles)
+{
+    spawnTiles.clear();
+    for (unsigned int i = 0; i < settings.entityCount; i++)
+    {
+        int x = static_cast<int>(hash(settings.seed, Salt::Spawns, static_cast<int>(i)) % settings.dimensions.x);
+        spawnTiles.push_back(sf::Vector2u(static_cast<unsigned int>(x), static_cast<unsigned int>(getSurfaceY(settings, x) - 2)));
+    }
+}
+
+// Generate a Level and save it to a Level directory (binary Map, background, Entities, and resources), loading no texture
+bool LevelGenerator::saveLevel(const std::string& levelDirectory, const Settings& settings)
+{
+    if (areSettingsValid(settings) == false)
+    {
+        std::cerr << "LevelGenerator error: Levels must be from 1x1 to " << Map::maxDimensions.x << 'x' << Map::maxDimensions.y
+                  << " Tiles.\n"
+                  << "Level generation failed.\n\n";
+        return false;
+    }
+
+    std::cout << "\nGenerating Level: " << levelDirectory << "\n\n";
+    std::cout << "Dimensions:\t" << settings.dimensions.x << 'x' << settings.dimensions.y << '\n';
+    std::cout << "Seed:\t\t" << settings.seed << '\n';
+
+    TileRegistry tileRegistry(Map::maxTileTypeId + 1);
+    Autotiler autotiler(Map::maxTileTypeId + 1);
+    if (tileRegistry.load("data/levels/tile_defs.txt") == false || autotiler.load("data/levels/autotile_rules.txt") == false)
+    {
+        std::cerr << "LevelGenerator error: Unable to load the TileType definitions.\n"
+                  << "Level generation failed.\n\n";
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<TileLayer> layers;
+    generateLayers(settings, tileRegistry, autotiler, layers);
+    std::vector<sf::Vector2u> spawnTiles;
+    getSpawnTiles(settings, spawnTiles);
+    auto generationTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    std::cout << "Generated in:\t" << generationTime.count() << " ms\n";
+
+    // Background
+    std::ostringstream background;
+    background << "# Syntax:\n"
+                  "# resourceName parallaxValue pos:[TL|TM|TR|ML|MM|MR|BL|BM|BR] repeatTexture[-o]:[XY|X|Y] "
+                  "scale[-o]:[x,y|map] offset[-o]:x,y\n\n";
+    std::set<std::string> resources;
+    for (const auto& parallaxSprite : parallaxSprites)
+    {
+        background << parallaxSprite << " repeatTexture:X positionMode:BM\n";
+        resources.insert(parallaxSprite.substr(0, parallaxSprite.find(' ')));
+    }
+
+    // Entities
+    std::ostringstream entities;
+    entities << spawnTiles.size() << '\n';
+    for (const auto& spawnTile : spawnTiles)
+    {
+        entities << static_cast<int>(EntityType::Player) << ' ' << spawnTile.x * settings.tileSize << ' '
+                 << spawnTile.y * settings.tileSize << '\n';
+    }
+    if (spawnTiles.empty() == false)
+    {
+        for (const auto& textureName : Entity::getTextureNames(EntityType::Player))
+        {
+            resources.insert(textureName);
+        }
+    }
+
+    // Resources (textures of the TileTypes used)
+    std::bitset<Map::maxTileTypeId + 1> isUsed;
+    for (const auto& layer : layers)
+    {
+        for (unsigned int chunkY = 0; chunkY < layer.getChunkCounts().y; chunkY++)
+        {
+            for (unsigned int chunkX = 0; chunkX < layer.getChunkCounts().x; chunkX++)
+            {
+                const TileLayer::Chunk* chunk = layer.getChunk(chunkX, chunkY);
+                for (std::size_t i = 0; chunk != nullptr && i < chunk->cells.size(); i++)
+                {
+                    isUsed[chunk->cells[i].id] = true;
+                }
+            }
+        }
+    }
+    for (std::uint16_t id = 1; id <= Map::maxTileTypeId; id++)
+    {
+        if (isUsed[id] == true && tileRegistry.getDef(id).textureName.empty() == false)
+        {
+            resources.insert(tileRegistry.getDef(id).textureName);
+        }
+    }
+    std::string resourceList;
+    for (const auto& resource : resources)
+    {
+        resourceList += resource + '\n';
+    }
+
+    auto getChunk = [&layers](unsigned int z, unsigned int chunkX, unsigned int chunkY) { return layers[z].getChunk(chunkX, chunkY); };
+    if (FileManager::createDirectory(levelDirectory) == true &&
+        MapFile::save(levelDirectory + "/tiles.bin", settings.dimensions, settings.tileSize, static_cast<unsigned int>(layers.size()),
+                      getChunk) == true &&
+        writeFile(levelDirectory + "/background.txt", background.str()) == true &&
+        writeFile(levelDirectory + "/entities.txt", entities.str()) == true &&
+        writeFile(levelDirectory + "/resources.txt", resourceList) == true)
+    {
+        std::cout << "Level successfully generated.\n\n";
+        return true;
+    }
+
+    std::cerr << "LevelGenerator error: Unable to save \"" << levelDirectory << "\".\n"
+              << "Level generation failed.\n\n";
+    return false;
+}
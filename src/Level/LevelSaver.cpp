@@ -0,0 +1,89 @@
+#include "Level/LevelSaver.h"
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include "Core/FileManager.h"
+
+namespace
+{
+    const std::string tempDirectoryName = ".saving";
+    const std::array<const char*, 4> levelFilenames = {{"tiles.bin", "background.txt", "entities.txt", "resources.txt"}};
+    const float mapProgressShare = 0.9f; // Fraction of the progress spent saving the Map, the other files being small
+} // namespace
+
+LevelSaver::LevelSaver(const std::string& levelDirectory, LevelSnapshot snapshot)
+    : m_snapshot(std::move(snapshot))
+    , m_levelDirectory(levelDirectory)
+    , m_progress(0)
+    , m_isDone(false)
+    , m_isSaved(false)
+{
+    m_thread = std::thread(&LevelSaver::worker, this);
+}
+
+LevelSaver::~LevelSaver()
+{
+    wait();
+}
+
+// Write every file to the temporary directory, then rename them into the Level directory
+void LevelSaver::worker()
+{
+    std::string tempDirectory = m_levelDirectory + '/' + tempDirectoryName;
+    auto onMapProgress = [this](float progress) { m_progress = progress * mapProgressShare; };
+
+    Map::addTextureNames(m_snapshot.map, m_snapshot.resources);
+    std::string resources;
+    for (const auto& resource : m_snapshot.resources)
+    {
+        resources += resource + '\n';
+    }
+
+    bool isWritten = FileManager::createDirectory(m_levelDirectory) == true && FileManager::createDirectory(tempDirectory) == true &&
+                     Map::saveSnapshot(m_snapshot.map, tempDirectory + "/tiles.bin", onMapProgress) == true &&
+                     writeFile(tempDirectory + "/background.txt", m_snapshot.background) == true &&
+                     writeFile(tempDirectory + "/entities.txt", m_snapshot.entities) == true &&
+                     writeFile(tempDirectory + "/resources.txt", resources) == true;
+    m_progress = mapProgressShare + (1 - mapProgressShare) / 2;
+
+    // Files which were not renamed into place (all of them if one could not be written) are removed with the temporary directory
+    bool isSaved = isWritten;
+    for (const auto& filename : levelFilenames)
+    {
+        std::string tempFilename = tempDirectory + '/' + filename;
+        if (isSaved == true && FileManager::replaceFile(tempFilename, m_levelDirectory + '/' + filename) == false)
+        {
+            std::cerr << "LevelSaver error: Unable to replace \"" << m_levelDirectory << '/' << filename << "\".\n";
+            isSaved = false;
+        }
+        std::remove((FileManager::resourcePath() + tempFilename).c_str());
+    }
+    FileManager::removeDirectory(tempDirectory);
+    if (isWritten == false)
+    {
+        std::cerr << "LevelSaver error: Unable to write \"" << m_levelDirectory << "\".\n";
+    }
+
+    m_isSaved = isSaved;
+    m_progress = 1;
+    m_isDone = true;
+}
+
+// Write a text file
+bool LevelSaver::writeFile(const std::string& filename, const std::string& contents) const
+{
+    std::ofstream outputFile(FileManager::resourcePath() + filename);
+    return outputFile && outputFile.write(contents.data(), contents.size());
+}
+
+// Wait until the Level is saved, returning true if all of its files were replaced
+bool LevelSaver::wait()
+{
+    if (m_thread.joinable() == true)
+    {
+        m_thread.join();
+    }
+    return m_isSaved;
+}
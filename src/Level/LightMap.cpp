@@ -0,0 +1,345 @@
+#include "Level/LightMap.h"
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    // Return the smallest rectangle containing two rectangles
+    sf::IntRect getBoundingRect(const sf::IntRect& a, const sf::IntRect& b)
+    {
+        int left = std::min(a.left, b.left);
+        int top = std::min(a.top, b.top);
+        int right = std::max(a.left + a.width, b.left + b.width);
+        int bottom = std::max(a.top + a.height, b.top + b.height);
+        return sf::IntRect(left, top, right - left, bottom - top);
+    }
+
+    // Return the number of cells flood filled to recompute a dirty rectangle, its window extending lightRadius around it
+    long getWindowArea(const sf::IntRect& rect)
+    {
+        return static_cast<long>(rect.width + 2 * LightMap::lightRadius) * (rect.height + 2 * LightMap::lightRadius);
+    }
+
+    // Return true if a rectangle lies entirely inside another one
+    bool containsRect(const sf::IntRect& outer, const sf::IntRect& inner)
+    {
+        return inner.left >= outer.left && inner.top >= outer.top && inner.left + inner.width <= outer.left + outer.width &&
+               inner.top + inner.height <= outer.top + outer.height;
+    }
+} // namespace
+
+LightMap::LightMap()
+    : m_dimensions(0, 0)
+    , m_chunkCounts(0, 0)
+    , m_updatedCellCount(0)
+{
+}
+
+// Return the cells whose level may change when a range of cells changes (those within lightRadius of it), clamped to the Map
+sf::IntRect LightMap::getDirtyRect(const sf::Vector2u& tileIndex, const sf::Vector2u& range) const
+{
+    int left = std::max(static_cast<int>(tileIndex.x) - static_cast<int>(lightRadius), 0);
+    int top = std::max(static_cast<int>(tileIndex.y) - static_cast<int>(lightRadius), 0);
+    int right = std::min(static_cast<int>(tileIndex.x + range.x + lightRadius), static_cast<int>(m_dimensions.x));
+    int bottom = std::min(static_cast<int>(tileIndex.y + range.y + lightRadius), static_cast<int>(m_dimensions.y));
+    return sf::IntRect(left, top, std::max(right - left, 0), std::max(bottom - top, 0));
+}
+
+// Resize the light map, removing all light levels and Tile lights, and marking every cell dirty (moving lights are kept)
+void LightMap::resize(const sf::Vector2u& dimensions)
+{
+    m_dimensions = dimensions;
+    m_chunkCounts = sf::Vector2u((dimensions.x + TileLayer::chunkSize - 1) / TileLayer::chunkSize,
+                                 (dimensions.y + TileLayer::chunkSize - 1) / TileLayer::chunkSize);
+    std::size_t chunkCount = static_cast<std::size_t>(m_chunkCounts.x) * m_chunkCounts.y;
+    m_levelChunks.clear();
+    m_levelChunks.resize(chunkCount);
+    m_tileLights.clear();
+    m_tileLights.resize(chunkCount);
+
+    m_dirtyRects.clear();
+    if (dimensions.x > 0 && dimensions.y > 0)
+    {
+        m_dirtyRects.push_back(sf::IntRect(0, 0, dimensions.x, dimensions.y));
+    }
+}
+
+// Mark the cells whose level may change after a change to a range of cells (its lights or its solidity)
+void LightMap::setDirty(const sf::Vector2u& tileIndex, const sf::Vector2u& range)
+{
+    sf::IntRect dirtyRect = getDirtyRect(tileIndex, range);
+    if (dirtyRect.width == 0 || dirtyRect.height == 0)
+    {
+        return;
+    }
+    for (const auto& rect : m_dirtyRects)
+    {
+        if (containsRect(rect, dirtyRect) == true)
+        {
+            return;
+        }
+    }
+    m_dirtyRects.push_back(dirtyRect);
+}
+
+// Recompute the levels of the dirty cells, merging dirty rectangles when recomputing them together costs no more than separately,
+// or recomputing every cell if that costs less
+void LightMap::update(const SolidityMask& solidityMask)
+{
+    m_updatedCellCount = 0;
+    if (m_dirtyRects.empty() == true)
+    {
+        return;
+    }
+
+    std::vector<sf::IntRect> rects;
+    for (const auto& dirtyRect : m_dirtyRects)
+    {
+        bool isMerged = false;
+        for (auto& rect : rects)
+        {
+            sf::IntRect boundingRect = getBoundingRect(rect, dirtyRect);
+            if (getWindowArea(boundingRect) <= getWindowArea(rect) + getWindowArea(dirtyRect))
+            {
+                rect = boundingRect;
+                isMerged = true;
+                break;
+            }
+        }
+        if (isMerged == false)
+        {
+            rects.push_back(dirtyRect);
+        }
+    }
+    m_dirtyRects.clear();
+
+    // Past a point, recomputing the whole Map at once is cheaper
+    long windowArea = 0;
+    for (const auto& rect : rects)
+    {
+        windowArea += getWindowArea(rect);
+    }
+    if (windowArea >= static_cast<long>(m_dimensions.x) * m_dimensions.y)
+    {
+        rects.assign(1, sf::IntRect(0, 0, m_dimensions.x, m_dimensions.y));
+    }
+
+    for (const auto& rect : rects)
+    {
+        recomputeRect(rect, solidityMask);
+    }
+}
+
+// Recompute the levels of a rectangle of cells from the lights within lightRadius of it, flood filling a window around it
+// Light is spread a level at a time from the brightest cells, so that each cell spreads light once, at its final level
+void LightMap::recomputeRect(const sf::IntRect& rect, const SolidityMask& solidityMask)
+{
+    sf::IntRect window = getDirtyRect(sf::Vector2u(rect.left, rect.top), sf::Vector2u(rect.width, rect.height));
+    unsigned int windowWidth = static_cast<unsigned int>(window.width);
+    m_windowLevels.assign(static_cast<std::size_t>(window.width) * window.height, 0);
+
+    auto addLight = [this, &window, windowWidth](const PointLight& light)
+    {
+        int x = static_cast<int>(light.tileIndex.x) - window.left;
+        int y = static_cast<int>(light.tileIndex.y) - window.top;
+        if (light.level == 0 || x < 0 || y < 0 || x >= window.width || y >= window.height)
+        {
+            return;
+        }
+        std::uint32_t cellIndex = static_cast<std::uint32_t>(y) * windowWidth + static_cast<std::uint32_t>(x);
+        std::uint8_t level = std::min(light.level, maxLightLevel);
+        if (level > m_windowLevels[cellIndex])
+        {
+            m_windowLevels[cellIndex] = level;
+            m_queues[level].push_back(cellIndex);
+        }
+    };
+
+    unsigned int chunkRight = (window.left + window.width - 1) >> TileLayer::chunkSizeLog2;
+    unsigned int chunkBottom = (window.top + window.height - 1) >> TileLayer::chunkSizeLog2;
+    for (unsigned int chunkY = window.top >> TileLayer::chunkSizeLog2; chunkY <= chunkBottom; chunkY++)
+    {
+        for (unsigned int chunkX = window.left >> TileLayer::chunkSizeLog2; chunkX <= chunkRight; chunkX++)
+        {
+            for (const auto& light : m_tileLights[chunkY * m_chunkCounts.x + chunkX])
+            {
+                addLight(light);
+            }
+        }
+    }
+    for (const auto& light : m_movingLights)
+    {
+        addLight(light);
+    }
+
+    // Solid cells are lit, but only spread light if they emit it
+    for (std::uint8_t level = maxLightLevel; level > 1; level--)
+    {
+        std::uint8_t neighbourLevel = level - 1;
+        for (std::uint32_t cellIndex : m_queues[level])
+        {
+            if (m_windowLevels[cellIndex] != level)
+            {
+                continue;
+            }
+
+            unsigned int x = cellIndex % windowWidth;
+            unsigned int y = cellIndex / windowWidth;
+            auto spreadTo = [&](unsigned int neighbourX, unsigned int neighbourY)
+            {
+                std::uint32_t neighbourIndex = neighbourY * windowWidth + neighbourX;
+                if (m_windowLevels[neighbourIndex] < neighbourLevel)
+                {
+                    m_windowLevels[neighbourIndex] = neighbourLevel;
+                    if (solidityMask.isSolid(window.left + neighbourX, window.top + neighbourY) == false)
+                    {
+                        m_queues[neighbourLevel].push_back(neighbourIndex);
+                    }
+                }
+            };
+            if (x > 0)
+            {
+                spreadTo(x - 1, y);
+            }
+            if (x < windowWidth - 1)
+            {
+                spreadTo(x + 1, y);
+            }
+            if (y > 0)
+            {
+                spreadTo(x, y - 1);
+            }
+            if (y < static_cast<unsigned int>(window.height) - 1)
+            {
+                spreadTo(x, y + 1);
+            }
+        }
+        m_queues[level].clear();
+    }
+    m_queues[1].clear();
+
+    // Only the cells of the rectangle are written, those around it lacking the lights beyond the window
+    for (int y = rect.top; y < rect.top + rect.height; y++)
+    {
+        const std::uint8_t* windowRow = &m_windowLevels[static_cast<std::size_t>(y - window.top) * windowWidth];
+        for (int x = rect.left; x < rect.left + rect.width; x++)
+        {
+            std::uint8_t level = windowRow[x - window.left];
+            std::unique_ptr<LevelChunk>& chunk = m_levelChunks[(y >> TileLayer::chunkSizeLog2) * m_chunkCounts.x +
+                                                               (x >> TileLayer::chunkSizeLog2)];
+            if (chunk == nullptr)
+            {
+                if (level == 0)
+                {
+                    continue;
+                }
+                chunk.reset(new LevelChunk);
+                chunk->fill(0);
+            }
+            (*chunk)[(y & (TileLayer::chunkSize - 1)) * TileLayer::chunkSize + (x & (TileLayer::chunkSize - 1))] = level;
+        }
+    }
+    m_updatedCellCount += static_cast<std::size_t>(rect.width) * rect.height;
+}
+
+// Set the light emitted by the Tiles of a cell (0 if none), marking the cells it reaches dirty if it changed
+void LightMap::setTileLight(unsigned int x, unsigned int y, std::uint8_t level)
+{
+    if (x >= m_dimensions.x || y >= m_dimensions.y)
+    {
+        return;
+    }
+
+    std::vector<PointLight>& lights = m_tileLights[(y >> TileLayer::chunkSizeLog2) * m_chunkCounts.x + (x >> TileLayer::chunkSizeLog2)];
+    auto isAtCell = [x, y](const PointLight& light) { return light.tileIndex.x == x && light.tileIndex.y == y; };
+    auto it = std::find_if(lights.begin(), lights.end(), isAtCell);
+    if (it != lights.end())
+    {
+        if (it->level == level)
+        {
+            return;
+        }
+        if (level == 0)
+        {
+            lights.erase(it);
+        }
+        else
+        {
+            it->level = level;
+        }
+    }
+    else if (level == 0)
+    {
+        return;
+    }
+    else
+    {
+        lights.push_back(PointLight{sf::Vector2u(x, y), level});
+    }
+    setDirty(sf::Vector2u(x, y));
+}
+
+// Replace the lights of the Tiles of a chunk (e.g. when it is loaded), marking the cells they reach dirty if they changed
+void LightMap::setChunkTileLights(unsigned int chunkX, unsigned int chunkY, std::vector<PointLight> lights)
+{
+    std::vector<PointLight>& chunkLights = m_tileLights[chunkY * m_chunkCounts.x + chunkX];
+    auto isSameLight = [](const PointLight& a, const PointLight& b) { return a.tileIndex == b.tileIndex && a.level == b.level; };
+    bool isChanged = lights.size() != chunkLights.size() ||
+                     std::equal(lights.begin(), lights.end(), chunkLights.begin(), isSameLight) == false;
+    if (isChanged == true)
+    {
+        chunkLights = std::move(lights);
+        setDirty(sf::Vector2u(chunkX * TileLayer::chunkSize, chunkY * TileLayer::chunkSize),
+                 sf::Vector2u(TileLayer::chunkSize, TileLayer::chunkSize));
+    }
+}
+
+// Set a moving light (e.g. carried by an Entity), marking the cells it reached and those it reaches dirty if it moved or changed
+void LightMap::setMovingLight(std::size_t id, const PointLight& light)
+{
+    if (id >= m_movingLights.size())
+    {
+        m_movingLights.resize(id + 1, PointLight{sf::Vector2u(0, 0), 0});
+    }
+
+    PointLight& movingLight = m_movingLights[id];
+    if (movingLight.level == light.level && (light.level == 0 || movingLight.tileIndex == light.tileIndex))
+    {
+        return;
+    }
+    if (movingLight.level > 0)
+    {
+        setDirty(movingLight.tileIndex);
+    }
+    if (light.level > 0)
+    {
+        setDirty(light.tileIndex);
+    }
+    movingLight = light;
+}
+
+// Remove all moving lights, marking the cells they reached dirty
+void LightMap::clearMovingLights()
+{
+    for (const auto& light : m_movingLights)
+    {
+        if (light.level > 0)
+        {
+            setDirty(light.tileIndex);
+        }
+    }
+    m_movingLights.clear();
+}
+
+// Return the approximate memory used by the light levels and lights, in bytes
+std::size_t LightMap::getMemoryUsage() const
+{
+    std::size_t bytes = m_levelChunks.capacity() * sizeof(std::unique_ptr<LevelChunk>) +
+                        m_tileLights.capacity() * sizeof(std::vector<PointLight>) + m_movingLights.capacity() * sizeof(PointLight);
+    for (std::size_t i = 0; i < m_levelChunks.size(); i++)
+    {
+        bytes += m_levelChunks[i] != nullptr ? sizeof(LevelChunk) : 0;
+        bytes += m_tileLights[i].capacity() * sizeof(PointLight);
+    }
+    return bytes + m_windowLevels.capacity();
+}
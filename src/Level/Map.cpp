@@ -1,35 +1,131 @@
 #include "Level/Map.h"
+#include <algorithm>
+#include <bitset>
 #include <cctype>
 #include <cmath>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <sstream>
 #include "Core/FileManager.h"
+#include "Level/ChunkStreamer.h"
+#include "Level/MapFile.h"
 #include "Level/Tile.h"
+#include "Misc/Utility.h"
 
 namespace
 {
-    const sf::Vector2f maxDimensions(4096, 4096);
+    const std::size_t maxMeshVertexCount = 1 << 20; // Above this, meshes of chunks that are not visible are released
+    const std::size_t maxBakedChunkCount = 16; // Above this, baked chunks that are not visible are evicted
+    const std::size_t maxFreeRenderTextureCount = 4;
+    const float maxLodTilePixelSize = 16; // Tiles drawn smaller than this (in pixels) are drawn from downsampled chunks
+    const std::size_t maxLodChunkCount = 64; // Above this, downsampled chunks that are not visible are evicted
+    const unsigned int maxLodChunkBuildsPerFrame = 2;
+    const float gridLineThickness = 2;
+    const float minGridLinePixelSize = 2; // The grid is not drawn when zoomed out so far that its lines would be thinner
+    const std::size_t minStreamedCellCount = 1 << 20; // Binary Maps with fewer cells are fully loaded even if streaming is allowed
+    const float streamingLookaheadTicks = 30; // The view's velocity is extrapolated this far to load chunks before they are visible
+    const std::size_t minParallelCellCount = 1 << 16; // Text Maps with fewer cells are parsed on the loading thread only
+
+    // Return the key of a baked chunk
+    std::uint64_t getBakedChunkKey(unsigned int z, std::size_t chunkIndex)
+    {
+        return static_cast<std::uint64_t>(z) << 32 | chunkIndex;
+    }
+
+    // Return true for the characters separating the tokens of a text Map (those skipped by operator>>)
+    bool isSeparator(char c)
+    {
+        return std::isspace(static_cast<unsigned char>(c)) != 0;
+    }
+
+    // Parse a row of a text Map held on one line into TileType ids (0 for empty cells), reading its tokens like Map::parseLayers()
+    // Returns false if a token is not a TileType id, or if the row's tokens do not end exactly with the line
+    bool parseRow(const char* begin, const char* end, unsigned int width, std::uint16_t* ids)
+    {
+        const char* it = begin;
+        for (unsigned int x = 0; x < width; x++)
+        {
+            while (it != end && isSeparator(*it) == true)
+            {
+                it++;
+            }
+            const char* tokenEnd = it;
+            while (tokenEnd != end && isSeparator(*tokenEnd) == false)
+            {
+                tokenEnd++;
+            }
+
+            // A semicolon leaves the rest of the row empty
+            if (tokenEnd - it == 1 && *it == ';')
+            {
+                std::fill(ids + x, ids + width, 0);
+                it = tokenEnd;
+                break;
+            }
+            if (it == tokenEnd || tokenEnd - it > 3)
+            {
+                return false;
+            }
+
+            std::uint16_t id = 0;
+            for (; it != tokenEnd; it++)
+            {
+                if (*it < '0' || *it > '9')
+                {
+                    return false;
+                }
+                id = static_cast<std::uint16_t>(id * 10 + (*it - '0'));
+            }
+            ids[x] = id;
+        }
+
+        while (it != end && isSeparator(*it) == true)
+        {
+            it++;
+        }
+        return it == end;
+    }
 } // namespace
 
+constexpr std::size_t Map::maxTileTypeId;
+const sf::Vector2u Map::maxDimensions(16384, 16384);
+
 Map::Map(const ResourceManager& resourceManager)
     : m_resourceManager(resourceManager)
+    , m_tileRegistry(maxTileTypeId + 1)
+    , m_autotiler(maxTileTypeId + 1)
+    , m_ambientLightLevel(LightMap::maxLightLevel)
+    , m_meshVertexCount(0)
+    , m_frameCount(0)
+    , m_drawCallCount(0)
+    , m_lodChunkBuildCount(0)
+    , m_drawnTileCount(0)
+    , m_occludedTileCount(0)
+    , m_animationTick(0)
+    , m_editDepth(0)
+    , m_streamingLoadRadius(1)
+    , m_streamingEvictRadius(3)
     , m_indexDimensions(0, 0)
     , m_layerCount(static_cast<unsigned int>(MapLayer::Count))
     , m_tileSize(64)
     , m_isGridVisible(false)
 {
-    m_tiles.resize(m_layerCount);
+    m_layers.resize(m_layerCount);
+    m_chunkMeshes.resize(m_layerCount);
+    m_tileRegistry.load("data/levels/tile_defs.txt");
+    m_autotiler.load("data/levels/autotile_rules.txt");
 
     m_horizGridLine.setFillColor(sf::Color(255, 255, 255, 128));
     m_vertGridLine.setFillColor(sf::Color(255, 255, 255, 128));
 
     m_layerColors.fill(sf::Color::White);
+    m_isLayerBaked.fill(false);
 }
 
 Map::~Map()
 {
-    clear();
 }
 
 void Map::draw(sf::RenderTarget& target, sf::RenderStates states) const
@@ -61,245 +157,1618 @@ void Map::draw(sf::RenderTarget& target, sf::RenderStates states) const
         viewBottom = m_indexDimensions.y;
     }
 
+    // Visible range of Tiles (empty if the view is outside of the Map), and of chunks, in indices
+    unsigned int tileLeft = std::min(static_cast<unsigned int>(viewLeft), m_indexDimensions.x);
+    unsigned int tileRight = viewRight > viewLeft ? static_cast<unsigned int>(std::ceil(viewRight)) : tileLeft;
+    unsigned int tileTop = std::min(static_cast<unsigned int>(viewTop), m_indexDimensions.y);
+    unsigned int tileBottom = viewBottom > viewTop ? static_cast<unsigned int>(std::ceil(viewBottom)) : tileTop;
+
+    unsigned int chunkLeft = tileLeft / TileLayer::chunkSize;
+    unsigned int chunkRight = (tileRight + TileLayer::chunkSize - 1) / TileLayer::chunkSize;
+    unsigned int chunkTop = tileTop / TileLayer::chunkSize;
+    unsigned int chunkBottom = (tileBottom + TileLayer::chunkSize - 1) / TileLayer::chunkSize;
+
+    // Size of a pixel of the target in world units
+    float pixelsPerUnit = viewDimensions.x > 0 ? target.getViewport(target.getView()).width / viewDimensions.x : 1;
+    unsigned int lodLevel = getLodLevel(m_tileSize * pixelsPerUnit);
+
+    // Draw each visible chunk's mesh in one call, rebuilding it first if its Tiles changed
+    m_frameCount++;
+    m_drawCallCount = 0;
+    m_lodChunkBuildCount = 0;
+    m_drawnTileCount = 0;
+    m_occludedTileCount = 0;
+    states.texture = &m_tileRegistry.getAtlasTexture();
     for (unsigned int z = 0; z < m_layerCount; z++)
     {
-        for (unsigned int y = viewTop; y < viewBottom; y++)
+        for (unsigned int chunkY = chunkTop; chunkY < chunkBottom; chunkY++)
         {
-            for (unsigned int x = viewLeft; x < viewRight; x++)
+            for (unsigned int chunkX = chunkLeft; chunkX < chunkRight; chunkX++)
             {
-                if (m_tiles[z][y][x] != nullptr)
+                // When zoomed out, chunks are drawn as single downsampled quads, so that the cost of a frame does not grow with
+                // the number of Tiles visible
+                if (lodLevel > 0 && drawLodChunk(target, states, chunkX, chunkY, z, lodLevel) == true)
+                {
+                    continue;
+                }
+
+                // Baked layers are drawn from their pre-rendered chunks, falling back to meshes if baking is unavailable
+                if (m_isLayerBaked[z] == true && drawBakedChunk(target, states, chunkX, chunkY, z) == true)
                 {
-                    target.draw(*m_tiles[z][y][x], states);
+                    continue;
+                }
+
+                ChunkMesh& mesh = m_chunkMeshes[z][chunkY * m_layers[z].getChunkCounts().x + chunkX];
+                if (mesh.isDirty == true)
+                {
+                    buildChunkMesh(mesh, chunkX, chunkY, z);
+                }
+
+                mesh.lastDrawnFrame = m_frameCount;
+                m_occludedTileCount += mesh.occludedTileCount;
+                if (mesh.vertices.getVertexCount() > 0)
+                {
+                    target.draw(mesh.vertices, states);
+                    m_drawCallCount++;
+                    m_drawnTileCount += static_cast<unsigned int>(mesh.vertices.getVertexCount() / 4);
                 }
             }
         }
     }
+    states.texture = nullptr;
+
+    if (m_meshVertexCount > maxMeshVertexCount)
+    {
+        releaseUndrawnChunkMeshes();
+    }
+    if (m_bakedChunks.size() > maxBakedChunkCount)
+    {
+        evictUndrawnBakedChunks();
+    }
+    if (m_lodChunks.size() > maxLodChunkCount)
+    {
+        evictUndrawnLodChunks();
+    }
 
-    if (m_isGridVisible == true)
+    if (m_isGridVisible == true && std::round(gridLineThickness * pixelsPerUnit) >= minGridLinePixelSize)
     {
         drawGrid(target, states);
     }
 }
 
-// Draw grid lines around Tiles
-void Map::drawGrid(sf::RenderTarget& target, sf::RenderStates states) const
+// Rebuild the quads of a chunk's Tiles on a layer
+void Map::buildChunkMesh(ChunkMesh& mesh, unsigned int chunkX, unsigned int chunkY, unsigned int z) const
 {
-    sf::Vector2f viewPosition = target.getView().getCenter();
-    sf::Vector2f viewDimensions = target.getView().getSize();
-
-    m_horizGridLine.setSize({viewDimensions.x, 2});
-    m_vertGridLine.setSize({2, viewDimensions.y});
-
-    // Set initial horizontal grid line position
-    m_horizGridLine.setPosition(viewPosition.x - viewDimensions.x / 2,
-                                viewPosition.y - viewDimensions.y / 2 -
-                                    static_cast<int>(viewPosition.y - viewDimensions.y / 2) % static_cast<int>(m_tileSize) - 1);
-    if (m_horizGridLine.getPosition().y < -1)
+    m_meshVertexCount -= mesh.vertices.getVertexCount();
+    mesh.vertices.clear();
+    mesh.vertices.setPrimitiveType(sf::Quads);
+    mesh.isDirty = false;
+    mesh.hasAnimatedTiles = false;
+    mesh.occludedTileCount = 0;
+
+    // Unallocated chunks have no Tiles
+    const TileLayer::Chunk* chunk = m_layers[z].getChunk(chunkX, chunkY);
+    if (chunk == nullptr)
     {
-        m_horizGridLine.setPosition(m_horizGridLine.getPosition().x, -1);
+        mesh.vertices = sf::VertexArray(sf::Quads);
+        return;
     }
-    if (m_horizGridLine.getPosition().x < 0)
+
+    // Background Tiles hidden behind opaque Tiles of the Solid layer are left out, unless the Solid layer is drawn translucent
+    const OcclusionMask* occlusionMask = nullptr;
+    if (z == static_cast<unsigned int>(MapLayer::Background) && m_layerColors[static_cast<unsigned int>(MapLayer::Solid)].a == 255)
     {
-        m_horizGridLine.setPosition(0, m_horizGridLine.getPosition().y);
+        occlusionMask = &m_occlusionMasks[chunkY * m_layers[z].getChunkCounts().x + chunkX];
     }
-    if (m_horizGridLine.getPosition().x + m_horizGridLine.getSize().x > getBounds().x)
+
+    for (unsigned int i = 0; i < chunk->cells.size(); i++)
     {
-        m_horizGridLine.setSize(sf::Vector2f(getBounds().x - m_horizGridLine.getPosition().x, 2));
+        const TileCell& cell = chunk->cells[i];
+        if (cell.isEmpty() == true)
+        {
+            continue;
+        }
+        if (occlusionMask != nullptr && (*occlusionMask)[i] == true)
+        {
+            mesh.occludedTileCount++;
+            continue;
+        }
+
+        const TileDef& def = m_tileRegistry.getDef(cell.id);
+        const sf::IntRect& textureRect = def.textureRect;
+        if (def.isAnimated() == true)
+        {
+            mesh.hasAnimatedTiles = true;
+        }
+        sf::Vector2f position(static_cast<float>((chunkX * TileLayer::chunkSize + i % TileLayer::chunkSize) * m_tileSize),
+                              static_cast<float>((chunkY * TileLayer::chunkSize + i / TileLayer::chunkSize) * m_tileSize));
+        sf::Vector2f size(static_cast<float>(textureRect.width), static_cast<float>(textureRect.height));
+        sf::Vector2f texCoords(static_cast<float>(textureRect.left), static_cast<float>(textureRect.top));
+
+        mesh.vertices.append(sf::Vertex(position, m_layerColors[z], texCoords));
+        mesh.vertices.append(sf::Vertex(position + sf::Vector2f(size.x, 0), m_layerColors[z], texCoords + sf::Vector2f(size.x, 0)));
+        mesh.vertices.append(sf::Vertex(position + size, m_layerColors[z], texCoords + size));
+        mesh.vertices.append(sf::Vertex(position + sf::Vector2f(0, size.y), m_layerColors[z], texCoords + sf::Vector2f(0, size.y)));
     }
 
-    // Set initial vertical grid line position
-    m_vertGridLine.setPosition(viewPosition.x - viewDimensions.x / 2 -
-                                   static_cast<int>(viewPosition.x - viewDimensions.x / 2) % static_cast<int>(m_tileSize) - 1,
-                               viewPosition.y - viewDimensions.y / 2);
-    if (m_vertGridLine.getPosition().x < -1)
+    m_meshVertexCount += mesh.vertices.getVertexCount();
+}
+
+// Free the meshes of chunks which were not drawn in the last frame, to bound the memory used by meshes of large Maps
+void Map::releaseUndrawnChunkMeshes() const
+{
+    for (auto& layerMeshes : m_chunkMeshes)
     {
-        m_vertGridLine.setPosition(-1, m_vertGridLine.getPosition().y);
+        for (auto& mesh : layerMeshes)
+        {
+            if (mesh.lastDrawnFrame != m_frameCount && mesh.vertices.getVertexCount() > 0)
+            {
+                m_meshVertexCount -= mesh.vertices.getVertexCount();
+                mesh.vertices = sf::VertexArray(sf::Quads);
+                mesh.isDirty = true;
+            }
+        }
     }
-    if (m_vertGridLine.getPosition().y < 0)
+}
+
+// Draw a chunk of a baked layer as a single quad, pre-rendering it first if it is new or its Tiles changed
+// Return false if the chunk cannot be baked, in which case it should be drawn from its mesh
+bool Map::drawBakedChunk(sf::RenderTarget& target, sf::RenderStates states, unsigned int chunkX, unsigned int chunkY, unsigned int z) const
+{
+    if (m_layers[z].getChunk(chunkX, chunkY) == nullptr)
     {
-        m_vertGridLine.setPosition(m_vertGridLine.getPosition().x, 0);
+        return true;
     }
-    if (m_vertGridLine.getPosition().y + m_vertGridLine.getSize().y > getBounds().y)
+
+    std::size_t chunkIndex = chunkY * m_layers[z].getChunkCounts().x + chunkX;
+    unsigned int bakedSize = TileLayer::chunkSize * m_tileSize;
+    sf::Vector2f origin(static_cast<float>(chunkX * bakedSize), static_cast<float>(chunkY * bakedSize));
+
+    BakedChunk& bakedChunk = m_bakedChunks[getBakedChunkKey(z, chunkIndex)];
+    if (bakedChunk.renderTexture == nullptr)
     {
-        m_vertGridLine.setSize(sf::Vector2f(2, getBounds().y - m_vertGridLine.getPosition().y));
+        // Reuse the render texture of an evicted chunk if possible
+        if (m_freeRenderTextures.empty() == false)
+        {
+            bakedChunk.renderTexture = std::move(m_freeRenderTextures.back());
+            m_freeRenderTextures.pop_back();
+        }
+        else
+        {
+            bakedChunk.renderTexture.reset(new sf::RenderTexture);
+            if (bakedSize > sf::Texture::getMaximumSize() || bakedChunk.renderTexture->create(bakedSize, bakedSize) == false)
+            {
+                std::cerr << "Map error: Unable to create a " << bakedSize << 'x' << bakedSize << " render texture to bake chunks.\n";
+                m_bakedChunks.erase(getBakedChunkKey(z, chunkIndex));
+                m_isLayerBaked[z] = false;
+                return false;
+            }
+        }
+        bakedChunk.isDirty = true;
     }
 
-    // Draw and move grid lines incrementally from their starting position
-    while (m_horizGridLine.getPosition().y <= viewPosition.y + viewDimensions.y / 2 && m_horizGridLine.getPosition().y <= getBounds().y)
+    if (bakedChunk.isDirty == true)
     {
-        target.draw(m_horizGridLine, states);
-        m_horizGridLine.setPosition(m_horizGridLine.getPosition() + sf::Vector2f(0, m_tileSize));
+        ChunkMesh& mesh = m_chunkMeshes[z][chunkIndex];
+        if (mesh.isDirty == true)
+        {
+            buildChunkMesh(mesh, chunkX, chunkY, z);
+        }
+
+        // Tiles are copied without blending, so that the layer's color (and alpha) is applied only once when drawn
+        sf::RenderTexture& renderTexture = *bakedChunk.renderTexture;
+        renderTexture.setView(sf::View(sf::FloatRect(origin.x, origin.y, static_cast<float>(bakedSize), static_cast<float>(bakedSize))));
+        renderTexture.clear(sf::Color::Transparent);
+        sf::RenderStates bakeStates(sf::BlendNone, sf::Transform::Identity, &m_tileRegistry.getAtlasTexture(), nullptr);
+        renderTexture.draw(mesh.vertices, bakeStates);
+        renderTexture.display();
+        bakedChunk.isDirty = false;
+        bakedChunk.hasAnimatedTiles = mesh.hasAnimatedTiles;
+
+        // The mesh is only needed again if the chunk changes
+        m_meshVertexCount -= mesh.vertices.getVertexCount();
+        mesh.vertices = sf::VertexArray(sf::Quads);
+        mesh.isDirty = true;
     }
-    while (m_vertGridLine.getPosition().x <= viewPosition.x + viewDimensions.x / 2 && m_vertGridLine.getPosition().x <= getBounds().x)
+
+    bakedChunk.lastDrawnFrame = m_frameCount;
+    sf::Sprite sprite(bakedChunk.renderTexture->getTexture());
+    sprite.setPosition(origin);
+    target.draw(sprite, states);
+    m_drawCallCount++;
+    return true;
+}
+
+// Evict the baked chunks which were not drawn in the last frame, keeping a few of their render textures for reuse
+void Map::evictUndrawnBakedChunks() const
+{
+    for (auto it = m_bakedChunks.begin(); it != m_bakedChunks.end();)
     {
-        target.draw(m_vertGridLine, states);
-        m_vertGridLine.setPosition(m_vertGridLine.getPosition() + sf::Vector2f(m_tileSize, 0));
+        if (it->second.lastDrawnFrame != m_frameCount)
+        {
+            if (m_freeRenderTextures.size() < maxFreeRenderTextureCount)
+            {
+                m_freeRenderTextures.push_back(std::move(it->second.renderTexture));
+            }
+            it = m_bakedChunks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
     }
 }
 
-void Map::update()
+// Return the level at which to downsample Tiles drawn at a size (in pixels), so that they keep about one texel per pixel
+// Level 0 means that Tiles are drawn in full, and at the last level each Tile is a single pixel of its averaged color
+unsigned int Map::getLodLevel(float tilePixelSize) const
 {
+    if (tilePixelSize > maxLodTilePixelSize)
+    {
+        return 0;
+    }
+
+    unsigned int level = 0;
+    while ((m_tileSize >> level) > tilePixelSize && (m_tileSize >> level) > 1)
+    {
+        level++;
+    }
+    return level;
 }
 
-// Load the Map from a save file
-bool Map::load(const std::string& filename)
+// Draw a chunk of a layer as a single quad of its Tiles downsampled by 2^level, (re)building it first if it is new, its Tiles
+// changed, or it was downsampled at another level. Only a few chunks are built per frame, so that zooming out does not stall:
+// the others are drawn from their previous downsampled version for now, or in full if they have none
+// Return false if the chunk should be drawn in full
+bool Map::drawLodChunk(sf::RenderTarget& target, sf::RenderStates states, unsigned int chunkX, unsigned int chunkY, unsigned int z,
+                       unsigned int level) const
 {
-    // First delete all elements of the vector (necessary when changing level)
-    clear();
-
-    std::ifstream inputFile(FileManager::resourcePath() + filename);
-    if (inputFile)
+    const TileLayer::Chunk* chunk = m_layers[z].getChunk(chunkX, chunkY);
+    if (chunk == nullptr)
     {
-        std::cout << "Loading Map...\n";
-        inputFile >> m_indexDimensions.x >> m_indexDimensions.y >> m_tileSize;
-        std::cout << "Dimensions:\t" << m_indexDimensions.x << 'x' << m_indexDimensions.y << '\n';
-        std::cout << "TileSize:\t" << m_tileSize << '\n';
+        return true;
+    }
 
-        // Vector resizing
-        for (unsigned int z = 0; z < m_layerCount; z++)
+    std::uint64_t key = getBakedChunkKey(z, chunkY * m_layers[z].getChunkCounts().x + chunkX);
+    auto it = m_lodChunks.find(key);
+    LodChunk* lodChunk = it != m_lodChunks.end() ? &it->second : nullptr;
+    if (lodChunk == nullptr || lodChunk->level != level || lodChunk->isDirty == true)
+    {
+        if (m_lodChunkBuildCount < maxLodChunkBuildsPerFrame)
         {
-            m_tiles[z].resize(m_indexDimensions.y);
-            for (unsigned int y = 0; y < m_indexDimensions.y; y++)
+            m_lodChunkBuildCount++;
+            lodChunk = &m_lodChunks[key];
+            if (buildLodChunk(*lodChunk, *chunk, level) == false)
             {
-                m_tiles[z][y].resize(m_indexDimensions.x);
+                m_lodChunks.erase(key);
+                return false;
             }
         }
+        else if (lodChunk == nullptr)
+        {
+            return false;
+        }
+    }
 
-        // Vector assigning
-        std::cout << "Tile map:\n";
-        for (unsigned int z = 0; z < m_layerCount; z++)
+    lodChunk->lastDrawnFrame = m_frameCount;
+    unsigned int chunkPixelSize = TileLayer::chunkSize * m_tileSize;
+    float scale = static_cast<float>(1u << lodChunk->level);
+    sf::Sprite sprite(lodChunk->texture);
+    sprite.setPosition(static_cast<float>(chunkX * chunkPixelSize), static_cast<float>(chunkY * chunkPixelSize));
+    sprite.setScale(scale, scale);
+    sprite.setColor(m_layerColors[z]);
+    target.draw(sprite, states);
+    m_drawCallCount++;
+    return true;
+}
+
+// Compose the downsampled images of a chunk's Tiles into its downsampled texture
+// Tiles larger than a cell overlap the following ones as when drawn in full, but are cut at the chunk's edges
+bool Map::buildLodChunk(LodChunk& lodChunk, const TileLayer::Chunk& chunk, unsigned int level) const
+{
+    unsigned int tilePixelSize = m_tileSize >> level;
+    unsigned int lodSize = TileLayer::chunkSize * tilePixelSize;
+    if (lodChunk.texture.getSize().x != lodSize && lodChunk.texture.create(lodSize, lodSize) == false)
+    {
+        return false;
+    }
+
+    sf::Image image;
+    image.create(lodSize, lodSize, sf::Color::Transparent);
+    lodChunk.hasAnimatedTiles = false;
+    for (unsigned int i = 0; i < chunk.cells.size(); i++)
+    {
+        const sf::Image* tileImage = m_tileRegistry.getLodImage(chunk.cells[i].id, level);
+        if (tileImage != nullptr)
         {
-            std::cout << '#' << z << ": \n";
-            // Ignore all chars until '\n' to peek next character properly
-            inputFile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            if (inputFile.peek() == '-') // Empty layer
+            if (m_tileRegistry.getDef(chunk.cells[i].id).isAnimated() == true)
             {
-                for (unsigned int y = 0; y < m_indexDimensions.y; y++)
-                {
-                    for (unsigned int x = 0; x < m_indexDimensions.x; x++)
-                    {
-                        m_tiles[z][y][x] = nullptr;
-                    }
-                }
-                inputFile.ignore(); // Remove the '-' from the buffer to continue reading
-
-                std::cout << "(empty)\n";
-                continue;
+                lodChunk.hasAnimatedTiles = true;
             }
+            image.copy(*tileImage, (i % TileLayer::chunkSize) * tilePixelSize, (i / TileLayer::chunkSize) * tilePixelSize,
+                       sf::IntRect(0, 0, 0, 0), true);
+        }
+    }
+    lodChunk.texture.update(image);
+    lodChunk.texture.setSmooth(true);
+    lodChunk.level = level;
+    lodChunk.isDirty = false;
+    return true;
+}
 
-            for (unsigned int y = 0; y < m_indexDimensions.y; y++)
-            {
-                bool hasReachedSemiColon = false;
-                for (unsigned int x = 0; x < m_indexDimensions.x; x++)
-                {
-                    // If a semicolon has not been reached, read the next group of characters
-                    if (hasReachedSemiColon == false)
-                    {
-                        std::string input;
-                        inputFile >> input;
-                        if (input == ";")
-                        {
-                            hasReachedSemiColon = true;
-                        }
-                        else
-                        {
-                            if (input.empty() || input.size() > 3 ||
-                                std::find_if(input.cbegin(), input.cend(), [](char c) { return std::isdigit(c) == false; }) != input.cend())
-                            {
-                                std::cerr << "\nMap error: Parsing tile type failed in file: \"" << filename << "\".\n"
-                                          << "Map loading failed.\n\n";
-                                return false;
-                            }
-
-                            int type = std::stoi(input);
-                            addTile(static_cast<TileType>(type), sf::Vector2u(x, y), static_cast<MapLayer>(z), false);
-                        }
-                    }
-                    // If a semicolon has been reached (possibly in this exact loop), set this index to a null pointer
-                    if (hasReachedSemiColon == true)
-                    {
-                        m_tiles[z][y][x] = nullptr;
-                    }
+// Evict the downsampled chunks which were not drawn in the last frame
+void Map::evictUndrawnLodChunks() const
+{
+    for (auto it = m_lodChunks.begin(); it != m_lodChunks.end();)
+    {
+        if (it->second.lastDrawnFrame != m_frameCount)
+        {
+            it = m_lodChunks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
 
-                    if (m_tiles[z][y][x] != nullptr)
-                    {
-                        std::cout << static_cast<int>(m_tiles[z][y][x]->getTileType()) << ' ';
-                    }
-                    else
-                    {
-                        std::cout << "--- ";
-                    }
-                }
-                std::cout << '\n';
-            }
+// Remove the baked chunks of a layer
+void Map::releaseBakedChunks(unsigned int z)
+{
+    for (auto it = m_bakedChunks.begin(); it != m_bakedChunks.end();)
+    {
+        if (it->first >> 32 == z)
+        {
+            it = m_bakedChunks.erase(it);
+        }
+        else
+        {
+            ++it;
         }
+    }
+}
 
-        std::cout << "Map successfully loaded.\n\n";
-        return true;
+// Recreate the table of chunk meshes after the Map's dimensions changed
+void Map::resetChunkMeshes()
+{
+    // Baked chunk indices and sizes depend on the Map's dimensions and TileSize
+    m_bakedChunks.clear();
+    m_freeRenderTextures.clear();
+    m_lodChunks.clear();
+
+    m_meshVertexCount = 0;
+    for (unsigned int z = 0; z < m_layerCount; z++)
+    {
+        const sf::Vector2u& chunkCounts = m_layers[z].getChunkCounts();
+        std::size_t chunkCount = static_cast<std::size_t>(chunkCounts.x) * chunkCounts.y;
+        m_chunkMeshes[z].assign(chunkCount, ChunkMesh{sf::VertexArray(sf::Quads), 0, true, false, 0});
     }
+    m_occlusionMasks.assign(m_chunkMeshes[0].size(), OcclusionMask());
+}
 
-    std::cerr << "Map error: Unable to open \"" << filename << "\".\n"
-              << "Map loading failed.\n\n";
-    return false;
+// Mark every chunk mesh, baked chunk and downsampled chunk of a layer for rebuilding
+void Map::setLayerDirty(unsigned int z)
+{
+    for (auto& mesh : m_chunkMeshes[z])
+    {
+        mesh.isDirty = true;
+    }
+    for (auto& bakedChunk : m_bakedChunks)
+    {
+        if (bakedChunk.first >> 32 == z)
+        {
+            bakedChunk.second.isDirty = true;
+        }
+    }
+    for (auto& lodChunk : m_lodChunks)
+    {
+        if (lodChunk.first >> 32 == z)
+        {
+            lodChunk.second.isDirty = true;
+        }
+    }
 }
 
-// Save the Map to a save file
-bool Map::save(const std::string& filename) const
+// Mark a chunk's mesh, baked chunk and downsampled chunk of a layer for rebuilding
+void Map::setChunkDirty(unsigned int z, std::size_t chunkIndex)
 {
-    std::ofstream outputFile(FileManager::resourcePath() + filename);
-    if (outputFile)
+    m_chunkMeshes[z][chunkIndex].isDirty = true;
+    auto lodIt = m_lodChunks.find(getBakedChunkKey(z, chunkIndex));
+    if (lodIt != m_lodChunks.end())
     {
-        std::cout << "Saving Map...\n";
-        outputFile << m_indexDimensions.x << '\n' << m_indexDimensions.y << '\n' << m_tileSize << '\n';
-        std::cout << "Dimensions:\t" << m_indexDimensions.x << 'x' << m_indexDimensions.y << '\n';
-        std::cout << "TileSize:\t" << m_tileSize << '\n';
+        lodIt->second.isDirty = true;
+    }
+    if (m_isLayerBaked[z] == true)
+    {
+        auto it = m_bakedChunks.find(getBakedChunkKey(z, chunkIndex));
+        if (it != m_bakedChunks.end())
+        {
+            it->second.isDirty = true;
+        }
+    }
+}
 
-        for (unsigned int z = 0; z < m_layerCount; z++)
+// Set a cell and mark its chunk's mesh for rebuilding
+// When streaming, cells of chunks which are not loaded cannot be edited
+void Map::setCell(unsigned int x, unsigned int y, unsigned int z, TileCell cell)
+{
+    std::size_t chunkIndex = (y / TileLayer::chunkSize) * m_layers[z].getChunkCounts().x + x / TileLayer::chunkSize;
+    if (m_chunkStreamer != nullptr)
+    {
+        if (m_chunkStates[chunkIndex] != ChunkState::Loaded)
         {
-            std::string layerOutput;
-            bool isEmptyLayer = true;
+            return;
+        }
+        m_isChunkModified[chunkIndex] = true;
+    }
+    else if (m_savedFilename.empty() == false && z != static_cast<unsigned int>(MapLayer::Overlay) &&
+             m_isChunkUnsaved[chunkIndex] == false)
+    {
+        m_isChunkUnsaved[chunkIndex] = true;
+        m_unsavedChunks.push_back(chunkIndex);
+    }
 
-            if (z != static_cast<unsigned int>(MapLayer::Overlay)) // Do not save overlay (count as empty layer)
-            {
-                for (unsigned int y = 0; y < m_indexDimensions.y; y++)
-                {
-                    for (unsigned int x = 0; x < m_indexDimensions.x; x++)
-                    {
-                        if (m_tiles[z][y][x] == nullptr)
-                        {
-                            layerOutput += "000";
-                        }
-                        else
-                        {
-                            layerOutput += std::to_string(static_cast<int>(m_tiles[z][y][x]->getTileType()));
-                            isEmptyLayer = false;
-                        }
-                        if (x + 1 < m_indexDimensions.x)
-                        {
-                            layerOutput += ' ';
-                        }
-                    }
-                    layerOutput += '\n';
-                }
-            }
+    const TileDef& oldDef = m_tileRegistry.getDef(getCell(x, y, z).id);
+    const TileDef& def = m_tileRegistry.getDef(cell.id);
+    m_layers[z].setCell(x, y, cell);
+    setChunkDirty(z, chunkIndex);
+    if (def.lightLevel != oldDef.lightLevel)
+    {
+        m_lightMap.setTileLight(x, y, getTileLightLevel(x, y));
+    }
+    if (z == static_cast<unsigned int>(MapLayer::Solid))
+    {
+        m_solidityMask.setSolid(x, y, def.isSolid());
+        if (def.isSolid() != oldDef.isSolid())
+        {
+            m_lightMap.setDirty(sf::Vector2u(x, y));
+        }
+        m_collisionLayer.setRegionDirty(x / CollisionLayer::regionSize, y / CollisionLayer::regionSize);
 
-            if (isEmptyLayer == false)
-            {
-                outputFile << layerOutput;
-            }
-            else
+        // The Background Tile behind only needs meshing again if it became hidden or visible
+        std::size_t cellIndex = (y % TileLayer::chunkSize) * TileLayer::chunkSize + x % TileLayer::chunkSize;
+        bool isOccluded = isOccluding(def);
+        if (m_occlusionMasks[chunkIndex][cellIndex] != isOccluded)
+        {
+            m_occlusionMasks[chunkIndex][cellIndex] = isOccluded;
+            setChunkDirty(static_cast<unsigned int>(MapLayer::Background), chunkIndex);
+        }
+    }
+}
+
+// Update the solidity mask from a chunk of the Solid layer, where chunks of a streamed Map which are not loaded are solid
+void Map::updateSolidityMask(unsigned int chunkX, unsigned int chunkY)
+{
+    const TileLayer& solidLayer = m_layers[static_cast<unsigned int>(MapLayer::Solid)];
+    const TileLayer::Chunk* chunk = solidLayer.getChunk(chunkX, chunkY);
+    bool isUnloaded = m_chunkStreamer != nullptr && m_chunkStates[chunkY * solidLayer.getChunkCounts().x + chunkX] != ChunkState::Loaded;
+
+    unsigned int left = chunkX * TileLayer::chunkSize;
+    unsigned int top = chunkY * TileLayer::chunkSize;
+    unsigned int width = std::min(TileLayer::chunkSize, m_indexDimensions.x - left);
+    unsigned int height = std::min(TileLayer::chunkSize, m_indexDimensions.y - top);
+    for (unsigned int y = 0; y < height; y++)
+    {
+        if (chunk == nullptr || isUnloaded == true)
+        {
+            m_solidityMask.setRowSolid(left, top + y, width, isUnloaded);
+            continue;
+        }
+        for (unsigned int x = 0; x < width; x++)
+        {
+            m_solidityMask.setSolid(left + x, top + y, m_tileRegistry.getDef(chunk->cells[y * TileLayer::chunkSize + x].id).isSolid());
+        }
+    }
+    m_collisionLayer.setRegionDirty(chunkX, chunkY);
+    updateOcclusionMask(chunkX, chunkY);
+    updateChunkLights(chunkX, chunkY);
+}
+
+// Update the occlusion mask of a chunk from its Solid layer, marking its Background for meshing again if the mask changed
+void Map::updateOcclusionMask(unsigned int chunkX, unsigned int chunkY)
+{
+    std::size_t chunkIndex = chunkY * m_layers[0].getChunkCounts().x + chunkX;
+    const TileLayer::Chunk* chunk = m_layers[static_cast<unsigned int>(MapLayer::Solid)].getChunk(chunkX, chunkY);
+    OcclusionMask occlusionMask;
+    if (chunk != nullptr)
+    {
+        for (unsigned int i = 0; i < chunk->cells.size(); i++)
+        {
+            occlusionMask[i] = isOccluding(m_tileRegistry.getDef(chunk->cells[i].id));
+        }
+    }
+
+    if (occlusionMask != m_occlusionMasks[chunkIndex])
+    {
+        m_occlusionMasks[chunkIndex] = occlusionMask;
+        setChunkDirty(static_cast<unsigned int>(MapLayer::Background), chunkIndex);
+    }
+}
+
+// Return true if the Tiles of a TileDef fully hide the cell behind them
+bool Map::isOccluding(const TileDef& def) const
+{
+    int tileSize = static_cast<int>(m_tileSize);
+    return def.isOpaque == true && def.textureRect.width >= tileSize && def.textureRect.height >= tileSize;
+}
+
+// Return the light emitted by the Tiles of a cell, the brightest of its layers
+std::uint8_t Map::getTileLightLevel(unsigned int x, unsigned int y) const
+{
+    std::uint8_t level = 0;
+    for (unsigned int z = 0; z < m_layerCount; z++)
+    {
+        level = std::max(level, m_tileRegistry.getDef(getCell(x, y, z).id).lightLevel);
+    }
+    return level;
+}
+
+// Rebuild the solidity mask after the Map's dimensions changed or its chunks were replaced
+void Map::rebuildSolidityMask()
+{
+    m_solidityMask.resize(m_indexDimensions);
+    m_collisionLayer.resize(m_indexDimensions);
+    m_lightMap.resize(m_indexDimensions);
+    const sf::Vector2u& chunkCounts = m_layers[static_cast<unsigned int>(MapLayer::Solid)].getChunkCounts();
+    for (unsigned int chunkY = 0; chunkY < chunkCounts.y; chunkY++)
+    {
+        for (unsigned int chunkX = 0; chunkX < chunkCounts.x; chunkX++)
+        {
+            updateSolidityMask(chunkX, chunkY);
+        }
+    }
+}
+
+// Gather the light-emitting Tiles of a chunk (the brightest of each cell's layers), and mark the cells lit from the chunk dirty
+void Map::updateChunkLights(unsigned int chunkX, unsigned int chunkY)
+{
+    std::vector<const TileLayer::Chunk*> chunks;
+    for (const auto& tileLayer : m_layers)
+    {
+        const TileLayer::Chunk* chunk = tileLayer.getChunk(chunkX, chunkY);
+        if (chunk != nullptr && chunk->tileCount > 0)
+        {
+            chunks.push_back(chunk);
+        }
+    }
+
+    std::vector<LightMap::PointLight> lights;
+    for (std::size_t cellIndex = 0; cellIndex < TileLayer::chunkSize * TileLayer::chunkSize && chunks.empty() == false; cellIndex++)
+    {
+        std::uint8_t level = 0;
+        for (const auto& chunk : chunks)
+        {
+            level = std::max(level, m_tileRegistry.getDef(chunk->cells[cellIndex].id).lightLevel);
+        }
+        if (level > 0)
+        {
+            sf::Vector2u tileIndex(chunkX * TileLayer::chunkSize + cellIndex % TileLayer::chunkSize,
+                                   chunkY * TileLayer::chunkSize + cellIndex / TileLayer::chunkSize);
+            lights.push_back(LightMap::PointLight{tileIndex, level});
+        }
+    }
+    m_lightMap.setChunkTileLights(chunkX, chunkY, std::move(lights));
+
+    // The solidity of the chunk's cells may have changed too
+    m_lightMap.setDirty(sf::Vector2u(chunkX * TileLayer::chunkSize, chunkY * TileLayer::chunkSize),
+                        sf::Vector2u(TileLayer::chunkSize, TileLayer::chunkSize));
+}
+
+// Rebuild the light map from the light-emitting Tiles of every chunk, keeping its moving lights
+void Map::rebuildLightMap()
+{
+    m_lightMap.resize(m_indexDimensions);
+    const sf::Vector2u& chunkCounts = m_layers[0].getChunkCounts();
+    for (unsigned int chunkY = 0; chunkY < chunkCounts.y; chunkY++)
+    {
+        for (unsigned int chunkX = 0; chunkX < chunkCounts.x; chunkX++)
+        {
+            updateChunkLights(chunkX, chunkY);
+        }
+    }
+}
+
+// Merge the colliding Tiles of a region of the Solid layer into rectangles, where chunks of a streamed Map which are not loaded are solid
+void Map::updateCollisionRegion(unsigned int regionX, unsigned int regionY) const
+{
+    static_assert(CollisionLayer::regionSize == TileLayer::chunkSize, "Collision regions must match the chunks of the TileLayers");
+
+    const TileLayer& solidLayer = m_layers[static_cast<unsigned int>(MapLayer::Solid)];
+    const TileLayer::Chunk* chunk = solidLayer.getChunk(regionX, regionY);
+    bool isUnloaded = m_chunkStreamer != nullptr && m_chunkStates[regionY * solidLayer.getChunkCounts().x + regionX] != ChunkState::Loaded;
+
+    CollisionLayer::RegionCollisions collisions;
+    for (std::size_t i = 0; i < collisions.size(); i++)
+    {
+        if (isUnloaded == true)
+        {
+            collisions[i] = TileCollision::Solid;
+        }
+        else
+        {
+            collisions[i] = chunk != nullptr ? m_tileRegistry.getDef(chunk->cells[i].id).collision : TileCollision::None;
+        }
+    }
+    m_collisionLayer.setRegion(regionX, regionY, collisions);
+}
+
+// Install the chunks decoded by the streamer since the last call into the layers
+void Map::installStreamedChunks()
+{
+    std::vector<StreamedChunk> loadedChunks;
+    m_chunkStreamer->takeLoadedChunks(loadedChunks);
+    for (auto& loadedChunk : loadedChunks)
+    {
+        std::size_t chunkIndex = loadedChunk.chunkY * m_layers[0].getChunkCounts().x + loadedChunk.chunkX;
+        for (unsigned int z = 0; z < m_layerCount; z++)
+        {
+            resolveChunk(loadedChunk.layers[z]);
+            m_layers[z].setChunk(loadedChunk.chunkX, loadedChunk.chunkY, loadedChunk.layers[z]);
+            setChunkDirty(z, chunkIndex);
+        }
+        m_chunkStates[chunkIndex] = ChunkState::Loaded;
+        m_residentChunks.push_back(chunkIndex);
+        updateSolidityMask(loadedChunk.chunkX, loadedChunk.chunkY);
+    }
+}
+
+// Remove a loaded chunk from the layers, writing its layers back to the streamer's journal first if it was modified
+// Return false if the chunk must stay loaded, because its changes cannot be written back
+bool Map::evictChunk(std::size_t chunkIndex)
+{
+    unsigned int chunkX = chunkIndex % m_layers[0].getChunkCounts().x;
+    unsigned int chunkY = chunkIndex / m_layers[0].getChunkCounts().x;
+    if (m_isChunkModified[chunkIndex] == true)
+    {
+        if (m_chunkStreamer->isJournalOpen() == false)
+        {
+            return false;
+        }
+
+        // Empty layers are written too, as the Map file may still have the Tiles they had when loaded
+        StreamedChunk modifiedChunk{chunkX, chunkY, std::vector<TileLayer::Chunk>(m_layerCount)};
+        for (unsigned int z = 0; z < m_layerCount; z++)
+        {
+            const TileLayer::Chunk* chunk = m_layers[z].getChunk(chunkX, chunkY);
+            if (chunk != nullptr)
+            {
+                modifiedChunk.layers[z] = *chunk;
+            }
+            else
+            {
+                modifiedChunk.layers[z].cells.fill(TileCell{0, 0});
+                modifiedChunk.layers[z].tileCount = 0;
+            }
+        }
+        m_chunkStreamer->requestWrite(std::move(modifiedChunk));
+        m_isChunkModified[chunkIndex] = false;
+    }
+
+    TileLayer::Chunk emptyChunk;
+    emptyChunk.tileCount = 0;
+    for (unsigned int z = 0; z < m_layerCount; z++)
+    {
+        m_layers[z].setChunk(chunkX, chunkY, emptyChunk);
+        ChunkMesh& mesh = m_chunkMeshes[z][chunkIndex];
+        m_meshVertexCount -= mesh.vertices.getVertexCount();
+        mesh.vertices = sf::VertexArray(sf::Quads);
+        mesh.isDirty = true;
+        m_bakedChunks.erase(getBakedChunkKey(z, chunkIndex));
+        m_lodChunks.erase(getBakedChunkKey(z, chunkIndex));
+    }
+    m_chunkStates[chunkIndex] = ChunkState::Unloaded;
+    updateSolidityMask(chunkX, chunkY);
+    return true;
+}
+
+// Stop streaming, discarding the chunks written back since the Map file was last saved
+void Map::stopStreaming()
+{
+    m_chunkStreamer.reset();
+    m_chunkStates.clear();
+    m_isChunkModified.clear();
+    m_residentChunks.clear();
+}
+
+// Forget the chunks edited since the Map was loaded or saved, recording that it now matches a binary Map file (none if empty)
+void Map::resetSaveJournal(const std::string& savedFilename) const
+{
+    m_savedFilename = savedFilename;
+    m_unsavedChunks.clear();
+    m_isChunkUnsaved.assign(savedFilename.empty() ? 0 : m_layers[0].getChunkCounts().x * m_layers[0].getChunkCounts().y, false);
+}
+
+// Draw grid lines around Tiles
+void Map::drawGrid(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    sf::Vector2f viewPosition = target.getView().getCenter();
+    sf::Vector2f viewDimensions = target.getView().getSize();
+
+    m_horizGridLine.setSize({viewDimensions.x, gridLineThickness});
+    m_vertGridLine.setSize({gridLineThickness, viewDimensions.y});
+
+    // Set initial horizontal grid line position
+    m_horizGridLine.setPosition(viewPosition.x - viewDimensions.x / 2,
+                                viewPosition.y - viewDimensions.y / 2 -
+                                    static_cast<int>(viewPosition.y - viewDimensions.y / 2) % static_cast<int>(m_tileSize) - 1);
+    if (m_horizGridLine.getPosition().y < -1)
+    {
+        m_horizGridLine.setPosition(m_horizGridLine.getPosition().x, -1);
+    }
+    if (m_horizGridLine.getPosition().x < 0)
+    {
+        m_horizGridLine.setPosition(0, m_horizGridLine.getPosition().y);
+    }
+    if (m_horizGridLine.getPosition().x + m_horizGridLine.getSize().x > getBounds().x)
+    {
+        m_horizGridLine.setSize(sf::Vector2f(getBounds().x - m_horizGridLine.getPosition().x, gridLineThickness));
+    }
+
+    // Set initial vertical grid line position
+    m_vertGridLine.setPosition(viewPosition.x - viewDimensions.x / 2 -
+                                   static_cast<int>(viewPosition.x - viewDimensions.x / 2) % static_cast<int>(m_tileSize) - 1,
+                               viewPosition.y - viewDimensions.y / 2);
+    if (m_vertGridLine.getPosition().x < -1)
+    {
+        m_vertGridLine.setPosition(-1, m_vertGridLine.getPosition().y);
+    }
+    if (m_vertGridLine.getPosition().y < 0)
+    {
+        m_vertGridLine.setPosition(m_vertGridLine.getPosition().x, 0);
+    }
+    if (m_vertGridLine.getPosition().y + m_vertGridLine.getSize().y > getBounds().y)
+    {
+        m_vertGridLine.setSize(sf::Vector2f(gridLineThickness, getBounds().y - m_vertGridLine.getPosition().y));
+    }
+
+    // Draw and move grid lines incrementally from their starting position
+    while (m_horizGridLine.getPosition().y <= viewPosition.y + viewDimensions.y / 2 && m_horizGridLine.getPosition().y <= getBounds().y)
+    {
+        target.draw(m_horizGridLine, states);
+        m_horizGridLine.setPosition(m_horizGridLine.getPosition() + sf::Vector2f(0, m_tileSize));
+    }
+    while (m_vertGridLine.getPosition().x <= viewPosition.x + viewDimensions.x / 2 && m_vertGridLine.getPosition().x <= getBounds().x)
+    {
+        target.draw(m_vertGridLine, states);
+        m_vertGridLine.setPosition(m_vertGridLine.getPosition() + sf::Vector2f(m_tileSize, 0));
+    }
+}
+
+// Advance the animation clock, showing the current frame of each animated TileType
+void Map::update()
+{
+    m_animationTick++;
+    if (m_tileRegistry.updateAnimations(m_animationTick) == false)
+    {
+        return;
+    }
+
+    // Meshes only reference the atlas, but baked and downsampled chunks hold copies of their Tiles' frames
+    for (auto& bakedChunk : m_bakedChunks)
+    {
+        if (bakedChunk.second.hasAnimatedTiles == true)
+        {
+            bakedChunk.second.isDirty = true;
+        }
+    }
+    for (auto& lodChunk : m_lodChunks)
+    {
+        if (lodChunk.second.hasAnimatedTiles == true)
+        {
+            lodChunk.second.isDirty = true;
+        }
+    }
+}
+
+// Load the Map from a save file
+// Large Maps are parsed in parallel when laid out one row per line (as saved), and the result is the same as when parsed sequentially
+bool Map::load(const std::string& filename)
+{
+    // First remove all Tiles (necessary when changing level), and resolve Tile textures again in case they were reloaded
+    stopStreaming();
+    clear();
+    m_tileRegistry.clearAtlas();
+
+    std::ifstream inputFile(FileManager::resourcePath() + filename);
+    if (inputFile)
+    {
+        std::cout << "Loading Map...\n";
+        inputFile >> m_indexDimensions.x >> m_indexDimensions.y >> m_tileSize;
+        std::cout << "Dimensions:\t" << m_indexDimensions.x << 'x' << m_indexDimensions.y << '\n';
+        std::cout << "TileSize:\t" << m_tileSize << '\n';
+
+        if (m_indexDimensions.x > maxDimensions.x || m_indexDimensions.y > maxDimensions.y)
+        {
+            std::cerr << "Map error: \"" << filename << "\" exceeds the maximum Map dimensions.\n"
+                      << "Map loading failed.\n\n";
+            resize(sf::Vector2u(0, 0));
+            return false;
+        }
+
+        // Chunk table allocation (chunks themselves are allocated when their first Tile is added)
+        for (auto& tileLayer : m_layers)
+        {
+            tileLayer.resize(m_indexDimensions);
+        }
+        resetChunkMeshes();
+        m_solidityMask.resize(m_indexDimensions);
+        m_collisionLayer.resize(m_indexDimensions);
+        m_lightMap.resize(m_indexDimensions); // Tile lights are added as the sequential parser adds Tiles
+
+        // The layers are read from memory, by the sequential parser if the parallel one cannot parse them
+        std::streampos layersStart = inputFile.tellg();
+        inputFile.seekg(0, std::ios::end);
+        std::string content(static_cast<std::size_t>(inputFile.tellg() - layersStart), '\0');
+        inputFile.seekg(layersStart);
+        inputFile.read(&content[0], content.size());
+        content.resize(static_cast<std::size_t>(inputFile.gcount())); // Fewer chars are read if line endings are converted
+        if (static_cast<std::size_t>(m_indexDimensions.x) * m_indexDimensions.y < minParallelCellCount ||
+            parseLayersParallel(content) == false)
+        {
+            std::istringstream input(content);
+            if (parseLayers(input, filename) == false)
+            {
+                return false;
+            }
+        }
+        autotileLayers();
+
+        std::cout << "Map successfully loaded.\n\n";
+        return true;
+    }
+
+    std::cerr << "Map error: Unable to open \"" << filename << "\".\n"
+              << "Map loading failed.\n\n";
+    return false;
+}
+
+// Parse the layers of a text Map, following its header, adding their Tiles one at a time
+bool Map::parseLayers(std::istream& input, const std::string& filename)
+{
+    for (unsigned int z = 0; z < m_layerCount; z++)
+    {
+        // Ignore all chars until '\n' to peek next character properly
+        input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        if (input.peek() == '-') // Empty layer
+        {
+            input.ignore(); // Remove the '-' from the buffer to continue reading
+            continue;
+        }
+
+        for (unsigned int y = 0; y < m_indexDimensions.y; y++)
+        {
+            for (unsigned int x = 0; x < m_indexDimensions.x; x++)
+            {
+                // If a semicolon is reached, the rest of the row is left empty
+                std::string token;
+                input >> token;
+                if (token == ";")
+                {
+                    break;
+                }
+
+                if (token.empty() || token.size() > 3 ||
+                    std::find_if(token.cbegin(), token.cend(), [](char c) { return std::isdigit(c) == false; }) != token.cend())
+                {
+                    std::cerr << "\nMap error: Parsing tile type failed in file: \"" << filename << "\".\n"
+                              << "Map loading failed.\n\n";
+                    return false;
+                }
+
+                addTile(static_cast<TileType>(std::stoi(token)), sf::Vector2u(x, y), static_cast<MapLayer>(z), false);
+            }
+        }
+    }
+    return true;
+}
+
+// Parse the layers of a text Map, following its header, on several threads, each filling the chunks of bands of rows
+// Returns false without changing the Map if the layers are not laid out one row per line or cannot be parsed, to leave them
+// to parseLayers(), which reports errors
+bool Map::parseLayersParallel(const std::string& content)
+{
+    // Find the line of each row, skipping the rest of the line before each layer as parseLayers() does
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> rowLines(m_layerCount);
+    std::size_t position = 0;
+    for (unsigned int z = 0; z < m_layerCount; z++)
+    {
+        position = content.find('\n', position);
+        if (position == std::string::npos)
+        {
+            return false;
+        }
+        position++;
+        if (position < content.size() && content[position] == '-') // Empty layer
+        {
+            position++;
+            continue;
+        }
+
+        rowLines[z].resize(m_indexDimensions.y);
+        for (unsigned int y = 0; y < m_indexDimensions.y; y++)
+        {
+            if (y > 0)
+            {
+                if (position == content.size())
+                {
+                    return false;
+                }
+                position++;
+            }
+            std::size_t lineEnd = std::min(content.find('\n', position), content.size());
+            rowLines[z][y] = std::make_pair(position, lineEnd);
+            position = lineEnd;
+        }
+    }
+
+    // Each band of rows (as high as a chunk) of each layer fills its own row of chunks
+    struct ParsedBand
+    {
+        std::vector<std::unique_ptr<TileLayer::Chunk>> chunks; // nullptr where the chunk has no Tiles
+        std::vector<std::uint16_t> firstUsedIds; // TileType ids in the order of their first use in the band
+        bool isParsed;
+    };
+
+    const unsigned int chunkSize = TileLayer::chunkSize;
+    unsigned int bandCount = (m_indexDimensions.y + chunkSize - 1) / chunkSize;
+    std::vector<ParsedBand> bands(m_layerCount * bandCount);
+    Utility::runParallel(bands.size(), [this, &content, &rowLines, &bands, bandCount, chunkSize](std::size_t bandIndex)
+    {
+        ParsedBand& band = bands[bandIndex];
+        unsigned int z = static_cast<unsigned int>(bandIndex / bandCount);
+        unsigned int top = static_cast<unsigned int>(bandIndex % bandCount) * chunkSize;
+        band.isParsed = true;
+        if (rowLines[z].empty() == true)
+        {
+            return;
+        }
+
+        band.chunks.resize(m_layers[z].getChunkCounts().x);
+        std::vector<std::uint16_t> ids(m_indexDimensions.x);
+        std::bitset<maxTileTypeId + 1> isUsed;
+        for (unsigned int y = top; y < std::min(top + chunkSize, m_indexDimensions.y); y++)
+        {
+            const char* text = content.data();
+            if (parseRow(text + rowLines[z][y].first, text + rowLines[z][y].second, m_indexDimensions.x, ids.data()) == false)
+            {
+                band.isParsed = false;
+                return;
+            }
+
+            for (unsigned int x = 0; x < m_indexDimensions.x; x++)
+            {
+                if (ids[x] == 0)
+                {
+                    continue;
+                }
+                if (isUsed[ids[x]] == false)
+                {
+                    isUsed[ids[x]] = true;
+                    band.firstUsedIds.push_back(ids[x]);
+                }
+
+                std::unique_ptr<TileLayer::Chunk>& chunk = band.chunks[x / chunkSize];
+                if (chunk == nullptr)
+                {
+                    chunk.reset(new TileLayer::Chunk);
+                    chunk->cells.fill(TileCell{0, 0});
+                    chunk->tileCount = 0;
+                }
+                chunk->cells[(y % chunkSize) * chunkSize + x % chunkSize] = TileCell{ids[x], 0};
+                chunk->tileCount++;
+            }
+        }
+    });
+
+    for (const auto& band : bands)
+    {
+        if (band.isParsed == false)
+        {
+            return false;
+        }
+    }
+
+    // Resolve TileTypes in the order of their first use in the file, so that the Tile atlas is the same as when parsed sequentially
+    std::bitset<maxTileTypeId + 1> isResolved;
+    std::bitset<maxTileTypeId + 1> isUnknown;
+    for (const auto& band : bands)
+    {
+        for (std::uint16_t id : band.firstUsedIds)
+        {
+            if (isResolved[id] == true || isUnknown[id] == true)
+            {
+                continue;
+            }
+            if (resolveTileType(id) == true)
+            {
+                isResolved[id] = true;
+            }
+            else
+            {
+                isUnknown[id] = true;
+            }
+        }
+    }
+
+    // Install the chunks, leaving the cells of unknown TileTypes empty
+    for (std::size_t bandIndex = 0; bandIndex < bands.size(); bandIndex++)
+    {
+        unsigned int z = static_cast<unsigned int>(bandIndex / bandCount);
+        unsigned int chunkY = static_cast<unsigned int>(bandIndex % bandCount);
+        for (unsigned int chunkX = 0; chunkX < bands[bandIndex].chunks.size(); chunkX++)
+        {
+            std::unique_ptr<TileLayer::Chunk>& chunk = bands[bandIndex].chunks[chunkX];
+            if (chunk != nullptr && isUnknown.any() == true)
+            {
+                for (auto& cell : chunk->cells)
+                {
+                    if (cell.isEmpty() == false && isUnknown[cell.id] == true)
+                    {
+                        cell = TileCell{0, 0};
+                        chunk->tileCount--;
+                    }
+                }
+            }
+            m_layers[z].setChunk(chunkX, chunkY, std::move(chunk));
+        }
+    }
+    rebuildSolidityMask();
+    return true;
+}
+
+// Autotile every Tile of the Map, finding the variants of bands of rows in parallel before setting those which changed
+// Variants only depend on the Tiles before the pass, so the result does not depend on the number of threads
+void Map::autotileLayers()
+{
+    const unsigned int chunkSize = TileLayer::chunkSize;
+    unsigned int bandCount = (m_indexDimensions.y + chunkSize - 1) / chunkSize;
+    std::vector<std::vector<std::pair<sf::Vector2u, std::uint16_t>>> bandVariants(m_layerCount * bandCount);
+    Utility::runParallel(bandVariants.size(), [this, &bandVariants, bandCount, chunkSize](std::size_t bandIndex)
+    {
+        unsigned int z = static_cast<unsigned int>(bandIndex / bandCount);
+        unsigned int chunkY = static_cast<unsigned int>(bandIndex % bandCount);
+        for (unsigned int chunkX = 0; chunkX < m_layers[z].getChunkCounts().x; chunkX++)
+        {
+            if (m_layers[z].getChunk(chunkX, chunkY) == nullptr)
+            {
+                continue;
+            }
+
+            unsigned int right = std::min((chunkX + 1) * chunkSize, m_indexDimensions.x);
+            unsigned int bottom = std::min((chunkY + 1) * chunkSize, m_indexDimensions.y);
+            for (unsigned int y = chunkY * chunkSize; y < bottom; y++)
+            {
+                for (unsigned int x = chunkX * chunkSize; x < right; x++)
+                {
+                    std::uint16_t variant = getAutotiledId(x, y, z);
+                    if (variant != getCell(x, y, z).id)
+                    {
+                        bandVariants[bandIndex].push_back(std::make_pair(sf::Vector2u(x, y), variant));
+                    }
+                }
+            }
+        }
+    });
+
+    for (std::size_t bandIndex = 0; bandIndex < bandVariants.size(); bandIndex++)
+    {
+        for (const auto& variant : bandVariants[bandIndex])
+        {
+            addTile(static_cast<TileType>(variant.second), variant.first, static_cast<MapLayer>(bandIndex / bandCount));
+        }
+    }
+}
+
+// Save the Map to a save file
+bool Map::save(const std::string& filename) const
+{
+    std::ofstream outputFile(FileManager::resourcePath() + filename);
+    if (outputFile)
+    {
+        std::cout << "Saving Map...\n";
+        outputFile << m_indexDimensions.x << '\n' << m_indexDimensions.y << '\n' << m_tileSize << '\n';
+        std::cout << "Dimensions:\t" << m_indexDimensions.x << 'x' << m_indexDimensions.y << '\n';
+        std::cout << "TileSize:\t" << m_tileSize << '\n';
+
+        for (unsigned int z = 0; z < m_layerCount; z++)
+        {
+            bool isEmptyLayer = true;
+            if (z != static_cast<unsigned int>(MapLayer::Overlay)) // Do not save overlay (count as empty layer)
+            {
+                for (unsigned int chunkY = 0; chunkY < m_layers[z].getChunkCounts().y && isEmptyLayer == true; chunkY++)
+                {
+                    for (unsigned int chunkX = 0; chunkX < m_layers[z].getChunkCounts().x && isEmptyLayer == true; chunkX++)
+                    {
+                        const TileLayer::Chunk* chunk = m_layers[z].getChunk(chunkX, chunkY);
+                        isEmptyLayer = chunk == nullptr || chunk->tileCount == 0;
+                    }
+                }
+            }
+            if (isEmptyLayer == true)
+            {
+                outputFile << "-\n";
+                continue;
+            }
+
+            // Written row by row, rather than building the whole layer into one string first
+            std::string rowOutput;
+            for (unsigned int y = 0; y < m_indexDimensions.y; y++)
+            {
+                rowOutput.clear();
+                for (unsigned int x = 0; x < m_indexDimensions.x; x++)
+                {
+                    const TileCell& cell = getCell(x, y, z);
+                    rowOutput += cell.isEmpty() == true ? "000" : std::to_string(cell.id);
+                    if (x + 1 < m_indexDimensions.x)
+                    {
+                        rowOutput += ' ';
+                    }
+                }
+                rowOutput += '\n';
+                outputFile << rowOutput;
+            }
+        }
+
+        std::cout << "Map successfully saved.\n\n";
+        return true;
+    }
+
+    std::cerr << "Map error: Unable to save \"" << filename << "\".\n"
+              << "Map saving failed.\n\n";
+    return false;
+}
+
+// Load the Map from a binary Map file, decoding its chunks directly into the layers
+// If streaming is allowed and the Map is large, only the chunks around the view are loaded, by updateStreaming()
+bool Map::loadBinary(const std::string& filename, bool allowStreaming)
+{
+    // First remove all Tiles (necessary when changing level), and resolve Tile textures again in case they were reloaded
+    stopStreaming();
+    clear();
+    m_tileRegistry.clearAtlas();
+
+    MapFile mapFile;
+    if (mapFile.open(filename) == false)
+    {
+        std::cerr << "Map error: Unable to open \"" << filename << "\".\n"
+                  << "Map loading failed.\n\n";
+        return false;
+    }
+
+    if (mapFile.getDimensions().x > maxDimensions.x || mapFile.getDimensions().y > maxDimensions.y)
+    {
+        std::cerr << "Map error: \"" << filename << "\" exceeds the maximum Map dimensions.\n"
+                  << "Map loading failed.\n\n";
+        return false;
+    }
+
+    std::cout << "Loading Map...\n";
+    m_indexDimensions = mapFile.getDimensions();
+    m_tileSize = mapFile.getTileSize();
+    std::cout << "Dimensions:\t" << m_indexDimensions.x << 'x' << m_indexDimensions.y << '\n';
+    std::cout << "TileSize:\t" << m_tileSize << '\n';
+
+    for (auto& tileLayer : m_layers)
+    {
+        tileLayer.resize(m_indexDimensions);
+    }
+    resetChunkMeshes();
+
+    if (allowStreaming == true && static_cast<std::size_t>(m_indexDimensions.x) * m_indexDimensions.y >= minStreamedCellCount)
+    {
+        mapFile.close();
+        m_chunkStreamer.reset(new ChunkStreamer);
+        if (m_chunkStreamer->open(filename, m_layerCount) == true)
+        {
+            std::size_t chunkCount = static_cast<std::size_t>(m_layers[0].getChunkCounts().x) * m_layers[0].getChunkCounts().y;
+            m_chunkStates.assign(chunkCount, ChunkState::Unloaded);
+            m_isChunkModified.assign(chunkCount, false);
+            rebuildSolidityMask();
+            std::cout << "Streaming:\tchunks within " << m_streamingLoadRadius << " of the view\n";
+            std::cout << "Map successfully loaded.\n\n";
+            return true;
+        }
+
+        stopStreaming();
+        if (mapFile.open(filename) == false)
+        {
+            std::cerr << "Map error: Unable to open \"" << filename << "\".\n"
+                      << "Map loading failed.\n\n";
+            return false;
+        }
+    }
+
+    TileLayer::Chunk chunk;
+    for (unsigned int z = 0; z < std::min(m_layerCount, mapFile.getLayerCount()); z++)
+    {
+        for (unsigned int chunkY = 0; chunkY < mapFile.getChunkCounts().y; chunkY++)
+        {
+            for (unsigned int chunkX = 0; chunkX < mapFile.getChunkCounts().x; chunkX++)
+            {
+                if (mapFile.hasChunk(z, chunkX, chunkY) == false)
+                {
+                    continue;
+                }
+                if (mapFile.readChunk(z, chunkX, chunkY, chunk) == false)
+                {
+                    std::cerr << "\nMap error: Corrupted chunk in file: \"" << filename << "\".\n"
+                              << "Map loading failed.\n\n";
+                    return false;
+                }
+
+                resolveChunk(chunk);
+                m_layers[z].setChunk(chunkX, chunkY, chunk);
+            }
+        }
+    }
+    rebuildSolidityMask();
+    if (mapFile.getLayerCount() == m_layerCount)
+    {
+        resetSaveJournal(filename);
+    }
+
+    std::cout << "Map successfully loaded.\n\n";
+    return true;
+}
+
+// Save the Map to a binary Map file (the Overlay layer is not saved)
+// Saving a fully loaded Map back to the file it was loaded from or last saved to only writes the chunks edited since
+// When streaming, chunks which are not loaded are copied from the streamed file and its journal
+bool Map::saveBinary(const std::string& filename) const
+{
+    bool isStreamedFile = m_chunkStreamer != nullptr && filename == m_chunkStreamer->getFilename();
+    if (m_chunkStreamer != nullptr)
+    {
+        m_chunkStreamer->waitUntilIdle();
+    }
+
+    TileLayer::Chunk streamedChunk;
+    auto getChunk = [this, &streamedChunk](unsigned int z, unsigned int chunkX, unsigned int chunkY) -> const TileLayer::Chunk*
+    {
+        if (z == static_cast<unsigned int>(MapLayer::Overlay))
+        {
+            return nullptr;
+        }
+        if (m_chunkStreamer != nullptr && m_chunkStates[chunkY * m_layers[z].getChunkCounts().x + chunkX] != ChunkState::Loaded)
+        {
+            return m_chunkStreamer->readChunkNow(z, chunkX, chunkY, streamedChunk) ? &streamedChunk : nullptr;
+        }
+        return m_layers[z].getChunk(chunkX, chunkY);
+    };
+
+    std::cout << "Saving Map...\n";
+    if (m_chunkStreamer == nullptr && filename == m_savedFilename &&
+        MapFile::saveChunks(filename, m_indexDimensions, m_tileSize, m_layerCount, m_unsavedChunks, getChunk) == true)
+    {
+        std::cout << "Saved chunks:\t" << m_unsavedChunks.size() << '\n';
+        std::cout << "Map successfully saved.\n\n";
+        resetSaveJournal(filename);
+        return true;
+    }
+
+    // The streamed file is still being read from, so it is replaced only once the new one is complete
+    std::string savedFilename = isStreamedFile == true ? filename + ".tmp" : filename;
+    if (MapFile::save(savedFilename, m_indexDimensions, m_tileSize, m_layerCount, getChunk) == false ||
+        (isStreamedFile == true && m_chunkStreamer->replaceMapFile(savedFilename) == false))
+    {
+        std::cerr << "Map error: Unable to save \"" << filename << "\".\n"
+                  << "Map saving failed.\n\n";
+        return false;
+    }
+    if (m_chunkStreamer == nullptr)
+    {
+        resetSaveJournal(filename);
+    }
+
+    std::cout << "Map successfully saved.\n\n";
+    return true;
+}
+
+// Replace the Map with a procedurally generated one (see LevelGenerator)
+bool Map::generate(const LevelGenerator::Settings& settings)
+{
+    if (LevelGenerator::areSettingsValid(settings) == false)
+    {
+        std::cerr << "Map error: Generated Maps must fit in the maximum Map dimensions.\n"
+                  << "Map generation failed.\n\n";
+        return false;
+    }
+
+    // First remove all Tiles (necessary when changing level), and resolve Tile textures again in case they were reloaded
+    stopStreaming();
+    clear();
+    m_tileRegistry.clearAtlas();
+
+    std::cout << "Generating Map...\n";
+    m_indexDimensions = settings.dimensions;
+    m_tileSize = settings.tileSize;
+    std::cout << "Dimensions:\t" << m_indexDimensions.x << 'x' << m_indexDimensions.y << '\n';
+    std::cout << "Seed:\t\t" << settings.seed << '\n';
+
+    LevelGenerator::generateLayers(settings, m_tileRegistry, m_autotiler, m_layers);
+    resetChunkMeshes();
+
+    // Resolve TileTypes in the order of their first use, so that the Tile atlas only depends on the seed
+    std::bitset<maxTileTypeId + 1> isResolved;
+    for (const auto& tileLayer : m_layers)
+    {
+        for (unsigned int chunkY = 0; chunkY < tileLayer.getChunkCounts().y; chunkY++)
+        {
+            for (unsigned int chunkX = 0; chunkX < tileLayer.getChunkCounts().x; chunkX++)
+            {
+                const TileLayer::Chunk* chunk = tileLayer.getChunk(chunkX, chunkY);
+                for (std::size_t i = 0; chunk != nullptr && i < chunk->cells.size(); i++)
+                {
+                    std::uint16_t id = chunk->cells[i].id;
+                    if (id != 0 && isResolved[id] == false)
+                    {
+                        isResolved[id] = true;
+                        resolveTileType(id);
+                    }
+                }
+            }
+        }
+    }
+    rebuildSolidityMask();
+    resetSaveJournal("");
+
+    std::cout << "Map successfully generated.\n\n";
+    return true;
+}
+
+// Take a snapshot of the saved layers, to be saved to a binary Map file by saveSnapshot(), possibly on another thread
+// The change journal is handed over to the snapshot, and then records the edits made since as if it had been saved to filename
+// Return false if the Map is streamed, since the chunks which are not loaded are only available through the streamer
+bool Map::takeSnapshot(Snapshot& snapshot, const std::string& filename) const
+{
+    if (m_chunkStreamer != nullptr)
+    {
+        return false;
+    }
+
+    snapshot.layers.assign(m_layerCount, TileLayer());
+    for (unsigned int z = 0; z < m_layerCount; z++)
+    {
+        if (z != static_cast<unsigned int>(MapLayer::Overlay))
+        {
+            snapshot.layers[z] = m_layers[z];
+        }
+    }
+    snapshot.indexDimensions = m_indexDimensions;
+    snapshot.tileSize = m_tileSize;
+    snapshot.textureNames.resize(maxTileTypeId + 1);
+    for (std::size_t id = 0; id <= maxTileTypeId; id++)
+    {
+        snapshot.textureNames[id] = m_tileRegistry.getDef(static_cast<std::uint16_t>(id)).textureName;
+    }
+
+    snapshot.baseFilename = filename == m_savedFilename ? filename : "";
+    snapshot.changedChunks = m_unsavedChunks;
+    resetSaveJournal(filename);
+    return true;
+}
+
+// Stop recording edits relative to a file a snapshot failed to be saved to, so that the Map is saved to it in full next time
+void Map::onSnapshotSaveFailed(const std::string& filename) const
+{
+    if (m_savedFilename == filename)
+    {
+        resetSaveJournal("");
+    }
+}
+
+// Save a snapshot to a binary Map file, reporting the fraction of the work done so far to onProgress
+// If the snapshot has a base file, it is copied (unless saved over) and only the changed chunks are written
+// Saving to another file than the base file (as LevelSaver does, to keep the previous save intact until the new one is complete)
+// costs a copy of the base file, reflinked where the file system allows it. The copy is weighted in the progress as writing every
+// chunk once, as it is in bytes
+bool Map::saveSnapshot(const Snapshot& snapshot, const std::string& filename, const std::function<void(float)>& onProgress)
+{
+    unsigned int layerCount = static_cast<unsigned int>(snapshot.layers.size());
+    const sf::Vector2u& chunkCounts = snapshot.layers[0].getChunkCounts();
+    std::size_t chunkCount = static_cast<std::size_t>(chunkCounts.x) * chunkCounts.y;
+    float startProgress = 0; // Progress reached before writing the chunks
+    std::size_t writtenChunkCount = 0;
+    std::size_t totalChunkCount = 0;
+    auto getChunk = [&](unsigned int z, unsigned int chunkX, unsigned int chunkY) -> const TileLayer::Chunk*
+    {
+        onProgress(startProgress + (1 - startProgress) * ++writtenChunkCount / totalChunkCount);
+        return z != static_cast<unsigned int>(MapLayer::Overlay) ? snapshot.layers[z].getChunk(chunkX, chunkY) : nullptr;
+    };
+
+    if (snapshot.baseFilename.empty() == false)
+    {
+        bool isCopied = filename == snapshot.baseFilename;
+        if (isCopied == false)
+        {
+            float copyShare = static_cast<float>(chunkCount) / (chunkCount + snapshot.changedChunks.size());
+            isCopied = FileManager::copyFile(snapshot.baseFilename, filename, [&](float progress) { onProgress(progress * copyShare); });
+            startProgress = copyShare;
+        }
+
+        totalChunkCount = snapshot.changedChunks.size() * layerCount;
+        if (isCopied == true && MapFile::saveChunks(filename, snapshot.indexDimensions, snapshot.tileSize, layerCount,
+                                                    snapshot.changedChunks, getChunk) == true)
+        {
+            return true;
+        }
+    }
+
+    startProgress = 0;
+    writtenChunkCount = 0;
+    totalChunkCount = chunkCount * layerCount;
+    return MapFile::save(filename, snapshot.indexDimensions, snapshot.tileSize, layerCount, getChunk);
+}
+
+// Add the names of the textures of the Tiles in a snapshot to a set
+void Map::addTextureNames(const Snapshot& snapshot, std::set<std::string>& textureNames)
+{
+    std::vector<bool> isIdUsed(snapshot.textureNames.size(), false);
+    for (const auto& tileLayer : snapshot.layers)
+    {
+        for (unsigned int chunkY = 0; chunkY < tileLayer.getChunkCounts().y; chunkY++)
+        {
+            for (unsigned int chunkX = 0; chunkX < tileLayer.getChunkCounts().x; chunkX++)
+            {
+                const TileLayer::Chunk* chunk = tileLayer.getChunk(chunkX, chunkY);
+                for (std::size_t i = 0; chunk != nullptr && i < chunk->cells.size(); i++)
+                {
+                    if (chunk->cells[i].id < isIdUsed.size())
+                    {
+                        isIdUsed[chunk->cells[i].id] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    for (std::size_t id = 1; id < isIdUsed.size(); id++)
+    {
+        if (isIdUsed[id] == true && snapshot.textureNames[id].empty() == false)
+        {
+            textureNames.insert(snapshot.textureNames[id]);
+        }
+    }
+}
+
+// Draw the light levels of the visible Tiles over what was drawn, darkening each Tile to its level (or to the ambient level if brighter)
+// Levels are uploaded to a texture with one texel per Tile, which is smoothed between the centers of the Tiles when stretched over them
+void Map::drawLightMap(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    // Visible range of Tiles, with a margin so that smoothing does not sample texels beyond it on screen
+    sf::Vector2f viewTopLeft = target.getView().getCenter() - target.getView().getSize() / 2.f;
+    sf::Vector2f viewBottomRight = viewTopLeft + target.getView().getSize();
+    float tileSize = static_cast<float>(m_tileSize);
+    float left = std::max(std::floor(viewTopLeft.x / tileSize) - 1, 0.f);
+    float top = std::max(std::floor(viewTopLeft.y / tileSize) - 1, 0.f);
+    float right = std::min(std::ceil(viewBottomRight.x / tileSize) + 1, static_cast<float>(m_indexDimensions.x));
+    float bottom = std::min(std::ceil(viewBottomRight.y / tileSize) + 1, static_cast<float>(m_indexDimensions.y));
+    if (left >= right || top >= bottom)
+    {
+        return;
+    }
+
+    unsigned int tileLeft = static_cast<unsigned int>(left);
+    unsigned int tileTop = static_cast<unsigned int>(top);
+    unsigned int width = std::min(static_cast<unsigned int>(right - left), sf::Texture::getMaximumSize());
+    unsigned int height = std::min(static_cast<unsigned int>(bottom - top), sf::Texture::getMaximumSize());
+    if (m_lightTexture.getSize().x < width || m_lightTexture.getSize().y < height)
+    {
+        if (m_lightTexture.create(std::max(width, m_lightTexture.getSize().x), std::max(height, m_lightTexture.getSize().y)) == false)
+        {
+            return;
+        }
+        m_lightTexture.setSmooth(true);
+    }
+
+    m_lightPixels.resize(static_cast<std::size_t>(width) * height * 4);
+    std::size_t pixelIndex = 0;
+    for (unsigned int y = tileTop; y < tileTop + height; y++)
+    {
+        for (unsigned int x = tileLeft; x < tileLeft + width; x++)
+        {
+            std::uint8_t level = std::max(m_lightMap.getLevel(x, y), m_ambientLightLevel);
+            sf::Uint8 brightness = static_cast<sf::Uint8>(level * 255 / LightMap::maxLightLevel);
+            m_lightPixels[pixelIndex++] = brightness;
+            m_lightPixels[pixelIndex++] = brightness;
+            m_lightPixels[pixelIndex++] = brightness;
+            m_lightPixels[pixelIndex++] = 255;
+        }
+    }
+    m_lightTexture.update(m_lightPixels.data(), width, height, 0, 0);
+
+    sf::Sprite lightSprite(m_lightTexture, sf::IntRect(0, 0, width, height));
+    lightSprite.setPosition(tileLeft * tileSize, tileTop * tileSize);
+    lightSprite.setScale(tileSize, tileSize);
+    states.blendMode = sf::BlendMultiply;
+    target.draw(lightSprite, states);
+}
+
+// Load the chunks around the view, extended in the direction it moves, and evict the chunks far from it
+// Called every tick while streaming, with the view's movement in the last tick
+void Map::updateStreaming(const sf::FloatRect& viewRect, const sf::Vector2f& viewVelocity)
+{
+    if (m_chunkStreamer == nullptr)
+    {
+        return;
+    }
+
+    installStreamedChunks();
+
+    // Range of chunks covered by the view and its predicted position, in world coords
+    float chunkWorldSize = static_cast<float>(TileLayer::chunkSize * m_tileSize);
+    sf::Vector2f lookahead = viewVelocity * streamingLookaheadTicks;
+    float left = std::min(viewRect.left, viewRect.left + lookahead.x) / chunkWorldSize;
+    float top = std::min(viewRect.top, viewRect.top + lookahead.y) / chunkWorldSize;
+    float right = std::max(viewRect.left, viewRect.left + lookahead.x) + viewRect.width;
+    float bottom = std::max(viewRect.top, viewRect.top + lookahead.y) + viewRect.height;
+    right /= chunkWorldSize;
+    bottom /= chunkWorldSize;
+
+    // Request the chunks within the load radius, by increasing distance to the view's center so that visible chunks come first
+    const sf::Vector2u& chunkCounts = m_layers[0].getChunkCounts();
+    auto clampChunk = [](float chunk, unsigned int chunkCount) -> unsigned int
+    {
+        return static_cast<unsigned int>(std::max(0.0f, std::min(chunk, static_cast<float>(chunkCount))));
+    };
+    unsigned int loadLeft = clampChunk(std::floor(left) - m_streamingLoadRadius, chunkCounts.x);
+    unsigned int loadTop = clampChunk(std::floor(top) - m_streamingLoadRadius, chunkCounts.y);
+    unsigned int loadRight = clampChunk(std::ceil(right) + m_streamingLoadRadius, chunkCounts.x);
+    unsigned int loadBottom = clampChunk(std::ceil(bottom) + m_streamingLoadRadius, chunkCounts.y);
+
+    std::vector<std::pair<float, std::size_t>> requestedChunks;
+    sf::Vector2f viewCenter((viewRect.left + viewRect.width / 2) / chunkWorldSize, (viewRect.top + viewRect.height / 2) / chunkWorldSize);
+    for (unsigned int chunkY = loadTop; chunkY < loadBottom; chunkY++)
+    {
+        for (unsigned int chunkX = loadLeft; chunkX < loadRight; chunkX++)
+        {
+            std::size_t chunkIndex = chunkY * chunkCounts.x + chunkX;
+            if (m_chunkStates[chunkIndex] == ChunkState::Unloaded)
             {
-                outputFile << "-\n";
+                sf::Vector2f offset(chunkX + 0.5f - viewCenter.x, chunkY + 0.5f - viewCenter.y);
+                requestedChunks.emplace_back(offset.x * offset.x + offset.y * offset.y, chunkIndex);
             }
         }
+    }
+    std::sort(requestedChunks.begin(), requestedChunks.end());
+    for (const auto& requestedChunk : requestedChunks)
+    {
+        m_chunkStates[requestedChunk.second] = ChunkState::Loading;
+        m_chunkStreamer->requestLoad(requestedChunk.second % chunkCounts.x, requestedChunk.second / chunkCounts.x);
+    }
 
-        std::cout << "Map successfully saved.\n\n";
-        return true;
+    // Evict the chunks outside of the evict radius, which is larger than the load radius to avoid reloading chunks at its edge
+    float evictLeft = std::floor(left) - m_streamingEvictRadius;
+    float evictTop = std::floor(top) - m_streamingEvictRadius;
+    float evictRight = std::ceil(right) + m_streamingEvictRadius;
+    float evictBottom = std::ceil(bottom) + m_streamingEvictRadius;
+    for (std::size_t i = 0; i < m_residentChunks.size();)
+    {
+        std::size_t chunkIndex = m_residentChunks[i];
+        float chunkX = static_cast<float>(chunkIndex % chunkCounts.x);
+        float chunkY = static_cast<float>(chunkIndex / chunkCounts.x);
+        if ((chunkX < evictLeft || chunkX >= evictRight || chunkY < evictTop || chunkY >= evictBottom) && evictChunk(chunkIndex) == true)
+        {
+            m_residentChunks[i] = m_residentChunks.back();
+            m_residentChunks.pop_back();
+        }
+        else
+        {
+            i++;
+        }
     }
+}
 
-    std::cerr << "Map error: Unable to save \"" << filename << "\".\n"
-              << "Map saving failed.\n\n";
-    return false;
+// Wait for the requested chunks to be loaded and install them, used when the view has no loaded chunks yet (e.g. after loading)
+void Map::finishStreaming()
+{
+    if (m_chunkStreamer == nullptr)
+    {
+        return;
+    }
+
+    m_chunkStreamer->waitUntilIdle();
+    installStreamedChunks();
 }
 
 // Convert world coordinates to a Tile index
@@ -332,274 +1801,113 @@ void Map::updateTileTexture(const sf::Vector2u& tileIndex, MapLayer layer)
         return;
     }
 
-    // If Grass-like Tile
-    if (m_tiles[z][y][x] != nullptr && m_tiles[z][y][x]->getTileType() >= TileType::GrassTopLeftSides &&
-        m_tiles[z][y][x]->getTileType() <= TileType::GrassNoSidesCorners23)
+    std::uint16_t variant = getAutotiledId(x, y, z);
+    if (variant != getCell(x, y, z).id)
     {
-        bool isTopLeftEmpty = true;
-        bool isTopEmpty = true;
-        bool isTopRightEmpty = true;
-        bool isRightEmpty = true;
-        bool isBottomRightEmpty = true;
-        bool isBottomEmpty = true;
-        bool isBottomLeftEmpty = true;
-        bool isLeftEmpty = true;
+        addTile(static_cast<TileType>(variant), tileIndex, layer);
+    }
+}
 
-        if (x > 0)
-        {
-            if (y > 0)
-            {
-                isTopLeftEmpty = (m_tiles[z][y - 1][x - 1] == nullptr || m_tiles[z][y - 1][x - 1]->isSolid() == false);
-            }
-            else
-            {
-                isTopLeftEmpty = false;
-            }
+// Return the TileType id of a Tile's variant matching the solidity of its neighbours, or its own id if it is not autotiled
+std::uint16_t Map::getAutotiledId(unsigned int x, unsigned int y, unsigned int z) const
+{
+    auto isSolid = [this, z](unsigned int neighbourX, unsigned int neighbourY) { return isCellSolid(neighbourX, neighbourY, z); };
+    return m_autotiler.getAutotiledId(getCell(x, y, z).id, x, y, m_indexDimensions, isSolid);
+}
 
-            if (y < m_indexDimensions.y - 1)
-            {
-                isBottomLeftEmpty = (m_tiles[z][y + 1][x - 1] == nullptr || m_tiles[z][y + 1][x - 1]->isSolid() == false);
-            }
-            else
-            {
-                isBottomLeftEmpty = false;
-            }
+// Update the textures of a range of Tiles and of their neighbours, or queue them until the current edit is committed
+void Map::updateTileTextures(const sf::Vector2u& tileIndex, const sf::Vector2u& range, MapLayer layer)
+{
+    unsigned int z = static_cast<unsigned int>(layer);
 
-            isLeftEmpty = (m_tiles[z][y][x - 1] == nullptr || m_tiles[z][y][x - 1]->isSolid() == false);
-        }
-        else
-        {
-            isTopLeftEmpty = false;
-            isBottomLeftEmpty = false;
-            isLeftEmpty = false;
-        }
+    // Clamp the range and its border of neighbours to the Map's bounds
+    unsigned int left = tileIndex.x > 0 ? tileIndex.x - 1 : 0;
+    unsigned int top = tileIndex.y > 0 ? tileIndex.y - 1 : 0;
+    unsigned int right = std::min(tileIndex.x + range.x + 1, m_indexDimensions.x);
+    unsigned int bottom = std::min(tileIndex.y + range.y + 1, m_indexDimensions.y);
 
-        if (x < m_indexDimensions.x - 1)
+    for (unsigned int y = top; y < bottom; y++)
+    {
+        for (unsigned int x = left; x < right; x++)
         {
-            if (y > 0)
+            if (m_editDepth > 0)
             {
-                isTopRightEmpty = (m_tiles[z][y - 1][x + 1] == nullptr || m_tiles[z][y - 1][x + 1]->isSolid() == false);
+                // Queue each Tile once, in a set rather than with a flag in its cell, which later edits to the cell would clear
+                // (empty cells need no update)
+                if (getCell(x, y, z).isEmpty() == false)
+                {
+                    m_pendingTextureUpdates.insert(static_cast<std::uint64_t>(z) << 32 | y << 16 | x);
+                }
             }
             else
             {
-                isTopRightEmpty = false;
+                updateTileTexture(sf::Vector2u(x, y), layer);
             }
+        }
+    }
+}
 
-            if (y < m_indexDimensions.y - 1)
-            {
-                isBottomRightEmpty = (m_tiles[z][y + 1][x + 1] == nullptr || m_tiles[z][y + 1][x + 1]->isSolid() == false);
-            }
-            else
-            {
-                isBottomRightEmpty = false;
-            }
+// Start an edit, during which Tile texture updates are only queued, until the matching commitEdit()
+// Edits can be nested, in which case the queued updates are applied when the outermost edit is committed
+void Map::beginEdit()
+{
+    m_editDepth++;
+}
 
-            isRightEmpty = (m_tiles[z][y][x + 1] == nullptr || m_tiles[z][y][x + 1]->isSolid() == false);
-        }
-        else
-        {
-            isTopRightEmpty = false;
-            isBottomRightEmpty = false;
-            isRightEmpty = false;
-        }
+// Finish an edit, updating the texture of each Tile queued during the edit once
+void Map::commitEdit()
+{
+    if (m_editDepth == 0 || --m_editDepth > 0)
+    {
+        return;
+    }
 
-        if (y > 0)
-        {
-            isTopEmpty = (m_tiles[z][y - 1][x] == nullptr || m_tiles[z][y - 1][x]->isSolid() == false);
-        }
-        else
+    for (std::uint64_t key : m_pendingTextureUpdates)
+    {
+        unsigned int x = key & 0xFFFF;
+        unsigned int y = (key >> 16) & 0xFFFF;
+        unsigned int z = static_cast<unsigned int>(key >> 32);
+        if (x >= m_indexDimensions.x || y >= m_indexDimensions.y)
         {
-            isTopEmpty = false;
+            continue;
         }
 
-        if (y < m_indexDimensions.y - 1)
-        {
-            isBottomEmpty = (m_tiles[z][y + 1][x] == nullptr || m_tiles[z][y + 1][x]->isSolid() == false);
-        }
-        else
-        {
-            isBottomEmpty = false;
-        }
+        updateTileTexture(sf::Vector2u(x, y), static_cast<MapLayer>(z));
+    }
+    m_pendingTextureUpdates.clear();
+}
 
-        if (isTopEmpty == true && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == false && isBottomRightEmpty == false)
-        {
-            addTile(TileType::GrassTopLeftSides, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == false && isBottomEmpty == false &&
-                 ((isBottomRightEmpty == false && isBottomLeftEmpty == false) || (isBottomLeftEmpty == true && isBottomRightEmpty == true)))
-        {
-            addTile(TileType::GrassTopSide, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == true && isBottomLeftEmpty == false && isBottomEmpty == false)
-        {
-            addTile(TileType::GrassTopRightSides, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == false &&
-                 ((isTopRightEmpty == false && isBottomRightEmpty == false) || (isTopRightEmpty == true && isBottomRightEmpty == true)) &&
-                 isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == false)
-        {
-            addTile(TileType::GrassLeftSide, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == true &&
-                 isRightEmpty == false && isBottomLeftEmpty == false && isBottomEmpty == false && isBottomRightEmpty == false)
-        {
-            addTile(TileType::GrassNoSides, sf::Vector2u(x, y), layer);
-        }
-        else if (((isTopLeftEmpty == false && isBottomLeftEmpty == false) || (isTopLeftEmpty == true && isBottomLeftEmpty == true)) &&
-                 isTopEmpty == false && isLeftEmpty == false && isRightEmpty == true && isBottomEmpty == false)
-        {
-            addTile(TileType::GrassRightSide, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassBotLeftSide, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == false &&
-                 ((isTopRightEmpty == false && isTopLeftEmpty == false) || (isTopRightEmpty == true && isTopLeftEmpty == true)) &&
-                 isLeftEmpty == false && isRightEmpty == false && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassBotSide, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == false && isTopEmpty == false && isLeftEmpty == false && isRightEmpty == true && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassBotRightSides, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == true && isRightEmpty == true && isBottomEmpty == false)
-        {
-            addTile(TileType::GrassTopLeftRightSides, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == false && isLeftEmpty == true && isRightEmpty == true && isBottomEmpty == false)
-        {
-            addTile(TileType::GrassLeftRightSides, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == false && isLeftEmpty == true && isRightEmpty == true && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassBotLeftRightSides, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassTopBotLeftSides, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == false && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassTopBotSides, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == true && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassTopBotRightSides, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == true && isRightEmpty == true && isBottomEmpty == true)
-        {
-            addTile(TileType::Grass4Sides, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == false && isBottomRightEmpty == true)
-        {
-            addTile(TileType::GrassTopLeftSidesCorner3, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == false && isBottomLeftEmpty == false &&
-                 isBottomEmpty == false && isBottomRightEmpty == true)
-        {
-            addTile(TileType::GrassTopSideCorner3, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == false && isBottomLeftEmpty == true &&
-                 isBottomEmpty == false && isBottomRightEmpty == false)
-        {
-            addTile(TileType::GrassTopSideCorner4, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == true && isLeftEmpty == false && isRightEmpty == true && isBottomLeftEmpty == true && isBottomEmpty == false)
-        {
-            addTile(TileType::GrassTopRightSidesCorner4, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == true && isRightEmpty == false &&
-                 isBottomEmpty == false && isBottomRightEmpty == true)
-        {
-            addTile(TileType::GrassLeftSideCorner3, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomLeftEmpty == false && isBottomEmpty == false && isBottomRightEmpty == true)
-        {
-            addTile(TileType::GrassNoSidesCorner3, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomLeftEmpty == true && isBottomEmpty == false && isBottomRightEmpty == false)
-        {
-            addTile(TileType::GrassNoSidesCorner4, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == false && isTopEmpty == false && isLeftEmpty == false && isRightEmpty == true &&
-                 isBottomLeftEmpty == true && isBottomEmpty == false)
-        {
-            addTile(TileType::GrassRightSideCorner4, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == false &&
-                 isBottomRightEmpty == false)
-        {
-            addTile(TileType::GrassLeftSideCorner2, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomRightEmpty == false && isBottomEmpty == false && isBottomRightEmpty == false)
-        {
-            addTile(TileType::GrassNoSidesCorner2, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == true && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomLeftEmpty == false && isBottomEmpty == false && isBottomRightEmpty == false)
-        {
-            addTile(TileType::GrassNoSidesCorner1, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == true && isTopEmpty == false && isLeftEmpty == false && isRightEmpty == true &&
-                 isBottomLeftEmpty == false && isBottomEmpty == false)
-        {
-            addTile(TileType::GrassRightSideCorner1, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == true && isRightEmpty == false && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassBotLeftSidesCorner2, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassBotSideCorner2, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == true && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassBotSideCorner1, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == true && isTopEmpty == false && isLeftEmpty == false && isRightEmpty == true && isBottomEmpty == true)
-        {
-            addTile(TileType::GrassBotRightSidesCorner1, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == true && isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomLeftEmpty == true && isBottomEmpty == false && isBottomRightEmpty == true)
-        {
-            addTile(TileType::GrassNoSides4Corners, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == true && isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomLeftEmpty == false && isBottomEmpty == false && isBottomRightEmpty == false)
-        {
-            addTile(TileType::GrassNoSidesCorners12, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomLeftEmpty == true && isBottomEmpty == false && isBottomRightEmpty == true)
-        {
-            addTile(TileType::GrassNoSidesCorners34, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == true && isTopEmpty == false && isTopRightEmpty == false && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomLeftEmpty == true && isBottomEmpty == false && isBottomRightEmpty == false)
-        {
-            addTile(TileType::GrassNoSidesCorners14, sf::Vector2u(x, y), layer);
-        }
-        else if (isTopLeftEmpty == false && isTopEmpty == false && isTopRightEmpty == true && isLeftEmpty == false &&
-                 isRightEmpty == false && isBottomLeftEmpty == false && isBottomEmpty == false && isBottomRightEmpty == true)
+// Resolve the TileTypes of a decoded chunk, leaving the cells of unknown TileTypes empty
+void Map::resolveChunk(TileLayer::Chunk& chunk)
+{
+    if (chunk.tileCount == 0)
+    {
+        return;
+    }
+
+    // Unknown TileTypes leave their cells empty, as when loading text Maps
+    for (auto& cell : chunk.cells)
+    {
+        if (cell.isEmpty() == true)
         {
-            addTile(TileType::GrassNoSidesCorners23, sf::Vector2u(x, y), layer);
+            continue;
         }
-        else
+        if (resolveTileType(cell.id) == false)
         {
-            addTile(TileType::GrassNoSides, sf::Vector2u(x, y), layer);
+            cell = TileCell{0, 0};
+            chunk.tileCount--;
+            continue;
         }
+        cell.flags = 0;
     }
 }
 
+// Add a TileType's texture to the Tile atlas on first use, returning false for unknown TileTypes
+bool Map::resolveTileType(std::uint16_t id)
+{
+    return m_tileRegistry.resolve(id, m_resourceManager);
+}
+
 // Create a new Tile at the specified index
 void Map::addTile(TileType tileType, const sf::Vector2u& tileIndex, MapLayer layer, bool updateTextures)
 {
@@ -618,164 +1926,20 @@ void Map::addTile(TileType tileType, const sf::Vector2u& tileIndex, MapLayer lay
         return;
     }
 
-    // Delete existing Tile if found
-    if (m_tiles[z][y][x] != nullptr)
-    {
-        delete m_tiles[z][y][x];
-    }
-
-    switch (tileType)
-    {
-    case TileType::GrassTopLeftSides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopLeftSides"), tileType);
-        break;
-    case TileType::GrassTopSide:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopSide"), tileType);
-        break;
-    case TileType::GrassTopRightSides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopRightSides"), tileType);
-        break;
-    case TileType::GrassLeftSide:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassLeftSide"), tileType);
-        break;
-    case TileType::GrassNoSides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassNoSides"), tileType);
-        break;
-    case TileType::GrassRightSide:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassRightSide"), tileType);
-        break;
-    case TileType::GrassBotLeftSide:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassBotLeftSides"), tileType);
-        break;
-    case TileType::GrassBotSide:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassBotSide"), tileType);
-        break;
-    case TileType::GrassBotRightSides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassBotRightSides"), tileType);
-        break;
-    case TileType::GrassTopLeftRightSides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopLeftRightSides"), tileType);
-        break;
-    case TileType::GrassLeftRightSides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassLeftRightSides"), tileType);
-        break;
-    case TileType::GrassBotLeftRightSides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassBotLeftRightSides"), tileType);
-        break;
-    case TileType::GrassTopBotLeftSides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopBotLeftSides"), tileType);
-        break;
-    case TileType::GrassTopBotSides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopBotSides"), tileType);
-        break;
-    case TileType::GrassTopBotRightSides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopBotRightSides"), tileType);
-        break;
-    case TileType::Grass4Sides:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grass4Sides"), tileType);
-        break;
-    case TileType::GrassTopLeftSidesCorner3:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopLeftSidesCorner3"), tileType);
-        break;
-    case TileType::GrassTopSideCorner3:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopSideCorner3"), tileType);
-        break;
-    case TileType::GrassTopSideCorner4:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopSideCorner4"), tileType);
-        break;
-    case TileType::GrassTopRightSidesCorner4:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassTopRightSidesCorner4"), tileType);
-        break;
-    case TileType::GrassLeftSideCorner3:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassLeftSideCorner3"), tileType);
-        break;
-    case TileType::GrassNoSidesCorner3:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassNoSidesCorner3"), tileType);
-        break;
-    case TileType::GrassNoSidesCorner4:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassNoSidesCorner4"), tileType);
-        break;
-    case TileType::GrassRightSideCorner4:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassRightSideCorner4"), tileType);
-        break;
-    case TileType::GrassLeftSideCorner2:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassLeftSideCorner2"), tileType);
-        break;
-    case TileType::GrassNoSidesCorner2:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassNoSidesCorner2"), tileType);
-        break;
-    case TileType::GrassNoSidesCorner1:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassNoSidesCorner1"), tileType);
-        break;
-    case TileType::GrassRightSideCorner1:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassRightSideCorner1"), tileType);
-        break;
-    case TileType::GrassBotLeftSidesCorner2:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassBotLeftSidesCorner2"), tileType);
-        break;
-    case TileType::GrassBotSideCorner2:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassBotSideCorner2"), tileType);
-        break;
-    case TileType::GrassBotSideCorner1:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassBotSideCorner1"), tileType);
-        break;
-    case TileType::GrassBotRightSidesCorner1:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassBotRightSidesCorner1"), tileType);
-        break;
-    case TileType::GrassNoSides4Corners:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassNoSides4Corners"), tileType);
-        break;
-    case TileType::GrassNoSidesCorners12:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassNoSidesCorners12"), tileType);
-        break;
-    case TileType::GrassNoSidesCorners34:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassNoSidesCorners34"), tileType);
-        break;
-    case TileType::GrassNoSidesCorners14:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassNoSidesCorners14"), tileType);
-        break;
-    case TileType::GrassNoSidesCorners23:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("grassNoSidesCorners23"), tileType);
-        break;
-    case TileType::Wood:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("wood"), tileType);
-        break;
-    case TileType::Ladder:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("ladder"), tileType);
-        m_tiles[z][y][x]->setSolid(false);
-        break;
-    case TileType::LadderTop:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("ladder"), tileType);
-        break;
-    case TileType::Vine:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("vine"), tileType);
-        m_tiles[z][y][x]->setSolid(false);
-        break;
-    case TileType::Post:
-        m_tiles[z][y][x] = new Tile(m_resourceManager.getTexture("post"), tileType);
-        m_tiles[z][y][x]->setSolid(false);
-        break;
-    default:
-        m_tiles[z][y][x] = nullptr;
-        break;
-    }
-
-    if (m_tiles[z][y][x] != nullptr)
-    {
-        m_tiles[z][y][x]->setPosition(sf::Vector2f(tileIndex.x * m_tileSize, tileIndex.y * m_tileSize));
-        m_tiles[z][y][x]->setDimensions(sf::Vector2f(m_tileSize, m_tileSize));
-        m_tiles[z][y][x]->setColor(m_layerColors[z]);
+    // Leave the cell empty for unknown TileTypes
+    std::size_t id = static_cast<std::size_t>(tileType);
+    if (id > maxTileTypeId || resolveTileType(static_cast<std::uint16_t>(id)) == false)
+    {
+        setCell(x, y, z, TileCell{0, 0});
+    }
+    else
+    {
+        setCell(x, y, z, TileCell{static_cast<std::uint16_t>(id), 0});
     }
 
     if (updateTextures == true)
     {
-        for (int i = -1; i <= 1; i++)
-        {
-            for (int j = -1; j <= 1; j++)
-            {
-                updateTileTexture(sf::Vector2u(x + i, y + j), layer);
-            }
-        }
+        updateTileTextures(sf::Vector2u(x, y), sf::Vector2u(1, 1), layer);
     }
 }
 
@@ -797,13 +1961,7 @@ void Map::addTileRange(TileType tileType, const sf::Vector2u& tileIndex, const s
 
     if (updateTextures == true)
     {
-        for (int y = -1; y <= static_cast<int>(range.y); y++)
-        {
-            for (int x = -1; x <= static_cast<int>(range.x); x++)
-            {
-                updateTileTexture(sf::Vector2u(tileIndex.x + x, tileIndex.y + y), layer);
-            }
-        }
+        updateTileTextures(tileIndex, range, layer);
     }
 }
 
@@ -825,22 +1983,11 @@ void Map::removeTile(const sf::Vector2u& tileIndex, MapLayer layer, bool updateT
         return;
     }
 
-    // Delete existing Tile if found
-    if (m_tiles[z][y][x] != nullptr)
-    {
-        delete m_tiles[z][y][x];
-        m_tiles[z][y][x] = nullptr;
-    }
+    setCell(x, y, z, TileCell{0, 0});
 
     if (updateTextures == true)
     {
-        for (int i = -1; i <= 1; i++)
-        {
-            for (int j = -1; j <= 1; j++)
-            {
-                updateTileTexture(sf::Vector2u(x + i, y + j), layer);
-            }
-        }
+        updateTileTextures(sf::Vector2u(x, y), sf::Vector2u(1, 1), layer);
     }
 }
 
@@ -862,13 +2009,7 @@ void Map::removeTileRange(const sf::Vector2u& tileIndex, const sf::Vector2u& ran
 
     if (updateTextures == true)
     {
-        for (int y = -1; y <= static_cast<int>(range.y); y++)
-        {
-            for (int x = -1; x <= static_cast<int>(range.x); x++)
-            {
-                updateTileTexture(sf::Vector2u(tileIndex.x + x, tileIndex.y + y), layer);
-            }
-        }
+        updateTileTextures(tileIndex, range, layer);
     }
 }
 
@@ -879,89 +2020,76 @@ void Map::resize(const sf::Vector2u& indexDimensions)
     {
         return;
     }
+    if (m_chunkStreamer != nullptr)
+    {
+        std::cerr << "Map error: Streamed Maps cannot be resized.\n";
+        return;
+    }
 
     // Max dimensions
-    sf::Vector2u newIndexDimensions = sf::Vector2u(std::min(static_cast<float>(indexDimensions.x), maxDimensions.x),
-                                                   std::min(static_cast<float>(indexDimensions.y), maxDimensions.y));
+    sf::Vector2u newIndexDimensions =
+        sf::Vector2u(std::min(indexDimensions.x, maxDimensions.x), std::min(indexDimensions.y, maxDimensions.y));
 
-    for (unsigned int z = 0; z < m_layerCount; z++)
+    // Only the chunk tables are rebuilt, the overlapping chunks are kept as they are
+    for (auto& tileLayer : m_layers)
     {
-        // Delete excess Tiles on the Y axis
-        for (unsigned int y = newIndexDimensions.y; y < m_indexDimensions.y; y++)
-        {
-            for (unsigned int x = 0; x < m_indexDimensions.x; x++)
-            {
-                delete m_tiles[z][y][x];
-            }
-        }
-        m_tiles[z].resize(newIndexDimensions.y);
-
-        // Delete excess Tiles on the X axis
-        for (unsigned int y = 0; y < newIndexDimensions.y; y++)
-        {
-            for (unsigned int x = newIndexDimensions.x; x < m_indexDimensions.x; x++)
-            {
-                delete m_tiles[z][y][x];
-            }
-            m_tiles[z][y].resize(newIndexDimensions.x);
-        }
-
-        // Set new Tiles on the Y axis to nullptr
-        for (unsigned int y = m_indexDimensions.y; y < newIndexDimensions.y; y++)
-        {
-            for (unsigned int x = 0; x < newIndexDimensions.x; x++)
-            {
-                m_tiles[z][y][x] = nullptr;
-            }
-        }
-        // Set new Tiles on the X axis to nullptr
-        for (unsigned int y = 0; y < newIndexDimensions.y; y++)
-        {
-            for (unsigned int x = m_indexDimensions.x; x < newIndexDimensions.x; x++)
-            {
-                m_tiles[z][y][x] = nullptr;
-            }
-        }
+        tileLayer.resize(newIndexDimensions);
     }
+    resetChunkMeshes();
 
     m_indexDimensions = newIndexDimensions;
+    rebuildSolidityMask();
+    resetSaveJournal("");
 }
 
-// Remove all Tiles by deleting them and setting them to nullptr, but conserve the Map's index dimensions
+// Remove all Tiles by emptying their cells, but conserve the Map's index dimensions
 void Map::clear()
 {
+    if (m_chunkStreamer != nullptr)
+    {
+        std::cerr << "Map error: Streamed Maps cannot be cleared.\n";
+        return;
+    }
+
     for (unsigned int z = 0; z < m_layerCount; z++)
     {
-        for (unsigned int y = 0; y < m_indexDimensions.y; y++)
-        {
-            for (unsigned int x = 0; x < m_indexDimensions.x; x++)
-            {
-                delete m_tiles[z][y][x];
-                m_tiles[z][y][x] = nullptr;
-            }
-        }
+        m_layers[z].clear();
+        setLayerDirty(z);
     }
+    m_solidityMask.fill(false);
+    m_collisionLayer.resize(m_indexDimensions);
+    std::fill(m_occlusionMasks.begin(), m_occlusionMasks.end(), OcclusionMask());
+    m_lightMap.resize(m_indexDimensions);
+    resetSaveJournal("");
 }
 
-// Remove all Tiles on a Layer by deleting them and setting them to nullptr
+// Remove all Tiles on a Layer by emptying their cells
 void Map::clearLayer(MapLayer layer)
 {
     if (layer == MapLayer::Count)
     {
         return;
     }
+    if (m_chunkStreamer != nullptr)
+    {
+        std::cerr << "Map error: Layers of streamed Maps cannot be cleared.\n";
+        return;
+    }
 
-    for (unsigned int y = 0; y < m_indexDimensions.y; y++)
+    m_layers[static_cast<unsigned int>(layer)].clear();
+    setLayerDirty(static_cast<unsigned int>(layer));
+    if (layer == MapLayer::Solid)
     {
-        for (unsigned int x = 0; x < m_indexDimensions.x; x++)
-        {
-            delete m_tiles[static_cast<unsigned int>(layer)][y][x];
-            m_tiles[static_cast<unsigned int>(layer)][y][x] = nullptr;
-        }
+        m_solidityMask.fill(false);
+        m_collisionLayer.resize(m_indexDimensions);
+        std::fill(m_occlusionMasks.begin(), m_occlusionMasks.end(), OcclusionMask());
+        setLayerDirty(static_cast<unsigned int>(MapLayer::Background));
     }
+    rebuildLightMap();
+    resetSaveJournal("");
 }
 
-// Set a layer's Tiles' color
+// Set the color applied to a layer's Tiles when drawn
 void Map::setLayerColor(sf::Color color, MapLayer layer)
 {
     if (layer == MapLayer::Count)
@@ -969,19 +2097,43 @@ void Map::setLayerColor(sf::Color color, MapLayer layer)
         return;
     }
 
-    unsigned int z = static_cast<unsigned int>(layer);
+    m_layerColors[static_cast<unsigned int>(layer)] = color;
+    setLayerDirty(static_cast<unsigned int>(layer));
+    if (layer == MapLayer::Solid)
+    {
+        setLayerDirty(static_cast<unsigned int>(MapLayer::Background)); // Background Tiles are only occluded by an opaque Solid layer
+    }
+}
+
+// Set the radii around the view, in chunks, within which streamed chunks are loaded, and beyond which they are evicted
+void Map::setStreamingRadii(unsigned int loadRadius, unsigned int evictRadius)
+{
+    m_streamingLoadRadius = loadRadius;
+    m_streamingEvictRadius = std::max(evictRadius, loadRadius + 1);
+}
 
-    m_layerColors[z] = color;
+// Set a moving light (e.g. carried by an Entity) at a position in world coordinates, turning it off if the level is 0
+// Lights are identified by their id, and only the cells they reached and reach are recomputed when they move to another Tile
+void Map::setMovingLight(std::size_t id, const sf::Vector2f& position, std::uint8_t level)
+{
+    bool isInside = position.x >= 0 && position.y >= 0 && position.x < m_indexDimensions.x * static_cast<float>(m_tileSize) &&
+                    position.y < m_indexDimensions.y * static_cast<float>(m_tileSize);
+    std::uint8_t lightLevel = isInside == true ? level : 0;
+    m_lightMap.setMovingLight(id, LightMap::PointLight{coordsToTileIndex(position), lightLevel});
+}
 
-    for (unsigned int y = 0; y < m_indexDimensions.y; y++)
+// Set whether a layer is drawn from pre-rendered chunks, which is faster for layers that rarely change
+void Map::setLayerBaked(MapLayer layer, bool isBaked)
+{
+    if (layer == MapLayer::Count)
     {
-        for (unsigned int x = 0; x < m_indexDimensions.x; x++)
-        {
-            if (m_tiles[z][y][x] != nullptr)
-            {
-                m_tiles[z][y][x]->setColor(m_layerColors[z]);
-            }
-        }
+        return;
+    }
+
+    m_isLayerBaked[static_cast<unsigned int>(layer)] = isBaked;
+    if (isBaked == false)
+    {
+        releaseBakedChunks(static_cast<unsigned int>(layer));
     }
 }
 
@@ -997,24 +2149,65 @@ bool Map::isNull() const
     return m_indexDimensions == sf::Vector2u(0, 0);
 }
 
-// Return a pointer to a const Tile at given coords
-const Tile* Map::getKTilePtr(const sf::Vector2u& index, MapLayer layer) const
+// Return the estimated memory used by the Map's cells, in bytes
+std::size_t Map::getMemoryUsage() const
+{
+    std::size_t bytes = 0;
+    for (const auto& tileLayer : m_layers)
+    {
+        bytes += tileLayer.getMemoryUsage();
+    }
+    bytes += m_solidityMask.getMemoryUsage();
+    bytes += m_collisionLayer.getMemoryUsage();
+    bytes += m_lightMap.getMemoryUsage();
+    return bytes;
+}
+
+// Return a view of the Tile at given coords, which is null if the cell is empty or outside of the Map
+// When streaming, cells of chunks which are not loaded are solid on the Solid layer, so that Entities cannot fall through them
+Tile Map::getTile(const sf::Vector2u& index, MapLayer layer) const
 {
     if (layer == MapLayer::Count || index.x >= m_indexDimensions.x || index.y >= m_indexDimensions.y)
     {
-        return nullptr;
+        return Tile();
+    }
+
+    std::size_t chunkIndex = (index.y / TileLayer::chunkSize) * m_layers[0].getChunkCounts().x + index.x / TileLayer::chunkSize;
+    if (m_chunkStreamer != nullptr && m_chunkStates[chunkIndex] != ChunkState::Loaded)
+    {
+        if (layer == MapLayer::Solid)
+        {
+            std::uint16_t id = static_cast<std::uint16_t>(TileType::Unloaded);
+            return Tile(TileCell{id, 0}, &m_tileRegistry.getDef(id), index, m_tileSize);
+        }
+        return Tile();
     }
 
-    return m_tiles[static_cast<int>(layer)][index.y][index.x];
+    const TileCell& cell = getCell(index.x, index.y, static_cast<unsigned int>(layer));
+    return Tile(cell, &m_tileRegistry.getDef(cell.id), index, m_tileSize);
 }
 
-// Return a pointer to a Tile at given coords
-Tile* Map::getTilePtr(const sf::Vector2u& index, MapLayer layer) const
+// Append the collision rectangles of the Solid layer overlapping a range of Tiles to rects, merging dirty regions first
+void Map::getCollisionRects(const sf::Vector2u& tileIndex, const sf::Vector2u& range, std::vector<CollisionRect>& rects) const
 {
-    if (layer == MapLayer::Count || index.x >= m_indexDimensions.x || index.y >= m_indexDimensions.y)
+    if (tileIndex.x >= m_indexDimensions.x || tileIndex.y >= m_indexDimensions.y || range.x == 0 || range.y == 0)
     {
-        return nullptr;
+        return;
     }
 
-    return m_tiles[static_cast<int>(layer)][index.y][index.x];
+    unsigned int right = range.x < m_indexDimensions.x - tileIndex.x ? tileIndex.x + range.x : m_indexDimensions.x;
+    unsigned int bottom = range.y < m_indexDimensions.y - tileIndex.y ? tileIndex.y + range.y : m_indexDimensions.y;
+    unsigned int lastRegionX = (right - 1) / CollisionLayer::regionSize;
+    unsigned int lastRegionY = (bottom - 1) / CollisionLayer::regionSize;
+    for (unsigned int regionY = tileIndex.y / CollisionLayer::regionSize; regionY <= lastRegionY; regionY++)
+    {
+        for (unsigned int regionX = tileIndex.x / CollisionLayer::regionSize; regionX <= lastRegionX; regionX++)
+        {
+            if (m_collisionLayer.isRegionDirty(regionX, regionY) == true)
+            {
+                updateCollisionRegion(regionX, regionY);
+            }
+        }
+    }
+    m_collisionLayer.findRects(tileIndex, range, rects);
 }
@@ -0,0 +1,388 @@
+#include "Level/MapFile.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "Core/FileManager.h"
+
+namespace
+{
+    const char magic[4] = {'T', 'M', 'A', 'P'};
+    const unsigned int currentVersion = 1;
+    const std::size_t headerSize = 24;
+    const std::size_t indexEntrySize = 8;
+    const unsigned int maxDimension = 1 << 16;
+
+    enum ChunkEncoding : std::uint8_t
+    {
+        Raw = 0,
+        RunLength = 1
+    };
+
+    std::uint16_t readUint16(const char* data)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        return static_cast<std::uint16_t>(bytes[0] | bytes[1] << 8);
+    }
+
+    std::uint32_t readUint32(const char* data)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        return static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8 |
+               static_cast<std::uint32_t>(bytes[2]) << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+    }
+
+    void writeUint16(std::vector<char>& buffer, std::uint16_t value)
+    {
+        buffer.push_back(static_cast<char>(value & 0xFF));
+        buffer.push_back(static_cast<char>(value >> 8));
+    }
+
+    void writeUint32(std::vector<char>& buffer, std::uint32_t value)
+    {
+        for (unsigned int i = 0; i < 4; i++)
+        {
+            buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+        }
+    }
+
+    void overwriteUint32(std::vector<char>& buffer, std::size_t offset, std::uint32_t value)
+    {
+        for (unsigned int i = 0; i < 4; i++)
+        {
+            buffer[offset + i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+        }
+    }
+} // namespace
+
+MapFile::MapFile()
+    : m_version(0)
+    , m_layerCount(0)
+    , m_dimensions(0, 0)
+    , m_chunkCounts(0, 0)
+    , m_tileSize(0)
+{
+}
+
+// Return the offset of a chunk's entry in the index
+std::size_t MapFile::getIndexEntryOffset(unsigned int z, std::size_t chunkIndex) const
+{
+    return headerSize + (static_cast<std::size_t>(z) * m_chunkCounts.x * m_chunkCounts.y + chunkIndex) * indexEntrySize;
+}
+
+// Map a binary Map file and validate its header and index, without reading the chunks
+bool MapFile::open(const std::string& filename)
+{
+    close();
+    if (m_file.open(filename) == false)
+    {
+        return false;
+    }
+
+    const char* data = m_file.getData();
+    if (m_file.getSize() < headerSize || std::memcmp(data, magic, sizeof(magic)) != 0)
+    {
+        std::cerr << "MapFile error: \"" << filename << "\" is not a binary Map file.\n";
+        close();
+        return false;
+    }
+
+    m_version = readUint16(data + 4);
+    if (m_version > currentVersion)
+    {
+        std::cerr << "MapFile error: \"" << filename << "\" has unsupported version " << m_version << ".\n";
+        close();
+        return false;
+    }
+
+    m_layerCount = readUint16(data + 6);
+    m_dimensions = sf::Vector2u(readUint32(data + 8), readUint32(data + 12));
+    m_tileSize = readUint32(data + 16);
+    if (readUint32(data + 20) != TileLayer::chunkSize || m_dimensions.x > maxDimension || m_dimensions.y > maxDimension)
+    {
+        std::cerr << "MapFile error: \"" << filename << "\" has unsupported dimensions or chunk size.\n";
+        close();
+        return false;
+    }
+    m_chunkCounts = sf::Vector2u((m_dimensions.x + TileLayer::chunkSize - 1) / TileLayer::chunkSize,
+                                 (m_dimensions.y + TileLayer::chunkSize - 1) / TileLayer::chunkSize);
+
+    // Check that the index and every chunk it references lie within the file
+    std::size_t chunkCount = static_cast<std::size_t>(m_chunkCounts.x) * m_chunkCounts.y;
+    if (getIndexEntryOffset(m_layerCount, 0) > m_file.getSize())
+    {
+        std::cerr << "MapFile error: \"" << filename << "\" is truncated.\n";
+        close();
+        return false;
+    }
+    for (std::size_t i = 0; i < chunkCount * m_layerCount; i++)
+    {
+        const char* entry = data + headerSize + i * indexEntrySize;
+        std::size_t offset = readUint32(entry);
+        std::size_t size = readUint32(entry + 4);
+        if (offset != 0 && (size == 0 || offset + size > m_file.getSize()))
+        {
+            std::cerr << "MapFile error: \"" << filename << "\" has an invalid chunk index.\n";
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Unmap the file
+void MapFile::close()
+{
+    m_file.close();
+    m_version = 0;
+    m_layerCount = 0;
+    m_dimensions = sf::Vector2u(0, 0);
+    m_chunkCounts = sf::Vector2u(0, 0);
+    m_tileSize = 0;
+}
+
+// Append a chunk's TileType ids to a buffer, run-length encoded unless that would be larger than the raw ids
+void MapFile::encodeChunk(const TileLayer::Chunk& chunk, std::vector<char>& buffer)
+{
+    std::size_t runCount = 1;
+    for (std::size_t i = 1; i < chunk.cells.size(); i++)
+    {
+        if (chunk.cells[i].id != chunk.cells[i - 1].id)
+        {
+            runCount++;
+        }
+    }
+
+    if (runCount * 4 < chunk.cells.size() * 2)
+    {
+        buffer.push_back(static_cast<char>(ChunkEncoding::RunLength));
+        std::size_t runStart = 0;
+        for (std::size_t i = 1; i <= chunk.cells.size(); i++)
+        {
+            if (i == chunk.cells.size() || chunk.cells[i].id != chunk.cells[runStart].id)
+            {
+                writeUint16(buffer, static_cast<std::uint16_t>(i - runStart));
+                writeUint16(buffer, chunk.cells[runStart].id);
+                runStart = i;
+            }
+        }
+    }
+    else
+    {
+        buffer.push_back(static_cast<char>(ChunkEncoding::Raw));
+        for (const auto& cell : chunk.cells)
+        {
+            writeUint16(buffer, cell.id);
+        }
+    }
+}
+
+// Decode a chunk of a layer, leaving its cells' flags cleared
+// Return false if the chunk is empty or its data is corrupted
+bool MapFile::readChunk(unsigned int z, unsigned int chunkX, unsigned int chunkY, TileLayer::Chunk& chunk) const
+{
+    if (hasChunk(z, chunkX, chunkY) == false)
+    {
+        return false;
+    }
+
+    const char* entry = m_file.getData() + getIndexEntryOffset(z, chunkY * m_chunkCounts.x + chunkX);
+    const char* data = m_file.getData() + readUint32(entry);
+    return decodeChunk(data, readUint32(entry + 4), chunk);
+}
+
+// Decode a chunk's TileType ids from encoded data, leaving its cells' flags cleared
+// Return false if the data is corrupted
+bool MapFile::decodeChunk(const char* data, std::size_t size, TileLayer::Chunk& chunk)
+{
+    if (size == 0)
+    {
+        return false;
+    }
+
+    const char* dataEnd = data + size;
+    chunk.tileCount = 0;
+    if (static_cast<std::uint8_t>(*data) == ChunkEncoding::Raw)
+    {
+        if (dataEnd - (data + 1) != static_cast<std::ptrdiff_t>(chunk.cells.size() * 2))
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < chunk.cells.size(); i++)
+        {
+            chunk.cells[i] = TileCell{readUint16(data + 1 + i * 2), 0};
+            chunk.tileCount += chunk.cells[i].isEmpty() ? 0 : 1;
+        }
+        return true;
+    }
+    else if (static_cast<std::uint8_t>(*data) == ChunkEncoding::RunLength)
+    {
+        std::size_t cellIndex = 0;
+        for (const char* run = data + 1; run + 4 <= dataEnd; run += 4)
+        {
+            std::size_t runLength = readUint16(run);
+            std::uint16_t id = readUint16(run + 2);
+            if (cellIndex + runLength > chunk.cells.size())
+            {
+                return false;
+            }
+            std::fill_n(chunk.cells.begin() + cellIndex, runLength, TileCell{id, 0});
+            cellIndex += runLength;
+            chunk.tileCount += id != 0 ? runLength : 0;
+        }
+        return cellIndex == chunk.cells.size();
+    }
+
+    return false;
+}
+
+// Write a binary Map file, getting each chunk of each layer from a function returning nullptr for empty chunks
+bool MapFile::save(const std::string& filename, const sf::Vector2u& dimensions, unsigned int tileSize, unsigned int layerCount,
+                   const ChunkGetter& getChunk)
+{
+    sf::Vector2u chunkCounts((dimensions.x + TileLayer::chunkSize - 1) / TileLayer::chunkSize,
+                             (dimensions.y + TileLayer::chunkSize - 1) / TileLayer::chunkSize);
+    std::size_t chunkCount = static_cast<std::size_t>(chunkCounts.x) * chunkCounts.y;
+
+    std::vector<char> buffer(magic, magic + sizeof(magic));
+    writeUint16(buffer, currentVersion);
+    writeUint16(buffer, static_cast<std::uint16_t>(layerCount));
+    writeUint32(buffer, dimensions.x);
+    writeUint32(buffer, dimensions.y);
+    writeUint32(buffer, tileSize);
+    writeUint32(buffer, TileLayer::chunkSize);
+
+    // Reserve the index, filled in as chunks are written
+    buffer.resize(headerSize + layerCount * chunkCount * indexEntrySize, 0);
+    for (unsigned int z = 0; z < layerCount; z++)
+    {
+        for (unsigned int chunkY = 0; chunkY < chunkCounts.y; chunkY++)
+        {
+            for (unsigned int chunkX = 0; chunkX < chunkCounts.x; chunkX++)
+            {
+                const TileLayer::Chunk* chunk = getChunk(z, chunkX, chunkY);
+                if (chunk == nullptr || chunk->tileCount == 0)
+                {
+                    continue;
+                }
+
+                std::size_t entryOffset = headerSize + (z * chunkCount + chunkY * chunkCounts.x + chunkX) * indexEntrySize;
+                std::size_t dataOffset = buffer.size();
+                encodeChunk(*chunk, buffer);
+                overwriteUint32(buffer, entryOffset, static_cast<std::uint32_t>(dataOffset));
+                overwriteUint32(buffer, entryOffset + 4, static_cast<std::uint32_t>(buffer.size() - dataOffset));
+            }
+        }
+    }
+
+    std::ofstream outputFile(FileManager::resourcePath() + filename, std::ios::binary);
+    if (!outputFile || !outputFile.write(buffer.data(), buffer.size()))
+    {
+        std::cerr << "MapFile error: Unable to save \"" << filename << "\".\n";
+        return false;
+    }
+
+    return true;
+}
+
+// Save some chunk positions (all layers) of an existing binary Map file again, without rewriting the rest of the file
+// The chunks are appended and then their index entries rewritten, so an interrupted save leaves each chunk either old or new
+// Return false, leaving the file unchanged, if it does not match the Map or if it should be saved in full instead because
+// unreferenced data would outweigh the chunks in use
+bool MapFile::saveChunks(const std::string& filename, const sf::Vector2u& dimensions, unsigned int tileSize, unsigned int layerCount,
+                         const std::vector<std::size_t>& chunkIndices, const ChunkGetter& getChunk)
+{
+    std::fstream file(FileManager::resourcePath() + filename, std::ios::in | std::ios::out | std::ios::binary);
+    char header[headerSize];
+    if (!file || !file.read(header, headerSize) || std::memcmp(header, magic, sizeof(magic)) != 0 ||
+        readUint16(header + 4) != currentVersion || readUint16(header + 6) != layerCount || readUint32(header + 8) != dimensions.x ||
+        readUint32(header + 12) != dimensions.y || readUint32(header + 16) != tileSize || readUint32(header + 20) != TileLayer::chunkSize)
+    {
+        return false;
+    }
+
+    sf::Vector2u chunkCounts((dimensions.x + TileLayer::chunkSize - 1) / TileLayer::chunkSize,
+                             (dimensions.y + TileLayer::chunkSize - 1) / TileLayer::chunkSize);
+    std::size_t chunkCount = static_cast<std::size_t>(chunkCounts.x) * chunkCounts.y;
+    std::vector<char> index(layerCount * chunkCount * indexEntrySize);
+    if (!file.read(index.data(), index.size()) || !file.seekg(0, std::ios::end))
+    {
+        return false;
+    }
+    std::uint64_t fileSize = static_cast<std::uint64_t>(file.tellg());
+
+    std::uint64_t usedSize = 0;
+    for (std::size_t entryOffset = 0; entryOffset < index.size(); entryOffset += indexEntrySize)
+    {
+        usedSize += readUint32(index.data() + entryOffset) != 0 ? readUint32(index.data() + entryOffset + 4) : 0;
+    }
+
+    // Encode the chunks after the end of the file, updating their entries in the index copy
+    std::vector<char> buffer;
+    std::vector<std::size_t> changedEntryOffsets;
+    for (std::size_t chunkIndex : chunkIndices)
+    {
+        if (chunkIndex >= chunkCount)
+        {
+            return false;
+        }
+        for (unsigned int z = 0; z < layerCount; z++)
+        {
+            std::size_t entryOffset = (z * chunkCount + chunkIndex) * indexEntrySize;
+            usedSize -= readUint32(index.data() + entryOffset) != 0 ? readUint32(index.data() + entryOffset + 4) : 0;
+
+            std::uint32_t dataOffset = 0;
+            std::uint32_t dataSize = 0;
+            const TileLayer::Chunk* chunk = getChunk(z, static_cast<unsigned int>(chunkIndex % chunkCounts.x),
+                                                     static_cast<unsigned int>(chunkIndex / chunkCounts.x));
+            if (chunk != nullptr && chunk->tileCount > 0)
+            {
+                std::size_t bufferOffset = buffer.size();
+                encodeChunk(*chunk, buffer);
+                dataOffset = static_cast<std::uint32_t>(fileSize + bufferOffset);
+                dataSize = static_cast<std::uint32_t>(buffer.size() - bufferOffset);
+                usedSize += dataSize;
+            }
+            overwriteUint32(index, entryOffset, dataOffset);
+            overwriteUint32(index, entryOffset + 4, dataSize);
+            changedEntryOffsets.push_back(entryOffset);
+        }
+    }
+
+    // Offsets are 32 bits, and a file mostly made of unreferenced data is compacted by saving it in full
+    std::uint64_t newFileSize = fileSize + buffer.size();
+    if (newFileSize > 0xFFFFFFFF || newFileSize - headerSize - index.size() - usedSize > usedSize)
+    {
+        return false;
+    }
+
+    // The chunks are written before the index entries referencing them
+    if (!file.seekp(static_cast<std::streamoff>(fileSize)) || !file.write(buffer.data(), buffer.size()) || !file.flush())
+    {
+        std::cerr << "MapFile error: Unable to save \"" << filename << "\".\n";
+        return false;
+    }
+    for (std::size_t entryOffset : changedEntryOffsets)
+    {
+        if (!file.seekp(static_cast<std::streamoff>(headerSize + entryOffset)) || !file.write(index.data() + entryOffset, indexEntrySize))
+        {
+            std::cerr << "MapFile error: Unable to save \"" << filename << "\".\n";
+            return false;
+        }
+    }
+
+    return static_cast<bool>(file.flush());
+}
+
+// Return true if a chunk of a layer has Tiles
+bool MapFile::hasChunk(unsigned int z, unsigned int chunkX, unsigned int chunkY) const
+{
+    if (z >= m_layerCount || chunkX >= m_chunkCounts.x || chunkY >= m_chunkCounts.y)
+    {
+        return false;
+    }
+
+    return readUint32(m_file.getData() + getIndexEntryOffset(z, chunkY * m_chunkCounts.x + chunkX)) != 0;
+}
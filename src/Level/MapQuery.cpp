@@ -0,0 +1,259 @@
+#include "Level/MapQuery.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    // Return -1, 0 or 1 depending on the sign of a value
+    int getSign(float value)
+    {
+        return value > 0 ? 1 : (value < 0 ? -1 : 0);
+    }
+} // namespace
+
+MapQuery::MapQuery(const Map& map)
+    : m_map(map)
+{
+}
+
+// Get the range of Tiles overlapped by an area (in world coordinates) clamped to the Map, returning false if it is empty
+bool MapQuery::getTileRange(const sf::FloatRect& area, sf::Vector2u& tileIndex, sf::Vector2u& range) const
+{
+    const sf::Vector2u& dimensions = m_map.getIndexDimensions();
+    float tileSize = static_cast<float>(m_map.getTileSize());
+    if (area.width <= 0 || area.height <= 0 || tileSize <= 0)
+    {
+        return false;
+    }
+
+    // Edges of the area lying exactly on a Tile boundary do not overlap the next Tile
+    float left = std::max(std::floor(area.left / tileSize), 0.f);
+    float top = std::max(std::floor(area.top / tileSize), 0.f);
+    float right = std::min(std::ceil((area.left + area.width) / tileSize), static_cast<float>(dimensions.x));
+    float bottom = std::min(std::ceil((area.top + area.height) / tileSize), static_cast<float>(dimensions.y));
+    if (left >= right || top >= bottom)
+    {
+        return false;
+    }
+
+    tileIndex = sf::Vector2u(static_cast<unsigned int>(left), static_cast<unsigned int>(top));
+    range = sf::Vector2u(static_cast<unsigned int>(right - left), static_cast<unsigned int>(bottom - top));
+    return true;
+}
+
+// Cast a ray through the Solid layer, visiting only the Tiles it crosses (DDA), and return the first solid Tile hit
+RaycastHit MapQuery::raycast(const Ray& ray) const
+{
+    RaycastHit hit{false, sf::Vector2u(0, 0), ray.origin, sf::Vector2f(0, 0), 0};
+
+    float length = std::sqrt(ray.direction.x * ray.direction.x + ray.direction.y * ray.direction.y);
+    float tileSize = static_cast<float>(m_map.getTileSize());
+    if (length == 0 || tileSize <= 0 || !(ray.maxDistance >= 0))
+    {
+        return hit;
+    }
+
+    const SolidityMask& mask = m_map.getSolidityMask();
+    const sf::Vector2u& dimensions = m_map.getIndexDimensions();
+    sf::Vector2f direction = ray.direction / length;
+    int stepX = getSign(direction.x);
+    int stepY = getSign(direction.y);
+    long x = static_cast<long>(std::floor(ray.origin.x / tileSize));
+    long y = static_cast<long>(std::floor(ray.origin.y / tileSize));
+
+    // Distance along the ray to the next vertical and horizontal Tile boundaries, and between two of them
+    float nextX = stepX == 0 ? infinity : ((x + (stepX > 0 ? 1 : 0)) * tileSize - ray.origin.x) / direction.x;
+    float nextY = stepY == 0 ? infinity : ((y + (stepY > 0 ? 1 : 0)) * tileSize - ray.origin.y) / direction.y;
+    float deltaX = stepX == 0 ? infinity : tileSize / std::abs(direction.x);
+    float deltaY = stepY == 0 ? infinity : tileSize / std::abs(direction.y);
+
+    float distance = 0;
+    sf::Vector2f normal(0, 0);
+    while (distance <= ray.maxDistance)
+    {
+        if (x >= 0 && y >= 0 && mask.isSolid(static_cast<unsigned int>(x), static_cast<unsigned int>(y)) == true)
+        {
+            hit.isHit = true;
+            hit.tileIndex = sf::Vector2u(static_cast<unsigned int>(x), static_cast<unsigned int>(y));
+            hit.position = ray.origin + direction * distance;
+            hit.normal = normal;
+            hit.distance = distance;
+            return hit;
+        }
+
+        // Stop once outside of the Map and moving away from it
+        if ((x < 0 && stepX <= 0) || (y < 0 && stepY <= 0) || (x >= static_cast<long>(dimensions.x) && stepX >= 0) ||
+            (y >= static_cast<long>(dimensions.y) && stepY >= 0))
+        {
+            break;
+        }
+
+        if (nextX < nextY)
+        {
+            distance = nextX;
+            nextX += deltaX;
+            x += stepX;
+            normal = sf::Vector2f(static_cast<float>(-stepX), 0);
+        }
+        else
+        {
+            distance = nextY;
+            nextY += deltaY;
+            y += stepY;
+            normal = sf::Vector2f(0, static_cast<float>(-stepY));
+        }
+    }
+
+    hit.position = ray.origin + direction * ray.maxDistance;
+    hit.distance = ray.maxDistance;
+    return hit;
+}
+
+// Cast many rays (e.g. all line of sight checks of a tick), writing one RaycastHit per ray to hits
+void MapQuery::raycast(const std::vector<Ray>& rays, std::vector<RaycastHit>& hits) const
+{
+    hits.resize(rays.size());
+    for (std::size_t i = 0; i < rays.size(); i++)
+    {
+        hits[i] = raycast(rays[i]);
+    }
+}
+
+// Return true if no solid Tile lies on the segment between two points
+bool MapQuery::isLineOfSightClear(const sf::Vector2f& start, const sf::Vector2f& end) const
+{
+    sf::Vector2f direction = end - start;
+    float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (distance == 0)
+    {
+        return raycast(Ray{start, sf::Vector2f(1, 0), 0}).isHit == false;
+    }
+    return raycast(Ray{start, direction, distance}).isHit == false;
+}
+
+// Move a box by a displacement and return the first solid Tile it touches, with the time and normal of the contact
+// Platform Tiles only stop boxes coming from above, and Tiles already overlapped by the box at the start are ignored
+SweepHit MapQuery::sweepBox(const sf::FloatRect& box, const sf::Vector2f& displacement) const
+{
+    SweepHit hit{false, sf::Vector2u(0, 0), sf::Vector2f(box.left + displacement.x, box.top + displacement.y), sf::Vector2f(0, 0), 1};
+
+    // Only the Tiles overlapped by the box's path can be touched
+    sf::FloatRect path(std::min(box.left, box.left + displacement.x), std::min(box.top, box.top + displacement.y),
+                       box.width + std::abs(displacement.x), box.height + std::abs(displacement.y));
+    sf::Vector2u tileIndex;
+    sf::Vector2u range;
+    if (getTileRange(path, tileIndex, range) == false)
+    {
+        return hit;
+    }
+
+    // Tiles touching the path's edges are included, so that boxes resting against a Tile stop at a time of 0
+    const SolidityMask& mask = m_map.getSolidityMask();
+    const sf::Vector2u& dimensions = m_map.getIndexDimensions();
+    tileIndex.x -= tileIndex.x > 0 ? 1 : 0;
+    tileIndex.y -= tileIndex.y > 0 ? 1 : 0;
+    unsigned int right = std::min(tileIndex.x + range.x + 2, dimensions.x);
+    unsigned int bottom = std::min(tileIndex.y + range.y + 2, dimensions.y);
+    if (mask.isAnySolid(tileIndex, sf::Vector2u(right - tileIndex.x, bottom - tileIndex.y)) == false)
+    {
+        return hit;
+    }
+
+    float tileSize = static_cast<float>(m_map.getTileSize());
+    for (unsigned int y = tileIndex.y; y < bottom; y++)
+    {
+        for (int x = mask.findFirstSolidInRow(tileIndex.x, y, right - tileIndex.x); x >= 0;
+             x = mask.findFirstSolidInRow(x + 1, y, right - x - 1))
+        {
+            // Times at which the box starts and stops overlapping the Tile on each axis (slab test)
+            float tileLeft = x * tileSize;
+            float tileTop = y * tileSize;
+            float entryX = -infinity;
+            float exitX = infinity;
+            if (displacement.x != 0)
+            {
+                float nearX = displacement.x > 0 ? tileLeft - (box.left + box.width) : tileLeft + tileSize - box.left;
+                float farX = displacement.x > 0 ? tileLeft + tileSize - box.left : tileLeft - (box.left + box.width);
+                entryX = nearX / displacement.x;
+                exitX = farX / displacement.x;
+            }
+            else if (box.left + box.width <= tileLeft || box.left >= tileLeft + tileSize)
+            {
+                continue;
+            }
+            float entryY = -infinity;
+            float exitY = infinity;
+            if (displacement.y != 0)
+            {
+                float nearY = displacement.y > 0 ? tileTop - (box.top + box.height) : tileTop + tileSize - box.top;
+                float farY = displacement.y > 0 ? tileTop + tileSize - box.top : tileTop - (box.top + box.height);
+                entryY = nearY / displacement.y;
+                exitY = farY / displacement.y;
+            }
+            else if (box.top + box.height <= tileTop || box.top >= tileTop + tileSize)
+            {
+                continue;
+            }
+
+            float entry = std::max(entryX, entryY);
+            float exit = std::min(exitX, exitY);
+            if (entry >= exit || entry < 0 || entry > 1 || (hit.isHit == true && entry >= hit.time))
+            {
+                continue;
+            }
+
+            sf::Vector2f normal = entryX > entryY ? sf::Vector2f(static_cast<float>(-getSign(displacement.x)), 0)
+                                                  : sf::Vector2f(0, static_cast<float>(-getSign(displacement.y)));
+            sf::Vector2u index(static_cast<unsigned int>(x), y);
+            if (normal.y >= 0 && m_map.getTile(index, MapLayer::Solid).getDef().collision == TileCollision::Platform)
+            {
+                continue;
+            }
+
+            hit.isHit = true;
+            hit.tileIndex = index;
+            hit.normal = normal;
+            hit.time = entry;
+        }
+    }
+
+    hit.position = sf::Vector2f(box.left + displacement.x * hit.time, box.top + displacement.y * hit.time);
+    return hit;
+}
+
+// Return true if no solid Tile overlaps an area
+bool MapQuery::isAreaClear(const sf::FloatRect& area) const
+{
+    sf::Vector2u tileIndex;
+    sf::Vector2u range;
+    return getTileRange(area, tileIndex, range) == false || m_map.getSolidityMask().isAnySolid(tileIndex, range) == false;
+}
+
+// Append the Tiles of a category overlapping an area on a layer to tiles, and return how many were found
+std::size_t MapQuery::findTiles(const sf::FloatRect& area, MapLayer layer, TileCategory category, std::vector<Tile>& tiles) const
+{
+    sf::Vector2u tileIndex;
+    sf::Vector2u range;
+    if (layer == MapLayer::Count || getTileRange(area, tileIndex, range) == false)
+    {
+        return 0;
+    }
+
+    std::size_t foundCount = 0;
+    for (unsigned int y = tileIndex.y; y < tileIndex.y + range.y; y++)
+    {
+        for (unsigned int x = tileIndex.x; x < tileIndex.x + range.x; x++)
+        {
+            Tile tile = m_map.getTile(sf::Vector2u(x, y), layer);
+            if (tile.isNull() == false && tile.getDef().category == category)
+            {
+                tiles.push_back(tile);
+                foundCount++;
+            }
+        }
+    }
+    return foundCount;
+}
@@ -0,0 +1,175 @@
+#include "Level/SolidityMask.h"
+#include <algorithm>
+
+namespace
+{
+    // Return a word with the bits from first to last (inclusive) set
+    std::uint64_t getBitRange(unsigned int first, unsigned int last)
+    {
+        return (~std::uint64_t(0) << first) & (~std::uint64_t(0) >> (63 - last));
+    }
+
+    // Return the index of the lowest set bit of a non-zero word
+    unsigned int getLowestBit(std::uint64_t word)
+    {
+        unsigned int bit = 0;
+        while ((word & 1) == 0)
+        {
+            word >>= 1;
+            bit++;
+        }
+        return bit;
+    }
+} // namespace
+
+SolidityMask::SolidityMask()
+    : m_dimensions(0, 0)
+    , m_wordsPerRow(0)
+{
+}
+
+// Resize the mask, leaving every cell not solid
+void SolidityMask::resize(const sf::Vector2u& dimensions)
+{
+    m_dimensions = dimensions;
+    m_wordsPerRow = (dimensions.x + 63) / 64;
+    m_words.assign(m_wordsPerRow * dimensions.y, 0);
+}
+
+// Set every cell as solid or not
+void SolidityMask::fill(bool isSolid)
+{
+    if (isSolid == false)
+    {
+        std::fill(m_words.begin(), m_words.end(), 0);
+        return;
+    }
+
+    // Padding bits past the end of each row stay cleared, so that they never count as solid
+    for (unsigned int y = 0; y < m_dimensions.y; y++)
+    {
+        setRowSolid(0, y, m_dimensions.x, true);
+    }
+}
+
+// Set whether a cell is solid
+void SolidityMask::setSolid(unsigned int x, unsigned int y, bool isSolid)
+{
+    if (x >= m_dimensions.x || y >= m_dimensions.y)
+    {
+        return;
+    }
+
+    std::uint64_t& word = m_words[y * m_wordsPerRow + (x >> 6)];
+    std::uint64_t bit = std::uint64_t(1) << (x & 63);
+    word = isSolid == true ? word | bit : word & ~bit;
+}
+
+// Set whether a range of cells of a row is solid, a word at a time
+void SolidityMask::setRowSolid(unsigned int x, unsigned int y, unsigned int count, bool isSolid)
+{
+    if (y >= m_dimensions.y || x >= m_dimensions.x || count == 0)
+    {
+        return;
+    }
+
+    unsigned int last = (count < m_dimensions.x - x ? x + count : m_dimensions.x) - 1;
+    for (unsigned int wordX = x >> 6; wordX <= last >> 6; wordX++)
+    {
+        std::uint64_t bits = getBitRange(wordX == x >> 6 ? x & 63 : 0, wordX == last >> 6 ? last & 63 : 63);
+        std::uint64_t& word = m_words[y * m_wordsPerRow + wordX];
+        word = isSolid == true ? word | bits : word & ~bits;
+    }
+}
+
+// Return true if any cell of a range of a row is solid
+bool SolidityMask::isAnySolidInRow(unsigned int x, unsigned int y, unsigned int count) const
+{
+    return findFirstSolidInRow(x, y, count) >= 0;
+}
+
+// Return true if every cell of a range of a row is solid (cells outside of the mask are not solid)
+bool SolidityMask::isAllSolidInRow(unsigned int x, unsigned int y, unsigned int count) const
+{
+    if (count == 0)
+    {
+        return true;
+    }
+    if (y >= m_dimensions.y || x >= m_dimensions.x || count > m_dimensions.x - x)
+    {
+        return false;
+    }
+
+    unsigned int last = x + count - 1;
+    for (unsigned int wordX = x >> 6; wordX <= last >> 6; wordX++)
+    {
+        std::uint64_t bits = getBitRange(wordX == x >> 6 ? x & 63 : 0, wordX == last >> 6 ? last & 63 : 63);
+        if ((m_words[y * m_wordsPerRow + wordX] & bits) != bits)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Return true if any cell of a rectangle is solid
+bool SolidityMask::isAnySolid(const sf::Vector2u& index, const sf::Vector2u& range) const
+{
+    if (index.y >= m_dimensions.y)
+    {
+        return false;
+    }
+
+    unsigned int bottom = range.y < m_dimensions.y - index.y ? index.y + range.y : m_dimensions.y;
+    for (unsigned int y = index.y; y < bottom; y++)
+    {
+        if (findFirstSolidInRow(index.x, y, range.x) >= 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Return true if every cell of a rectangle is solid (cells outside of the mask are not solid)
+bool SolidityMask::isAllSolid(const sf::Vector2u& index, const sf::Vector2u& range) const
+{
+    if (range.x == 0 || range.y == 0)
+    {
+        return true;
+    }
+    if (index.y >= m_dimensions.y || range.y > m_dimensions.y - index.y)
+    {
+        return false;
+    }
+
+    for (unsigned int y = index.y; y < index.y + range.y; y++)
+    {
+        if (isAllSolidInRow(index.x, y, range.x) == false)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Return the x index of the first solid cell of a range of a row, or -1 if none is solid
+int SolidityMask::findFirstSolidInRow(unsigned int x, unsigned int y, unsigned int count) const
+{
+    if (y >= m_dimensions.y || x >= m_dimensions.x || count == 0)
+    {
+        return -1;
+    }
+
+    unsigned int last = (count < m_dimensions.x - x ? x + count : m_dimensions.x) - 1;
+    for (unsigned int wordX = x >> 6; wordX <= last >> 6; wordX++)
+    {
+        std::uint64_t bits = getBitRange(wordX == x >> 6 ? x & 63 : 0, wordX == last >> 6 ? last & 63 : 63);
+        std::uint64_t word = m_words[y * m_wordsPerRow + wordX] & bits;
+        if (word != 0)
+        {
+            return static_cast<int>(wordX * 64 + getLowestBit(word));
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,117 @@
+#include "Level/TileAtlas.h"
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+    const unsigned int atlasWidth = 1024;
+    const unsigned int initialAtlasHeight = 256;
+    const unsigned int padding = 1; // Transparent pixels between textures, to avoid sampling neighbours when zoomed
+} // namespace
+
+TileAtlas::TileAtlas(std::size_t idCount)
+    : m_textureRects(idCount)
+    , m_shelfPosition(0, 0)
+    , m_shelfHeight(0)
+{
+}
+
+// Grow the atlas to at least the specified height, keeping the textures already added
+bool TileAtlas::grow(unsigned int height)
+{
+    unsigned int newHeight = std::max(std::max(height, m_image.getSize().y * 2), initialAtlasHeight);
+    if (newHeight > sf::Texture::getMaximumSize())
+    {
+        newHeight = sf::Texture::getMaximumSize();
+        if (newHeight < height)
+        {
+            std::cerr << "TileAtlas error: Atlas would exceed the maximum texture size (" << newHeight << ").\n";
+            return false;
+        }
+    }
+
+    sf::Image image;
+    image.create(atlasWidth, newHeight, sf::Color::Transparent);
+    if (m_image.getSize().y > 0)
+    {
+        image.copy(m_image, 0, 0);
+    }
+    m_image = image;
+
+    if (m_texture.create(atlasWidth, newHeight) == false)
+    {
+        std::cerr << "TileAtlas error: Unable to create atlas texture.\n";
+        return false;
+    }
+    m_texture.update(m_image);
+    return true;
+}
+
+// Copy a TileType's texture into the atlas, returning false if it does not fit
+bool TileAtlas::add(std::size_t id, const sf::Texture& texture)
+{
+    if (id >= m_textureRects.size())
+    {
+        return false;
+    }
+
+    sf::Vector2u size = texture.getSize();
+    if (size.x == 0 || size.y == 0 || size.x > atlasWidth)
+    {
+        std::cerr << "TileAtlas error: Texture of TileType " << id << " has invalid dimensions (" << size.x << 'x' << size.y << ").\n";
+        return false;
+    }
+
+    // Start a new shelf if the texture does not fit in the current one
+    if (m_shelfPosition.x + size.x > atlasWidth)
+    {
+        m_shelfPosition = sf::Vector2u(0, m_shelfPosition.y + m_shelfHeight + padding);
+        m_shelfHeight = 0;
+    }
+    if (m_shelfPosition.y + size.y > m_image.getSize().y && grow(m_shelfPosition.y + size.y) == false)
+    {
+        return false;
+    }
+
+    sf::Image image = texture.copyToImage();
+    m_image.copy(image, m_shelfPosition.x, m_shelfPosition.y);
+    m_texture.update(image, m_shelfPosition.x, m_shelfPosition.y);
+    m_textureRects[id] = sf::IntRect(m_shelfPosition.x, m_shelfPosition.y, size.x, size.y);
+
+    m_shelfPosition.x += size.x + padding;
+    m_shelfHeight = std::max(m_shelfHeight, size.y);
+    return true;
+}
+
+// Replace the pixels of a TileType's texture in the atlas (e.g. with another frame of its animation), keeping its region
+bool TileAtlas::update(std::size_t id, const sf::Image& image)
+{
+    if (contains(id) == false)
+    {
+        return false;
+    }
+
+    const sf::IntRect& textureRect = m_textureRects[id];
+    if (image.getSize() != sf::Vector2u(textureRect.width, textureRect.height))
+    {
+        return false;
+    }
+
+    m_image.copy(image, textureRect.left, textureRect.top);
+    m_texture.update(image, textureRect.left, textureRect.top);
+    return true;
+}
+
+// Forget all textures, reusing the atlas' space for the next ones added
+void TileAtlas::clear()
+{
+    if (m_image.getSize().y > 0)
+    {
+        m_image.create(atlasWidth, m_image.getSize().y, sf::Color::Transparent);
+        m_texture.update(m_image);
+    }
+
+    std::fill(m_textureRects.begin(), m_textureRects.end(), sf::IntRect());
+    m_shelfPosition = sf::Vector2u(0, 0);
+    m_shelfHeight = 0;
+}
@@ -0,0 +1,192 @@
+#include "Level/TileLayer.h"
+#include <algorithm>
+
+constexpr unsigned int TileLayer::chunkSizeLog2;
+constexpr unsigned int TileLayer::chunkSize;
+
+const TileCell TileLayer::s_emptyCell = {0, 0};
+
+TileLayer::TileLayer()
+    : m_dimensions(0, 0)
+    , m_chunkCounts(0, 0)
+    , m_allocatedChunkCount(0)
+{
+}
+
+// Empty the cells of a chunk which lie outside of the layer's dimensions (after shrinking)
+void TileLayer::clearOutsideBounds(Chunk& chunk, const sf::Vector2u& chunkIndex)
+{
+    for (unsigned int y = 0; y < chunkSize; y++)
+    {
+        for (unsigned int x = 0; x < chunkSize; x++)
+        {
+            TileCell& cell = chunk.cells[y * chunkSize + x];
+            bool isOutsideBounds = chunkIndex.x * chunkSize + x >= m_dimensions.x || chunkIndex.y * chunkSize + y >= m_dimensions.y;
+            if (isOutsideBounds == true && cell.isEmpty() == false)
+            {
+                cell = s_emptyCell;
+                chunk.tileCount--;
+            }
+        }
+    }
+}
+
+// Return a chunk for writing, first copying it if it is shared with a copy of the layer
+// Copies are only made and destroyed on the thread owning the layer, so a chunk is not shared if it has a single owner
+TileLayer::Chunk& TileLayer::getWritableChunk(std::shared_ptr<Chunk>& chunk)
+{
+    if (chunk.use_count() > 1)
+    {
+        chunk = std::make_shared<Chunk>(*chunk);
+    }
+    return *chunk;
+}
+
+// Resize the layer to the specified dimensions in cells, keeping the Tiles within the new dimensions
+// Only the table of chunk pointers is rebuilt, and only the chunks crossing the new edges are scanned
+void TileLayer::resize(const sf::Vector2u& dimensions)
+{
+    sf::Vector2u chunkCounts((dimensions.x + chunkSize - 1) / chunkSize, (dimensions.y + chunkSize - 1) / chunkSize);
+    std::vector<std::shared_ptr<Chunk>> chunks(static_cast<std::size_t>(chunkCounts.x) * chunkCounts.y);
+
+    m_dimensions = dimensions;
+    m_allocatedChunkCount = 0;
+    for (unsigned int chunkY = 0; chunkY < std::min(chunkCounts.y, m_chunkCounts.y); chunkY++)
+    {
+        for (unsigned int chunkX = 0; chunkX < std::min(chunkCounts.x, m_chunkCounts.x); chunkX++)
+        {
+            std::shared_ptr<Chunk>& chunk = m_chunks[chunkY * m_chunkCounts.x + chunkX];
+            if (chunk == nullptr)
+            {
+                continue;
+            }
+
+            // Chunks on the new right and bottom edges may have Tiles outside of the new dimensions
+            if (chunkX == chunkCounts.x - 1 || chunkY == chunkCounts.y - 1)
+            {
+                clearOutsideBounds(getWritableChunk(chunk), sf::Vector2u(chunkX, chunkY));
+            }
+
+            if (chunk->tileCount > 0)
+            {
+                chunks[chunkY * chunkCounts.x + chunkX] = std::move(chunk);
+                m_allocatedChunkCount++;
+            }
+        }
+    }
+
+    m_chunks = std::move(chunks);
+    m_chunkCounts = chunkCounts;
+}
+
+// Remove all Tiles, freeing every chunk, but conserve the layer's dimensions
+void TileLayer::clear()
+{
+    for (auto& chunk : m_chunks)
+    {
+        chunk.reset();
+    }
+    m_allocatedChunkCount = 0;
+}
+
+// Set the cell at given index, allocating its chunk on the first Tile and freeing it after the last one is removed
+void TileLayer::setCell(unsigned int x, unsigned int y, TileCell cell)
+{
+    std::shared_ptr<Chunk>& chunk = m_chunks[(y >> chunkSizeLog2) * m_chunkCounts.x + (x >> chunkSizeLog2)];
+    if (chunk == nullptr)
+    {
+        if (cell.isEmpty() == true)
+        {
+            return;
+        }
+        chunk = std::make_shared<Chunk>();
+        chunk->cells.fill(s_emptyCell);
+        chunk->tileCount = 0;
+        m_allocatedChunkCount++;
+    }
+
+    Chunk& writableChunk = getWritableChunk(chunk);
+    TileCell& currentCell = writableChunk.cells[(y & (chunkSize - 1)) * chunkSize + (x & (chunkSize - 1))];
+    if (currentCell.isEmpty() == true && cell.isEmpty() == false)
+    {
+        writableChunk.tileCount++;
+    }
+    else if (currentCell.isEmpty() == false && cell.isEmpty() == true)
+    {
+        writableChunk.tileCount--;
+    }
+    currentCell = cell;
+
+    if (writableChunk.tileCount == 0)
+    {
+        chunk.reset();
+        m_allocatedChunkCount--;
+    }
+}
+
+// Replace a whole chunk, whose tileCount must match its cells, allocating or freeing it as needed
+void TileLayer::setChunk(unsigned int chunkX, unsigned int chunkY, const Chunk& chunk)
+{
+    std::shared_ptr<Chunk>& currentChunk = m_chunks[chunkY * m_chunkCounts.x + chunkX];
+    if (chunk.tileCount == 0)
+    {
+        if (currentChunk != nullptr)
+        {
+            currentChunk.reset();
+            m_allocatedChunkCount--;
+        }
+        return;
+    }
+
+    if (currentChunk == nullptr)
+    {
+        m_allocatedChunkCount++;
+    }
+    if (currentChunk == nullptr || currentChunk.use_count() > 1)
+    {
+        currentChunk = std::make_shared<Chunk>(chunk);
+    }
+    else
+    {
+        *currentChunk = chunk;
+    }
+    clearOutsideBounds(*currentChunk, sf::Vector2u(chunkX, chunkY));
+    if (currentChunk->tileCount == 0)
+    {
+        currentChunk.reset();
+        m_allocatedChunkCount--;
+    }
+}
+
+// Replace a whole chunk by taking ownership of it (nullptr to free it), its tileCount matching its cells
+void TileLayer::setChunk(unsigned int chunkX, unsigned int chunkY, std::unique_ptr<Chunk> chunk)
+{
+    std::shared_ptr<Chunk>& currentChunk = m_chunks[chunkY * m_chunkCounts.x + chunkX];
+    if (currentChunk != nullptr)
+    {
+        m_allocatedChunkCount--;
+    }
+    currentChunk = std::move(chunk);
+    if (currentChunk == nullptr)
+    {
+        return;
+    }
+
+    // Only chunks on the right and bottom edges may have cells outside of the dimensions
+    if (chunkX == m_chunkCounts.x - 1 || chunkY == m_chunkCounts.y - 1)
+    {
+        clearOutsideBounds(*currentChunk, sf::Vector2u(chunkX, chunkY));
+    }
+    if (currentChunk->tileCount == 0)
+    {
+        currentChunk.reset();
+        return;
+    }
+    m_allocatedChunkCount++;
+}
+
+// Return the memory used by the chunk table and the allocated chunks, in bytes
+std::size_t TileLayer::getMemoryUsage() const
+{
+    return m_chunks.capacity() * sizeof(std::shared_ptr<Chunk>) + m_allocatedChunkCount * sizeof(Chunk);
+}
@@ -0,0 +1,361 @@
+#include "Level/TileRegistry.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "Core/FileManager.h"
+#include "Level/LightMap.h"
+
+namespace
+{
+    // Return an image of half the dimensions (rounded up), each pixel averaging up to 2x2 pixels weighted by their alpha
+    sf::Image downsample(const sf::Image& image)
+    {
+        sf::Vector2u size = image.getSize();
+        sf::Image result;
+        result.create((size.x + 1) / 2, (size.y + 1) / 2, sf::Color::Transparent);
+        for (unsigned int y = 0; y < result.getSize().y; y++)
+        {
+            for (unsigned int x = 0; x < result.getSize().x; x++)
+            {
+                unsigned int sum[4] = {0, 0, 0, 0};
+                unsigned int pixelCount = 0;
+                for (unsigned int j = 2 * y; j < std::min(2 * y + 2, size.y); j++)
+                {
+                    for (unsigned int i = 2 * x; i < std::min(2 * x + 2, size.x); i++)
+                    {
+                        sf::Color color = image.getPixel(i, j);
+                        sum[0] += color.r * color.a;
+                        sum[1] += color.g * color.a;
+                        sum[2] += color.b * color.a;
+                        sum[3] += color.a;
+                        pixelCount++;
+                    }
+                }
+                if (sum[3] > 0)
+                {
+                    result.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(sum[0] / sum[3]), static_cast<sf::Uint8>(sum[1] / sum[3]),
+                                                    static_cast<sf::Uint8>(sum[2] / sum[3]), static_cast<sf::Uint8>(sum[3] / pixelCount)));
+                }
+            }
+        }
+        return result;
+    }
+
+    // Return true if no pixel of an image is transparent, even partially
+    bool isImageOpaque(const sf::Image& image)
+    {
+        const sf::Uint8* pixels = image.getPixelsPtr();
+        std::size_t pixelCount = static_cast<std::size_t>(image.getSize().x) * image.getSize().y;
+        for (std::size_t i = 0; i < pixelCount; i++)
+        {
+            if (pixels[i * 4 + 3] != 255)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+TileRegistry::TileRegistry(std::size_t idCount)
+    : m_atlas(idCount)
+    , m_lodImages(idCount)
+{
+    m_defs.resize(idCount);
+    for (std::size_t id = 0; id < m_defs.size(); id++)
+    {
+        m_defs[id] = TileDef{"", sf::IntRect(), false, TileCollision::None, 0, 0, getCategory(static_cast<std::uint16_t>(id)), false, {}};
+    }
+}
+
+// Parse a definition line: a TileType id, its texture name ('-' if not rendered), and optional properties among
+// "solid", "platform", "climb:<speed factor>" and "frames:<texture>@<ticks>,..." (e.g. "200 ladder climb:1")
+bool TileRegistry::parseDef(const std::string& line, std::uint16_t& id, TileDef& def) const
+{
+    std::istringstream lineStream(line);
+    if (!(lineStream >> id >> def.textureName) || id == 0 || id >= m_defs.size())
+    {
+        return false;
+    }
+    if (def.textureName == "-")
+    {
+        def.textureName.clear();
+    }
+
+    def.textureRect = sf::IntRect();
+    def.isOpaque = false;
+    def.collision = TileCollision::None;
+    def.climbFactor = 0;
+    def.lightLevel = 0;
+    def.category = getCategory(id);
+    def.isDefined = true;
+    def.frames.clear();
+
+    std::string property;
+    while (lineStream >> property)
+    {
+        if (property == "solid")
+        {
+            def.collision = TileCollision::Solid;
+        }
+        else if (property == "platform")
+        {
+            def.collision = TileCollision::Platform;
+        }
+        else if (property.compare(0, 6, "climb:") == 0)
+        {
+            std::istringstream factorStream(property.substr(6));
+            if (!(factorStream >> def.climbFactor) || def.climbFactor <= 0)
+            {
+                return false;
+            }
+        }
+        else if (property.compare(0, 6, "light:") == 0)
+        {
+            std::istringstream levelStream(property.substr(6));
+            unsigned int lightLevel = 0;
+            if (!(levelStream >> lightLevel) || lightLevel == 0 || lightLevel > LightMap::maxLightLevel)
+            {
+                return false;
+            }
+            def.lightLevel = static_cast<std::uint8_t>(lightLevel);
+        }
+        else if (property.compare(0, 7, "frames:") == 0)
+        {
+            if (def.textureName.empty() == true || parseFrames(property.substr(7), def) == false)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Parse a comma-separated list of animation frames, each a texture name and a duration in ticks (e.g. "water1@8,water2@8")
+bool TileRegistry::parseFrames(const std::string& frameList, TileDef& def) const
+{
+    std::istringstream listStream(frameList);
+    std::string frame;
+    while (std::getline(listStream, frame, ','))
+    {
+        std::size_t separator = frame.find('@');
+        if (separator == 0 || separator == std::string::npos)
+        {
+            return false;
+        }
+
+        std::istringstream durationStream(frame.substr(separator + 1));
+        TileFrame tileFrame{frame.substr(0, separator), 0};
+        if (!(durationStream >> tileFrame.duration) || tileFrame.duration == 0 || durationStream.eof() == false)
+        {
+            return false;
+        }
+        def.frames.push_back(tileFrame);
+    }
+
+    return def.frames.empty() == false;
+}
+
+// Load TileDefs from a definition file, one TileType per line
+bool TileRegistry::load(const std::string& filename)
+{
+#if defined(SFML_SYSTEM_ANDROID)
+    std::istringstream inputFile(FileManager::readTxtFromAssets(filename));
+#else
+    std::ifstream inputFile(FileManager::resourcePath() + filename);
+#endif
+
+    if (inputFile)
+    {
+        std::string line;
+        while (std::getline(inputFile, line))
+        {
+            // Remove trailing whitespace (including '\r' from files saved with CRLF line endings)
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+
+            // Ignore empty lines or those starting with '#'
+            if (line.empty() || line.front() == '#')
+            {
+                continue;
+            }
+
+            std::uint16_t id = 0;
+            TileDef def;
+            if (parseDef(line, id, def) == false)
+            {
+                std::cerr << "TileRegistry error: Parsing TileDef \"" << line << "\" failed in file: \"" << filename << "\".\n";
+                return false;
+            }
+            m_defs[id] = def;
+        }
+
+        return true;
+    }
+
+    std::cerr << "TileRegistry error: Unable to open \"" << filename << "\".\n";
+    return false;
+}
+
+// Add a TileType's texture to the atlas on first use, returning false for TileTypes which are undefined or not rendered
+bool TileRegistry::resolve(std::uint16_t id, const ResourceManager& resourceManager)
+{
+    if (id >= m_defs.size() || m_defs[id].isDefined == false || m_defs[id].textureName.empty() == true)
+    {
+        return false;
+    }
+    if (m_atlas.contains(id) == true)
+    {
+        return true;
+    }
+
+    const sf::Texture& texture = resourceManager.getTexture(m_defs[id].textureName);
+    if (m_atlas.add(id, texture) == false)
+    {
+        return false;
+    }
+    sf::Image image = texture.copyToImage();
+    m_defs[id].textureRect = m_atlas.getTextureRect(id);
+    m_defs[id].isOpaque = isImageOpaque(image);
+    m_lodImages[id] = buildLodImages(image);
+    if (m_defs[id].isAnimated() == true)
+    {
+        addAnimation(id, resourceManager);
+    }
+    return true;
+}
+
+// Downsample a TileType's texture or frame by successive halves down to a single pixel (its averaged color), for drawing zoomed out
+// Maps
+std::vector<sf::Image> TileRegistry::buildLodImages(const sf::Image& image) const
+{
+    std::vector<sf::Image> lodImages;
+    do
+    {
+        lodImages.push_back(downsample(lodImages.empty() == true ? image : lodImages.back()));
+    } while (lodImages.back().getSize().x > 1 || lodImages.back().getSize().y > 1);
+    return lodImages;
+}
+
+// Keep the frames of a TileType added to the atlas, so that they can be copied into it as its animation plays
+// The TileType stays static (showing its texture) if its frames do not all have the dimensions of its texture
+void TileRegistry::addAnimation(std::uint16_t id, const ResourceManager& resourceManager)
+{
+    const TileDef& def = m_defs[id];
+    Animation animation{id, std::vector<sf::Image>(), {}, 0, def.frames.size()};
+    for (const auto& frame : def.frames)
+    {
+        animation.frameImages.push_back(resourceManager.getTexture(frame.textureName).copyToImage());
+        if (animation.frameImages.back().getSize() != sf::Vector2u(def.textureRect.width, def.textureRect.height))
+        {
+            std::cerr << "TileRegistry error: Frame \"" << frame.textureName << "\" of TileType " << id
+                      << " does not have the dimensions of its texture \"" << def.textureName << "\".\n";
+            return;
+        }
+        if (isImageOpaque(animation.frameImages.back()) == false)
+        {
+            m_defs[id].isOpaque = false;
+        }
+        animation.duration += frame.duration;
+    }
+
+    // Zoomed out Maps draw the downsampled current frame too
+    for (const auto& frameImage : animation.frameImages)
+    {
+        animation.frameLodImages.push_back(buildLodImages(frameImage));
+    }
+    m_animations.push_back(std::move(animation));
+}
+
+// Show the frame of each animated TileType at a tick of the animation clock, returning true if any frame changed
+// Every Tile of a TileType shares its region of the atlas, so all of them play in step
+bool TileRegistry::updateAnimations(unsigned int tick)
+{
+    bool isAnyFrameChanged = false;
+    for (auto& animation : m_animations)
+    {
+        const std::vector<TileFrame>& frames = m_defs[animation.id].frames;
+        unsigned int time = tick % animation.duration;
+        std::size_t frame = 0;
+        while (time >= frames[frame].duration)
+        {
+            time -= frames[frame].duration;
+            frame++;
+        }
+
+        if (frame != animation.currentFrame)
+        {
+            // Move the frame's downsampled images in place of the previous frame's, moved back to the Animation (those of the
+            // texture itself are dropped when the first frame is shown)
+            m_atlas.update(animation.id, animation.frameImages[frame]);
+            if (animation.currentFrame < animation.frameLodImages.size())
+            {
+                animation.frameLodImages[animation.currentFrame] = std::move(m_lodImages[animation.id]);
+            }
+            m_lodImages[animation.id] = std::move(animation.frameLodImages[frame]);
+            animation.currentFrame = frame;
+            isAnyFrameChanged = true;
+        }
+    }
+    return isAnyFrameChanged;
+}
+
+// Remove all textures from the atlas, so that they are added again (e.g. after being reloaded) when next resolved
+void TileRegistry::clearAtlas()
+{
+    m_atlas.clear();
+    m_animations.clear();
+    for (auto& lodImages : m_lodImages)
+    {
+        lodImages.clear();
+    }
+    for (auto& def : m_defs)
+    {
+        def.textureRect = sf::IntRect();
+        def.isOpaque = false;
+    }
+}
+
+// Return a TileType's texture downsampled by 2^level (clamped to a single pixel), or nullptr if the TileType is not in the atlas
+const sf::Image* TileRegistry::getLodImage(std::uint16_t id, unsigned int level) const
+{
+    if (level == 0 || id >= m_lodImages.size() || m_lodImages[id].empty() == true)
+    {
+        return nullptr;
+    }
+    return &m_lodImages[id][std::min<std::size_t>(level, m_lodImages[id].size()) - 1];
+}
+
+// Return the category of a TileType id, from the id ranges listed in tile_info.txt
+TileCategory TileRegistry::getCategory(std::uint16_t id)
+{
+    if (id < 10)
+    {
+        return TileCategory::Special;
+    }
+
+    switch (id / 100)
+    {
+    case 0:
+        return TileCategory::Background;
+    case 1:
+        return TileCategory::Static;
+    case 2:
+        return TileCategory::Animated;
+    case 3:
+        return TileCategory::Large;
+    case 4:
+        return TileCategory::Small;
+    case 5:
+        return TileCategory::Decoration;
+    case 9:
+        return TileCategory::Custom;
+    default:
+        return TileCategory::Undefined;
+    }
+}
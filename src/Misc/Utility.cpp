@@ -1,4 +1,9 @@
 #include "Misc/Utility.h"
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include <SFML/Graphics.hpp>
 
 namespace Utility
@@ -16,4 +21,47 @@ namespace Utility
         float scale = getScaleToFit(static_cast<sf::Vector2f>(sprite.getTexture()->getSize()), fitDimensions);
         sprite.setScale(scale, scale);
     }
+
+    /// Format a byte count as a human readable string using the largest fitting binary unit (B, KiB, MiB, or GiB)
+    std::string formatByteCount(std::size_t bytes)
+    {
+        static const char* const units[] = {"B", "KiB", "MiB", "GiB"};
+
+        double value = static_cast<double>(bytes);
+        std::size_t unitIndex = 0;
+        while (value >= 1024 && unitIndex < 3)
+        {
+            value /= 1024;
+            unitIndex++;
+        }
+
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(unitIndex == 0 ? 0 : 2) << value << ' ' << units[unitIndex];
+        return stream.str();
+    }
+
+    /// Run task(i) for each i in [0, taskCount) on as many threads as there are cores, the calling thread being one of them
+    void runParallel(std::size_t taskCount, const std::function<void(std::size_t)>& task)
+    {
+        std::atomic<std::size_t> nextTask(0);
+        auto work = [&nextTask, taskCount, &task]()
+        {
+            for (std::size_t i = nextTask++; i < taskCount; i = nextTask++)
+            {
+                task(i);
+            }
+        };
+
+        std::size_t threadCount = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), taskCount);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < threadCount; i++)
+        {
+            threads.emplace_back(work);
+        }
+        work();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
 } // namespace Utility
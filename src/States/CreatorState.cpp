@@ -13,7 +13,7 @@ CreatorState::CreatorState(GameEngine& game)
     , m_widthTextBox(m_game.inputManager, m_game.resourceManager.getFont("altFont"))
     , m_heightTextBox(m_game.inputManager, m_game.resourceManager.getFont("altFont"))
     , m_tileNameTextBox(m_game.inputManager, m_game.resourceManager.getFont("altFont"))
-    , m_createLevelButton(m_game.resourceManager.getFont("altFont"), m_game.resourceManager.getSoundBuffer("click"),
+    , m_createLevelButton(m_game.audioManager, m_game.resourceManager.getFont("altFont"), m_game.resourceManager.getSoundBuffer("click"),
                           sf::Vector2f(0.0f, 0.0f), sf::Vector2f(230, 30), -2, 6, "Create Level", GuiStyle::Green)
     , m_level(m_game.resourceManager, m_game.inputManager)
     , m_selectableTileTypes{TileType::Grass4Sides, TileType::Wood, TileType::Ladder, TileType::LadderTop, TileType::Vine}
@@ -24,6 +24,9 @@ CreatorState::CreatorState(GameEngine& game)
     // State settings
     m_stateSettings.backgroundColor = sf::Color(172, 172, 172);
 
+    // The editor loads Levels without the resource manifest, so resources prefetched for a played level would never be used
+    m_game.resourceManager.releasePrefetchedResources();
+
     // Initialize GUI
     m_panel.setFillColor(sf::Color(235, 235, 235, 235));
     m_panel.setOutlineColor(sf::Color(0, 0, 0, 235));
@@ -58,6 +61,17 @@ CreatorState::CreatorState(GameEngine& game)
 
     m_createLevelButton.setVolume(0.75);
 
+    // Report any glyph the font prewarm list missed
+    m_game.resourceManager.checkGlyphCache(m_loadLevelLabel);
+    m_game.resourceManager.checkGlyphCache(m_saveLevelLabel);
+    m_game.resourceManager.checkGlyphCache(m_tileNameLabel);
+    m_game.resourceManager.checkGlyphCache(m_createLevelButton.getTextDrawable());
+    m_game.resourceManager.checkGlyphCache(m_loadLevelTextBox.getPlaceholderTextDrawable());
+    m_game.resourceManager.checkGlyphCache(m_saveLevelTextBox.getPlaceholderTextDrawable());
+    m_game.resourceManager.checkGlyphCache(m_widthTextBox.getPlaceholderTextDrawable());
+    m_game.resourceManager.checkGlyphCache(m_heightTextBox.getPlaceholderTextDrawable());
+    m_game.resourceManager.checkGlyphCache(m_tileNameTextBox.getDisplayTextDrawable());
+
     // Music settings
     std::random_device rd;
     std::default_random_engine generator(rd());
@@ -158,6 +172,7 @@ void CreatorState::handleInput()
             }
         }
         m_tileNameTextBox.setText(Tile::getTileTypeString(m_selectableTileTypes[m_selectedTileTypeIndex]));
+        m_game.resourceManager.checkGlyphCache(m_tileNameTextBox.getDisplayTextDrawable());
     }
 
     // Brush size
@@ -172,6 +187,9 @@ void CreatorState::handleInput()
         m_brushSize--;
     }
 
+    // Batch the Tile texture updates of the preview and of the brush stroke
+    m_level.beginEdit();
+
     // Preview Map
     if (checkMouseChangedTile() || // Mouse changed Tile
         m_game.inputManager.isKeyDescending(sf::Keyboard::Add) || m_game.inputManager.isKeyDescending(sf::Keyboard::Subtract) || // Brush
@@ -209,12 +227,23 @@ void CreatorState::handleInput()
         }
     }
 
+    m_level.commitEdit();
+
     // Gui
     m_loadLevelTextBox.handleInput();
     m_saveLevelTextBox.handleInput();
     m_widthTextBox.handleInput();
     m_heightTextBox.handleInput();
 
+    // Typed text can contain any character, so report those the font prewarm list missed
+    if (m_game.inputManager.detectedTextEnteredEvent())
+    {
+        m_game.resourceManager.checkGlyphCache(m_loadLevelTextBox.getDisplayTextDrawable());
+        m_game.resourceManager.checkGlyphCache(m_saveLevelTextBox.getDisplayTextDrawable());
+        m_game.resourceManager.checkGlyphCache(m_widthTextBox.getDisplayTextDrawable());
+        m_game.resourceManager.checkGlyphCache(m_heightTextBox.getDisplayTextDrawable());
+    }
+
     if (m_game.inputManager.isKeyDescending(sf::Keyboard::Return))
     {
         // Loading
@@ -228,10 +257,10 @@ void CreatorState::handleInput()
                 m_heightTextBox.setText(std::to_string(m_level.getMapIndexDimensions().y));
             }
         }
-        // Saving
+        // Saving (in the background, so that editing can continue)
         else if (m_saveLevelTextBox.hasFocus() && !m_saveLevelTextBox.getText().isEmpty())
         {
-            m_level.save("data/levels/" + m_saveLevelTextBox.getText());
+            m_level.saveInBackground("data/levels/" + m_saveLevelTextBox.getText());
         }
         // Resizing
         else if (m_heightTextBox.hasFocus() || m_widthTextBox.hasFocus())
@@ -288,6 +317,16 @@ void CreatorState::update()
     m_widthTextBox.update();
     m_heightTextBox.update();
 
+    // Show the progress of a background save in place of the save label
+    if (m_level.isSaving() == true)
+    {
+        m_saveLevelLabel.setString("Saving Level... " + std::to_string(static_cast<int>(m_level.getSaveProgress() * 100)) + '%');
+    }
+    else
+    {
+        m_saveLevelLabel.setString(m_level.hasSaveFailed() == true ? "Saving Level failed" : "Save Level as: ");
+    }
+
     // Music rotation
     if (m_music.getStatus() == sf::SoundSource::Stopped)
     {
@@ -305,6 +344,7 @@ void CreatorState::draw(sf::RenderTarget& target, float lag)
     drawBackgroundColor(target);
 
     m_level.draw(target, sf::RenderStates::Default, lag);
+    m_game.recordMapDraw(m_level.getMapDrawnTileCount(), m_level.getMapOccludedTileCount());
 
     target.draw(m_panel);
 
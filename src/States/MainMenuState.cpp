@@ -24,12 +24,18 @@ MainMenuState::MainMenuState(GameEngine& game)
     // Initialize GUI
     const sf::Font& font = m_game.resourceManager.getFont("mainFont");
     const sf::SoundBuffer& soundBuffer = m_game.resourceManager.getSoundBuffer("click");
-    m_buttons.emplace_back(font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Play Level 1", GuiStyle::White);
-    m_buttons.emplace_back(font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Play Level 2", GuiStyle::White);
-    m_buttons.emplace_back(font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Play Level 3", GuiStyle::White);
-    m_buttons.emplace_back(font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Level Creator", GuiStyle::White);
-    m_buttons.emplace_back(font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Options", GuiStyle::White);
-    m_buttons.emplace_back(font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Quit", GuiStyle::White);
+    m_buttons.emplace_back(m_game.audioManager, font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Play Level 1",
+                           GuiStyle::White);
+    m_buttons.emplace_back(m_game.audioManager, font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Play Level 2",
+                           GuiStyle::White);
+    m_buttons.emplace_back(m_game.audioManager, font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Play Level 3",
+                           GuiStyle::White);
+    m_buttons.emplace_back(m_game.audioManager, font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Level Creator",
+                           GuiStyle::White);
+    m_buttons.emplace_back(m_game.audioManager, font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Options",
+                           GuiStyle::White);
+    m_buttons.emplace_back(m_game.audioManager, font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(300, 50), -2, 6, "Quit",
+                           GuiStyle::White);
     for (auto& button : m_buttons)
     {
         button.setVolume(0.75);
@@ -41,6 +47,14 @@ MainMenuState::MainMenuState(GameEngine& game)
                              m_gameNameText.getLocalBounds().top + m_gameNameText.getLocalBounds().height / 2);
     m_gameNameText.setFillColor(sf::Color(5, 25, 100));
 
+    // Report any glyph the font prewarm list missed
+    m_game.resourceManager.checkGlyphCache(m_gameNameText);
+    m_game.resourceManager.checkGlyphCache(m_creditsText);
+    for (const auto& button : m_buttons)
+    {
+        m_game.resourceManager.checkGlyphCache(button.getTextDrawable());
+    }
+
     // Music settings
     m_music.openFromFile(FileManager::resourcePath() + "res/music/stargazer.ogg");
     readMusicSettings();
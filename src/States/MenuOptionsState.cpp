@@ -39,6 +39,11 @@ MenuOptionsState::MenuOptionsState(GameEngine& game)
     {
         std::cout << "Failed to read sound settings.\n";
     }
+
+    // Report any glyph the font prewarm list missed (the slider's text only shows digits besides its label)
+    m_game.resourceManager.checkGlyphCache(m_titleText);
+    m_game.resourceManager.checkGlyphCache(m_soundSliderText);
+    m_game.resourceManager.checkGlyphCache(m_soundSlider.getTextDrawable());
 }
 
 MenuOptionsState::~MenuOptionsState()
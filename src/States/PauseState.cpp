@@ -8,8 +8,10 @@ PauseState::PauseState(GameEngine& game)
     // Initialize GUI
     const sf::Font& font = m_game.resourceManager.getFont("mainFont");
     const sf::SoundBuffer& soundBuffer = m_game.resourceManager.getSoundBuffer("click");
-    m_buttons.emplace_back(font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(400, 50), -2, 6, "Back to game", GuiStyle::White);
-    m_buttons.emplace_back(font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(400, 50), -2, 6, "Exit to main menu", GuiStyle::White);
+    m_buttons.emplace_back(m_game.audioManager, font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(400, 50), -2, 6, "Back to game",
+                           GuiStyle::White);
+    m_buttons.emplace_back(m_game.audioManager, font, soundBuffer, sf::Vector2f(0, 0), sf::Vector2f(400, 50), -2, 6, "Exit to main menu",
+                           GuiStyle::White);
     for (auto& button : m_buttons)
     {
         button.setVolume(0.75);
@@ -18,6 +20,13 @@ PauseState::PauseState(GameEngine& game)
     // Content settings
     m_pausedText.setOrigin(m_pausedText.getLocalBounds().left + m_pausedText.getLocalBounds().width / 2,
                            m_pausedText.getLocalBounds().top + m_pausedText.getLocalBounds().height / 2);
+
+    // Report any glyph the font prewarm list missed
+    m_game.resourceManager.checkGlyphCache(m_pausedText);
+    for (const auto& button : m_buttons)
+    {
+        m_game.resourceManager.checkGlyphCache(button.getTextDrawable());
+    }
 }
 
 PauseState::~PauseState()
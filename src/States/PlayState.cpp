@@ -1,19 +1,52 @@
 #include "States/PlayState.h"
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include "Core/FileManager.h"
 #include "States/PauseState.h"
 
+namespace
+{
+    // Return the directory of the level following the given one (e.g. "data/levels/level2" after "data/levels/level1"),
+    // or an empty string if there is none
+    std::string getNextLevelDirectory(const std::string& levelDirectory)
+    {
+        std::size_t numberPos = levelDirectory.find_last_not_of("0123456789") + 1;
+        std::size_t slashPos = levelDirectory.rfind('/');
+        if (numberPos == levelDirectory.size() || slashPos == std::string::npos)
+        {
+            return "";
+        }
+
+        // Directories whose number cannot be read (e.g. too large) have no next level
+        std::istringstream numberStream(levelDirectory.substr(numberPos));
+        unsigned int number = 0;
+        if (!(numberStream >> number) || number == std::numeric_limits<unsigned int>::max())
+        {
+            return "";
+        }
+
+        std::string nextLevelName = levelDirectory.substr(slashPos + 1, numberPos - (slashPos + 1)) + std::to_string(number + 1);
+        for (const auto& filename : FileManager::getFilenamesInDirectory(FileManager::resourcePath() + levelDirectory.substr(0, slashPos)))
+        {
+            if (filename == nextLevelName)
+            {
+                return levelDirectory.substr(0, slashPos + 1) + nextLevelName;
+            }
+        }
+        return "";
+    }
+} // namespace
+
 PlayState::PlayState(GameEngine& game, const std::string& levelDirectory)
     : State(game)
-    , m_darkness(getWindowDimensions())
     , m_muteButton(m_game.resourceManager.getTexture("muteNormal"), m_game.resourceManager.getTexture("muteHovered"),
                    m_game.resourceManager.getTexture("muteClicked"), sf::Vector2f(getWindowDimensions().x - 48, 48), sf::Vector2f(64, 64))
     , m_level(m_game.resourceManager, m_game.inputManager)
 {
     // Content settings
     m_stateSettings.backgroundColor = sf::Color(238, 241, 244);
-    m_darkness.setFillColor(sf::Color(0, 0, 0, 20));
 
     // Music
     m_music.openFromFile(FileManager::resourcePath() + "res/music/theme_song_8_bit.wav");
@@ -22,6 +55,14 @@ PlayState::PlayState(GameEngine& game, const std::string& levelDirectory)
     m_music.play();
 
     m_level.load(levelDirectory);
+
+    // Decode the next level's resources in the background while this one is played, so that its loading completes instantly
+    std::string nextLevelDirectory = getNextLevelDirectory(levelDirectory);
+    std::vector<std::string> names;
+    if (!nextLevelDirectory.empty() && m_game.resourceManager.loadManifest(nextLevelDirectory + "/resources.txt", &names))
+    {
+        m_game.resourceManager.prefetchResources(names);
+    }
 }
 
 PlayState::~PlayState()
@@ -90,6 +131,7 @@ void PlayState::handleInput()
 void PlayState::update()
 {
     m_level.update();
+    m_game.resourceManager.updatePrefetching();
 }
 
 void PlayState::draw(sf::RenderTarget& target, float lag)
@@ -97,8 +139,8 @@ void PlayState::draw(sf::RenderTarget& target, float lag)
     drawBackgroundColor(target);
 
     m_level.draw(target, sf::RenderStates::Default, lag);
+    m_game.recordMapDraw(m_level.getMapDrawnTileCount(), m_level.getMapOccludedTileCount());
 
-    target.draw(m_darkness);
     target.draw(m_muteButton);
 }
 
@@ -114,8 +156,6 @@ void PlayState::resume()
 
 void PlayState::onWindowResize()
 {
-    m_darkness.setPosition(0, 0);
-    m_darkness.setSize(getWindowDimensions());
     m_muteButton.setPosition(sf::Vector2f(getWindowDimensions().x - 48, 48));
 
     m_level.onWindowResize();
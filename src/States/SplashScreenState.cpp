@@ -6,7 +6,6 @@ SplashScreenState::SplashScreenState(GameEngine& game)
     : State(game)
     , m_splash(m_game.resourceManager.loadTexture("splash", "res/images/backgrounds/engine_splash.png"))
     , m_mask(m_game.resourceManager.loadTexture("mask", "res/images/backgrounds/mask.png"))
-    , m_sound(m_game.resourceManager.loadSoundBuffer("splashScreenSound", "res/sounds/splash_screen_sound.wav"))
     , m_alpha(255)
 {
     // Content settings
@@ -14,8 +13,8 @@ SplashScreenState::SplashScreenState(GameEngine& game)
     m_mask.setOrigin(static_cast<sf::Vector2f>(m_mask.getTexture()->getSize()) / 2.0f);
 
     // Music settings
-    m_sound.setVolume(10);
-    m_sound.play();
+    m_game.audioManager.play(m_game.resourceManager.loadSoundBuffer("splashScreenSound", "res/sounds/splash_screen_sound.wav"), 10, 1,
+                             SoundPriority::High);
 }
 
 SplashScreenState::~SplashScreenState()
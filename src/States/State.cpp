@@ -44,6 +44,13 @@ void State::baseHandleInput()
         m_game.toggleDebugOverlay();
     }
 
+    // Resource memory and audio voice reports
+    if (m_game.inputManager.isControlKeyHeld() && m_game.inputManager.isKeyDescending(sf::Keyboard::Num3))
+    {
+        m_game.resourceManager.printMemoryReport();
+        m_game.audioManager.printStats();
+    }
+
     // Change UPS
     if (m_game.inputManager.isControlKeyHeld() && m_game.inputManager.isKeyDescending(sf::Keyboard::Num2))
     {